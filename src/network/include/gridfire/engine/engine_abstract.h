@@ -4,9 +4,18 @@
 #include "gridfire/network.h"
 #include "gridfire/screening/screening_abstract.h"
 #include "gridfire/screening/screening_types.h"
+#include "gridfire/utils/graph.h"
+#include "gridfire/utils/hypergraph.h"
 
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <type_traits>
+
+#include "xxhash64.h"
 
 /**
  * @file engine_abstract.h
@@ -55,6 +64,21 @@ namespace gridfire {
         T nuclearEnergyGenerationRate = T(0.0); ///< Specific energy generation rate (e.g., erg/g/s).
     };
 
+    /**
+     * @brief Structure holding derivatives and energy generation for a batch of zones.
+     *
+     * The derivatives are stored species-major with the zone index varying fastest,
+     * i.e. the derivative of species `i` in zone `z` is `dydt[i * numZones + z]`. This
+     * layout keeps all zones of a given species contiguous so that kernels sweeping across
+     * zones vectorize.
+     *
+     * @see Engine::calculateRHSAndEnergyBatch
+     */
+    struct BatchStepDerivatives {
+        std::vector<double> dydt; ///< Derivatives of abundances, dydt[i * numZones + z].
+        std::vector<double> nuclearEnergyGenerationRate; ///< Specific energy generation rate for each zone (erg/g/s).
+    };
+
     /**
      * @brief Abstract base class for a reaction network engine.
      *
@@ -102,6 +126,47 @@ namespace gridfire {
             double T9,
             double rho
         ) const = 0;
+
+        /**
+         * @brief Calculate the right-hand side and energy generation for many zones at once.
+         *
+         * @param Y Abundances of all zones, stored species-major (Y[i * numZones + z]).
+         * @param T9 Temperature of each zone in units of 10^9 K. Its size defines numZones.
+         * @param rho Density of each zone in g/cm^3.
+         * @param activeZones Mask of zones that need to be evaluated (non-zero = active).
+         * @param derivatives Output derivatives; resized by this method. Entries for inactive zones are unspecified.
+         *
+         * The default implementation gathers each active zone into a contiguous vector and calls
+         * calculateRHSAndEnergy(). Engines which can evaluate the rates of many zones in a single
+         * sweep should override this to avoid the per-zone gather/scatter and to vectorize across zones.
+         */
+        virtual void calculateRHSAndEnergyBatch(
+            const std::vector<double>& Y,
+            const std::vector<double>& T9,
+            const std::vector<double>& rho,
+            const std::vector<uint8_t>& activeZones,
+            BatchStepDerivatives& derivatives
+        ) const {
+            const size_t numZones = T9.size();
+            const size_t numSpecies = getNetworkSpecies().size();
+            derivatives.dydt.assign(numSpecies * numZones, 0.0);
+            derivatives.nuclearEnergyGenerationRate.assign(numZones, 0.0);
+
+            std::vector<double> zoneY(numSpecies);
+            for (size_t z = 0; z < numZones; ++z) {
+                if (!activeZones[z]) {
+                    continue;
+                }
+                for (size_t i = 0; i < numSpecies; ++i) {
+                    zoneY[i] = Y[i * numZones + z];
+                }
+                const auto [dydt, eps] = calculateRHSAndEnergy(zoneY, T9[z], rho[z]);
+                for (size_t i = 0; i < numSpecies; ++i) {
+                    derivatives.dydt[i * numZones + z] = dydt[i];
+                }
+                derivatives.nuclearEnergyGenerationRate[z] = eps;
+            }
+        }
     };
 
     /**
@@ -120,6 +185,36 @@ namespace gridfire {
      */
     class DynamicEngine : public Engine {
     public:
+        /**
+         * @brief Calculate dY/dt for a subset of the network species only.
+         *
+         * @param Y Vector of current abundances for all species.
+         * @param speciesIndices Indices of the species whose derivatives are needed.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return Derivatives of the requested species, in the order of `speciesIndices`.
+         *
+         * Solvers which partition the network (e.g. the QSE and IMEX Newton solves) only need the
+         * derivatives of one block of species in their inner loops. Engines which know which reactions
+         * touch which species should override this to evaluate only those reactions. The default
+         * implementation evaluates the full right-hand side and gathers the requested entries.
+         *
+         * The energy generation rate is not returned since it depends on every reaction flow.
+         */
+        [[nodiscard]] virtual std::vector<double> calculateRHSSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const double T9,
+            const double rho
+        ) const {
+            const auto [dydt, nuclearEnergyGenerationRate] = calculateRHSAndEnergy(Y, T9, rho);
+            std::vector<double> subset(speciesIndices.size());
+            for (size_t i = 0; i < speciesIndices.size(); ++i) {
+                subset[i] = dydt[speciesIndices[i]];
+            }
+            return subset;
+        }
+
         /**
          * @brief Generate the Jacobian matrix for the current state.
          *
@@ -149,6 +244,143 @@ namespace gridfire {
             int j
         ) const = 0;
 
+        /**
+         * @brief Calculate the Jacobian block of a subset of the network species.
+         *
+         * @param Y Vector of current abundances for all species.
+         * @param speciesIndices Indices of the species spanning the block, for both rows and columns.
+         * @param pattern Structural pattern of the block, i.e.
+         *        `utils::restrictSparsityPattern(getJacobianSparsityPattern(), speciesIndices, speciesIndices)`.
+         *        Callers which solve with the same block repeatedly compute it once.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The values of ∂(dY/dt)_i/∂Y_j at the structural nonzeros of `pattern`, in its CSR order.
+         *
+         * Newton solves over one block of species (e.g. the QSE species) need neither the rows of the
+         * other species nor the entries outside the structural pattern. Engines which can differentiate
+         * only the requested rows should override this. The default implementation generates the full
+         * Jacobian (replacing the one held for getJacobianMatrixEntry()) and reads the pattern entries.
+         */
+        [[nodiscard]] virtual std::vector<double> calculateJacobianSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const utils::SparsityPattern& pattern,
+            const double T9,
+            const double rho
+        ) {
+            generateJacobianMatrix(Y, T9, rho);
+            std::vector<double> values(pattern.nonZeros());
+            for (size_t a = 0; a < pattern.numRows; ++a) {
+                for (size_t k = pattern.rowOffsets[a]; k < pattern.rowOffsets[a + 1]; ++k) {
+                    values[k] = getJacobianMatrixEntry(
+                        static_cast<int>(speciesIndices[a]),
+                        static_cast<int>(speciesIndices[pattern.columnIndices[k]])
+                    );
+                }
+            }
+            return values;
+        }
+
+        /**
+         * @brief Get the structural sparsity pattern of the Jacobian.
+         *
+         * @return CSR pattern (species x species) of the entries of ∂(dY/dt)_i/∂Y_j which can be
+         *         nonzero. The diagonal is always included.
+         *
+         * The pattern depends only on the network, not on the state, so sparse solvers can run
+         * their symbolic analysis once per network and reuse it for every numeric factorization.
+         * The default implementation knows nothing about the sparsity and returns the dense pattern.
+         */
+        [[nodiscard]] virtual utils::SparsityPattern getJacobianSparsityPattern() const {
+            const size_t numSpecies = getNetworkSpecies().size();
+            utils::SparsityPattern pattern;
+            pattern.numRows = numSpecies;
+            pattern.numColumns = numSpecies;
+            pattern.rowOffsets.resize(numSpecies + 1);
+            pattern.columnIndices.resize(numSpecies * numSpecies);
+            for (size_t i = 0; i <= numSpecies; ++i) {
+                pattern.rowOffsets[i] = i * numSpecies;
+            }
+            for (size_t k = 0; k < pattern.columnIndices.size(); ++k) {
+                pattern.columnIndices[k] = k % numSpecies;
+            }
+            return pattern;
+        }
+
+        /**
+         * @brief Get the sparsity pattern of the stoichiometry matrix.
+         *
+         * @return CSR pattern (species x reactions) of the nonzero net stoichiometric coefficients.
+         *
+         * The default implementation probes every entry with getStoichiometryMatrixEntry(), so the
+         * stoichiometry matrix must have been generated.
+         */
+        [[nodiscard]] virtual utils::SparsityPattern getStoichiometrySparsityPattern() const {
+            const size_t numSpecies = getNetworkSpecies().size();
+            const size_t numReactions = getNetworkReactions().size();
+            std::vector<std::pair<size_t, size_t>> entries;
+            for (size_t i = 0; i < numSpecies; ++i) {
+                for (size_t j = 0; j < numReactions; ++j) {
+                    if (getStoichiometryMatrixEntry(static_cast<int>(i), static_cast<int>(j)) != 0) {
+                        entries.emplace_back(i, j);
+                    }
+                }
+            }
+            return utils::buildSparsityPattern(numSpecies, numReactions, std::move(entries));
+        }
+
+        /**
+         * @brief Get the reaction hypergraph of the network.
+         *
+         * @return Index-based incidence of the network species and reactions, in the indices of
+         *         getNetworkSpecies() and getNetworkReactions().
+         *
+         * Graph algorithms over the network (reachability, culling, conservation checks, export)
+         * should walk this rather than searching the Species lists of each reaction.
+         *
+         * The default implementation builds the hypergraph from getNetworkSpecies() and
+         * getNetworkReactions() on first use and caches it, rebuilding it whenever the species
+         * names or the reaction set hash have changed. Engines which keep their own hypergraph
+         * up to date (GraphEngine and the views) override this.
+         */
+        [[nodiscard]] virtual const utils::NetworkHypergraph& getNetworkHypergraph() const {
+            const auto& species = getNetworkSpecies();
+            const auto& reactions = getNetworkReactions();
+            uint64_t key = reactions.hash(0);
+            for (const auto& sp : species) {
+                const std::string_view name = sp.name();
+                key = XXHash64::hash(name.data(), name.size(), key);
+            }
+            if (!m_defaultHypergraph.has_value() || m_defaultHypergraphKey != key) {
+                m_defaultHypergraph.emplace(species, reactions);
+                m_defaultHypergraphKey = key;
+            }
+            return *m_defaultHypergraph;
+        }
+
+        /**
+         * @brief Get a block lower triangular ordering of the Jacobian sparsity pattern.
+         *
+         * @return Ordering of the species indices whose diagonal blocks are the strongly coupled
+         *         groups of species. The Jacobian permuted by it has no structural entries above
+         *         the diagonal blocks.
+         *
+         * Implicit solvers use this to replace one factorization of the whole iteration matrix by
+         * a sequence of small block factorizations and forward substitution (see
+         * solver::BlockTriangularLU). The default implementation knows nothing about the sparsity
+         * and returns a single block holding every species.
+         */
+        [[nodiscard]] virtual utils::BlockOrdering getJacobianBlockOrdering() const {
+            const size_t numSpecies = getNetworkSpecies().size();
+            utils::BlockOrdering ordering;
+            ordering.ordering.resize(numSpecies);
+            for (size_t i = 0; i < numSpecies; ++i) {
+                ordering.ordering[i] = i;
+            }
+            ordering.blockOffsets = {0, numSpecies};
+            return ordering;
+        }
+
         /**
          * @brief Generate the stoichiometry matrix for the network.
          *
@@ -190,6 +422,33 @@ namespace gridfire {
             double rho
         ) const = 0;
 
+        /**
+         * @brief Calculate the molar reaction flows of all reactions in one pass.
+         *
+         * @param Y Vector of current abundances.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The flow of each reaction, in the order of getNetworkReactions(), with the same
+         *         meaning as calculateMolarReactionFlow().
+         *
+         * Used where every flow is needed at once, e.g. when an adaptive view re-culls the network.
+         * The default implementation calls calculateMolarReactionFlow() for each reaction; engines
+         * with precomputed reaction data should override it.
+         */
+        [[nodiscard]] virtual std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y,
+            const double T9,
+            const double rho
+        ) const {
+            const auto& reactions = getNetworkReactions();
+            std::vector<double> flows;
+            flows.reserve(reactions.size());
+            for (const auto& reaction : reactions) {
+                flows.push_back(calculateMolarReactionFlow(reaction, Y, T9, rho));
+            }
+            return flows;
+        }
+
         /**
          * @brief Get the set of logical reactions in the network.
          *
@@ -265,5 +524,53 @@ namespace gridfire {
          * @endcode
          */
         [[nodiscard]] virtual screening::ScreeningType getScreeningModel() const = 0;
+
+        /**
+         * @brief Get the rate multiplier of every reaction.
+         *
+         * @return One multiplier per reaction, in the order of getNetworkReactions().
+         *
+         * The multipliers live in the engine which evaluates the rates (GraphEngine) and belong to
+         * reactions, not to indices: they follow their reaction by id whenever a reaction set is
+         * rebuilt, and reactions new to a set start at 1. Views report the multipliers of the
+         * reactions they expose, and engines without multipliers report 1 for every reaction. A
+         * view which builds an engine of its own copies the multipliers into it by reaction id,
+         * and copies them again before its next calculation whenever getRateMultiplierGeneration()
+         * of its base engine has changed.
+         */
+        [[nodiscard]] virtual std::vector<double> getRateMultipliers() const {
+            return std::vector<double>(getNetworkReactions().size(), 1.0);
+        }
+
+        /**
+         * @brief Get a counter which changes whenever the rate multipliers may have changed.
+         *
+         * @return The generation of the multipliers; views forward the generation of their base engine.
+         *
+         * Engines without multipliers never change theirs and report 0.
+         */
+        [[nodiscard]] virtual uint64_t getRateMultiplierGeneration() const {
+            return 0;
+        }
+    private:
+        mutable std::optional<utils::NetworkHypergraph> m_defaultHypergraph; ///< Hypergraph built by the default getNetworkHypergraph().
+        mutable uint64_t m_defaultHypergraphKey = 0; ///< Species and reaction set hash m_defaultHypergraph was built for.
     };
+
+    /**
+     * @brief Concept for the engine types a solver can be instantiated on.
+     *
+     * Either DynamicEngine itself, for which every engine call goes through the virtual
+     * interface, or a `final` class derived from it. Because nothing can override the methods of a
+     * final class, a solver holding the concrete engine type binds its engine calls statically and
+     * the compiler is free to inline them into the integration loop.
+     *
+     * Example usage:
+     * @code
+     * static_assert(SolverEngineType<GraphEngine>);
+     * @endcode
+     */
+    template<typename EngineT>
+    concept SolverEngineType = std::is_same_v<EngineT, DynamicEngine> ||
+        (std::is_base_of_v<DynamicEngine, EngineT> && std::is_final_v<EngineT>);
 }
\ No newline at end of file
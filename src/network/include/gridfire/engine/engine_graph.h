@@ -83,6 +83,20 @@ namespace gridfire {
      *   - Computation of timescales for each species.
      *   - Exporting the network to DOT and CSV formats for visualization and analysis.
      *
+     * Species are exposed in alphabetical order. Internally, the precomputed kernels work on a
+     * reverse Cuthill-McKee ordering of the species coupling graph, with the reactions grouped by
+     * the species they touch, so that the abundance gathers and derivative scatters of consecutive
+     * reactions stay close in memory. Abundances are permuted into this order on entry and the
+     * derivatives back on exit; the public species indices are unaffected. The reordering can be
+     * disabled with the configuration key `gridfire:GraphEngine:ReorderSpecies` (default true) or
+     * with setSpeciesReordering().
+     *
+     * Every reaction carries a rate multiplier (default 1) which scales its rate in all
+     * calculations, for sensitivity studies and calibration. The multipliers are dynamic
+     * parameters of the AD tape, so setRateMultipliers() costs O(reactions) and neither
+     * re-records the tape nor redoes the precomputation. When the reaction set is rebuilt the
+     * multipliers follow their reactions by id.
+     *
      * @implements DynamicEngine
      *
      * @see engine_abstract.h
@@ -130,6 +144,56 @@ namespace gridfire {
             const double rho
         ) const override;
 
+        /**
+         * @brief Calculates the right-hand side and energy generation rate for a batch of zones.
+         *
+         * @param Y Abundances of all zones, stored species-major (Y[i * numZones + z]).
+         * @param T9 Temperature of each zone in units of 10^9 K.
+         * @param rho Density of each zone in g/cm^3.
+         * @param activeZones Mask of zones that need to be evaluated.
+         * @param derivatives Output derivatives in the same layout as Y.
+         *
+         * When precomputation is enabled, the reaction loop is the outer loop and the
+         * zone loop is the inner, contiguous loop, so that flow evaluation and the
+         * scatter into dY/dt vectorize across zones. Inactive zones are still swept
+         * (masking individual lanes would break vectorization) but their results are
+         * not meaningful. Without precomputation this falls back to the per-zone
+         * default implementation.
+         *
+         * @see Engine::calculateRHSAndEnergyBatch
+         */
+        void calculateRHSAndEnergyBatch(
+            const std::vector<double>& Y,
+            const std::vector<double>& T9,
+            const std::vector<double>& rho,
+            const std::vector<uint8_t>& activeZones,
+            BatchStepDerivatives& derivatives
+        ) const override;
+
+        /**
+         * @brief Calculates dY/dt for a subset of the network species only.
+         *
+         * @param Y Vector of current abundances for all species.
+         * @param speciesIndices Indices of the species whose derivatives are needed.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return Derivatives of the requested species, in the order of `speciesIndices`.
+         *
+         * With precomputation enabled, the species-to-reaction adjacency built alongside the
+         * precomputed reactions is used to evaluate the bare rate and molar flow of only those
+         * reactions which change one of the requested species. Screening factors still depend on
+         * the full composition and are computed for the whole network. Without precomputation this
+         * falls back to the full evaluation.
+         *
+         * @see DynamicEngine::calculateRHSSubset
+         */
+        [[nodiscard]] std::vector<double> calculateRHSSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const double T9,
+            const double rho
+        ) const override;
+
         /**
          * @brief Generates the Jacobian matrix for the current state.
          *
@@ -149,6 +213,70 @@ namespace gridfire {
             const double rho
         ) override;
 
+        /**
+         * @brief Calculates the Jacobian block of a subset of the species from the AD tape.
+         *
+         * Only the rows of the requested species are differentiated, with CppAD's sparse reverse mode:
+         * rows whose tape sparsity patterns share no column are computed in the same reverse sweep. The
+         * tape sparsity and the row coloring are computed on first use and kept until the tape is
+         * re-recorded or a different subset is requested. The Jacobian held for getJacobianMatrixEntry()
+         * is left unchanged.
+         *
+         * @see DynamicEngine::calculateJacobianSubset
+         */
+        [[nodiscard]] std::vector<double> calculateJacobianSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const utils::SparsityPattern& pattern,
+            const double T9,
+            const double rho
+        ) override;
+
+        /**
+         * @brief Gets the structural sparsity pattern of the Jacobian.
+         *
+         * @return The pattern computed when the network was precomputed: entry (i, j) is present if
+         *         species j is a reactant of a reaction which changes species i, plus the diagonal.
+         *
+         * As for getJacobianBlockOrdering(), the weak couplings of the screening factors to the whole
+         * composition are not part of the pattern.
+         *
+         * @see DynamicEngine::getJacobianSparsityPattern
+         */
+        [[nodiscard]] utils::SparsityPattern getJacobianSparsityPattern() const override;
+
+        /**
+         * @brief Gets the sparsity pattern of the stoichiometry matrix.
+         *
+         * @return The pattern computed from the precomputed reactions, without probing the matrix.
+         *
+         * @see DynamicEngine::getStoichiometrySparsityPattern
+         */
+        [[nodiscard]] utils::SparsityPattern getStoichiometrySparsityPattern() const override;
+
+        /**
+         * @brief Gets the reaction hypergraph of the network.
+         *
+         * @return The hypergraph rebuilt whenever the reaction set changes.
+         *
+         * @see DynamicEngine::getNetworkHypergraph
+         */
+        [[nodiscard]] const utils::NetworkHypergraph& getNetworkHypergraph() const override;
+
+        /**
+         * @brief Gets the block lower triangular ordering of the Jacobian sparsity pattern.
+         *
+         * @return The ordering computed when the network was precomputed.
+         *
+         * The structural pattern has an entry (i, j) whenever species j is a reactant of a reaction
+         * which changes species i. Screening couples every rate weakly to the whole composition;
+         * these couplings are left out of the pattern, so for screened networks the blocks describe
+         * the dominant structure of the Jacobian rather than its exact sparsity.
+         *
+         * @see DynamicEngine::getJacobianBlockOrdering
+         */
+        [[nodiscard]] utils::BlockOrdering getJacobianBlockOrdering() const override;
+
         /**
          * @brief Generates the stoichiometry matrix for the network.
          *
@@ -167,7 +295,7 @@ namespace gridfire {
          * @return Molar flow rate for the reaction (e.g., mol/g/s).
          *
          * This method computes the net rate at which the given reaction proceeds
-         * under the current state.
+         * under the current state, scaled by the reaction's rate multiplier.
          */
         [[nodiscard]] double calculateMolarReactionFlow(
             const reaction::Reaction& reaction,
@@ -176,6 +304,26 @@ namespace gridfire {
             const double rho
         ) const override;
 
+        /**
+         * @brief Calculates the molar reaction flows of all reactions in one pass.
+         *
+         * @param Y Vector of current abundances.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The flow of each reaction, in the order of getNetworkReactions().
+         *
+         * With precomputation enabled the flows are evaluated from the precomputed reaction table,
+         * without the per-call reactant counting and species lookups of calculateMolarReactionFlow().
+         * Like calculateMolarReactionFlow(), the flows are unscreened.
+         *
+         * @see DynamicEngine::calculateAllMolarReactionFlows
+         */
+        [[nodiscard]] std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y,
+            const double T9,
+            const double rho
+        ) const override;
+
         /**
          * @brief Gets the list of species in the network.
          * @return Vector of Species objects representing all network species.
@@ -196,13 +344,15 @@ namespace gridfire {
          * @return Value of the Jacobian matrix at (i, j).
          *
          * The Jacobian must have been generated by `generateJacobianMatrix()` before calling this.
+         * Defined inline so that a solver instantiated on GraphEngine can inline it into its
+         * Jacobian assembly loop.
          *
          * @see generateJacobianMatrix()
          */
         [[nodiscard]] double getJacobianMatrixEntry(
             const int i,
             const int j
-        ) const override;
+        ) const override { return m_jacobianMatrix(i, j); }
 
         /**
          * @brief Gets the net stoichiometry for a given reaction.
@@ -307,7 +457,51 @@ namespace gridfire {
 
         [[nodiscard]] bool isPrecomputationEnabled() const;
 
+        /**
+         * @brief Enables or disables the reverse Cuthill-McKee species order of the precomputed kernels.
+         *
+         * @param reorder If false, the kernels work on the public (alphabetical) species order.
+         *
+         * The precomputation is redone immediately. The results do not depend on the order, up to
+         * floating point summation order; this exists mainly to check that. The initial value is read
+         * from `gridfire:GraphEngine:ReorderSpecies`.
+         */
+        void setSpeciesReordering(bool reorder);
+
+        [[nodiscard]] bool isSpeciesReorderingEnabled() const;
+
+        /**
+         * @brief Sets the rate multiplier of every reaction.
+         *
+         * @param multipliers One multiplier per reaction, in the order of getNetworkReactions().
+         *
+         * Each reaction rate, and so each molar reaction flow, is scaled by its multiplier in the
+         * precomputed kernels, the templated path, and the recorded AD tape alike. Only the
+         * dynamic parameters of the tape are replaced; nothing is re-recorded.
+         *
+         * When the reaction set is rebuilt each multiplier stays with its reaction, matched by
+         * id; reactions new to the set start at 1.
+         *
+         * @throws std::runtime_error If the number of multipliers differs from the number of reactions.
+         */
+        void setRateMultipliers(const std::vector<double>& multipliers);
+
+        /**
+         * @brief Gets the rate multiplier of every reaction, in the order of getNetworkReactions().
+         */
+        [[nodiscard]] std::vector<double> getRateMultipliers() const override;
+
+        /**
+         * @brief Gets a counter incremented by every change of the rate multipliers, including rebuilds of the reaction set.
+         */
+        [[nodiscard]] uint64_t getRateMultiplierGeneration() const override { return m_rateMultiplierGeneration; }
+
     private:
+        /**
+         * @brief Constant data of a reaction for the precomputed kernels.
+         *
+         * All species indices are local, i.e. positions in m_localSpeciesOrder.
+         */
         struct PrecomputedReaction {
             size_t reaction_index;
             std::vector<size_t> unique_reactant_indices;
@@ -339,14 +533,31 @@ namespace gridfire {
         boost::numeric::ublas::compressed_matrix<int> m_stoichiometryMatrix; ///< Stoichiometry matrix (species x reactions).
         boost::numeric::ublas::compressed_matrix<double> m_jacobianMatrix; ///< Jacobian matrix (species x species).
 
-        CppAD::ADFun<double> m_rhsADFun; ///< CppAD function for the right-hand side of the ODE.
+        CppAD::ADFun<double> m_rhsADFun; ///< CppAD function for the right-hand side of the ODE, with the rate multipliers as dynamic parameters.
+        CppAD::sparse_rc<std::vector<size_t>> m_rhsADSparsity; ///< Sparsity of the tape (species x AD inputs), computed on first use.
+        utils::SparsityPattern m_rhsTapePattern; ///< m_rhsADSparsity in CSR form for lookups; no rows until computed.
+        CppAD::sparse_jac_work m_jacobianSubsetWork; ///< Row coloring of the last Jacobian subset, reused while the subset is unchanged.
+        std::vector<size_t> m_jacobianSubsetSpecies; ///< Species indices m_jacobianSubsetWork was computed for.
+        std::vector<double> m_rateMultipliers; ///< Rate multiplier of each reaction, by reaction index.
+        uint64_t m_rateMultiplierGeneration = 0; ///< Incremented whenever m_rateMultipliers changes.
+        std::unordered_map<std::string_view, size_t> m_reactionIndexMap; ///< Map from reaction ID to reaction index.
 
         screening::ScreeningType m_screeningType = screening::ScreeningType::BARE; ///< Screening type for the reaction network. Default to no screening.
         std::unique_ptr<screening::ScreeningModel> m_screeningModel = screening::selectScreeningModel(m_screeningType);
 
         bool m_usePrecomputation = true; ///< Flag to enable or disable using precomputed reactions for efficiency. Mathematically, this should not change the results. Generally end users should not need to change this.
 
-        std::vector<PrecomputedReaction> m_precomputedReactions; ///< Precomputed reactions for efficiency.
+        bool m_reorderSpecies = m_config.get<bool>("gridfire:GraphEngine:ReorderSpecies", true); ///< Whether the precomputed kernels use the reverse Cuthill-McKee species order.
+        std::vector<size_t> m_localSpeciesOrder; ///< Public species index at each local species index used by the precomputed kernels.
+        std::vector<size_t> m_publicToLocalSpecies; ///< Local species index of each public species index.
+        std::vector<PrecomputedReaction> m_precomputedReactions; ///< Precomputed reactions for efficiency, grouped by the species they touch.
+        std::vector<size_t> m_speciesReactionOffsets; ///< CSR row offsets of the species-to-reaction adjacency, by local species index (size numSpecies + 1).
+        std::vector<size_t> m_speciesReactionIndices; ///< CSR column indices: precomputed reactions which change each species.
+        std::vector<int> m_speciesReactionCoefficients; ///< Stoichiometric coefficient of the species in each adjacent reaction.
+        utils::SparsityPattern m_jacobianSparsityPattern; ///< Structural Jacobian pattern, in public species indices.
+        utils::SparsityPattern m_stoichiometrySparsityPattern; ///< Stoichiometry matrix pattern (species x reactions).
+        utils::BlockOrdering m_jacobianBlockOrdering; ///< Block lower triangular ordering of the structural Jacobian.
+        utils::NetworkHypergraph m_hypergraph; ///< Index-based incidence of m_networkSpecies and m_reactions.
 
     private:
         /**
@@ -355,8 +566,11 @@ namespace gridfire {
          * This method synchronizes the internal maps used by the engine,
          * including the species map, reaction ID map, and species-to-index map.
          * It also generates the stoichiometry matrix and records the AD tape.
+         *
+         * @param rateMultipliersById Rate multipliers to carry over, by reaction id. Reactions not
+         *        listed get a multiplier of 1.
          */
-        void syncInternalMaps();
+        void syncInternalMaps(const std::unordered_map<std::string, double>& rateMultipliersById = {});
 
         /**
          * @brief Collects the unique species in the network.
@@ -402,8 +616,22 @@ namespace gridfire {
          */
         void recordADTape();
 
+        /**
+         * @brief Precomputes the constant data of every reaction for the fast kernels.
+         *
+         * Builds the local species ordering, the precomputed reactions (in local indices, sorted so
+         * that reactions touching the same species are adjacent), the species-to-reaction adjacency,
+         * and the block ordering of the structural Jacobian.
+         */
         void precomputeNetwork();
 
+        /**
+         * @brief Permutes public-order abundances into the local order of the precomputed kernels.
+         * @param Y Abundances in public species order.
+         * @return Abundances in local species order.
+         */
+        [[nodiscard]] std::vector<double> toLocalSpeciesOrder(const std::vector<double>& Y) const;
+
         /**
          * @brief Validates mass and charge conservation across all reactions.
          *
@@ -432,6 +660,24 @@ namespace gridfire {
             double T9
         );
 
+        /**
+         * @brief Calculates the molar flow of a single precomputed reaction.
+         *
+         * @param precomp The precomputed reaction.
+         * @param Y_in Vector of current abundances, in local species order.
+         * @param bare_rate Unscreened rate of the reaction.
+         * @param screeningFactor Screening factor of the reaction.
+         * @param rho Density in g/cm^3.
+         * @return Molar flow of the reaction, zero if any reactant is below MIN_ABUNDANCE_THRESHOLD.
+         */
+        [[nodiscard]] double calculatePrecomputedMolarReactionFlow(
+            const PrecomputedReaction& precomp,
+            const std::vector<double>& Y_in,
+            double bare_rate,
+            double screeningFactor,
+            double rho
+        ) const;
+
         [[nodiscard]] StepDerivatives<double> calculateAllDerivativesUsingPrecomputation(
             const std::vector<double> &Y_in,
             const std::vector<double>& bare_rates,
@@ -467,6 +713,8 @@ namespace gridfire {
          * @param Y_in Vector of current abundances for all species.
          * @param T9 Temperature in units of 10^9 K.
          * @param rho Density in g/cm^3.
+         * @param rateMultipliers Multiplier of each reaction rate, by reaction index. When
+         *                        recording the AD tape these are its dynamic parameters.
          * @return StepDerivatives<T> containing dY/dt and energy generation rate.
          *
          * This method calculates the time derivatives of all species and the
@@ -476,7 +724,8 @@ namespace gridfire {
         [[nodiscard]] StepDerivatives<T> calculateAllDerivatives(
             const std::vector<T> &Y_in,
             T T9,
-            T rho
+            T rho,
+            const std::vector<T> &rateMultipliers
         ) const;
 
         /**
@@ -489,7 +738,7 @@ namespace gridfire {
          *
          * This method calculates the time derivatives of all species and the
          * specific nuclear energy generation rate for the current state using
-         * double precision arithmetic.
+         * double precision arithmetic. The current rate multipliers are applied as constants.
          */
         [[nodiscard]] StepDerivatives<double> calculateAllDerivatives(
             const std::vector<double>& Y_in,
@@ -507,7 +756,7 @@ namespace gridfire {
          *
          * This method calculates the time derivatives of all species and the
          * specific nuclear energy generation rate for the current state using
-         * automatic differentiation.
+         * automatic differentiation. The current rate multipliers are applied as constants.
          */
         [[nodiscard]] StepDerivatives<ADDouble> calculateAllDerivatives(
             const std::vector<ADDouble>& Y_in,
@@ -519,7 +768,7 @@ namespace gridfire {
 
     template<IsArithmeticOrAD T>
     StepDerivatives<T> GraphEngine::calculateAllDerivatives(
-        const std::vector<T> &Y_in, T T9, T rho) const {
+        const std::vector<T> &Y_in, T T9, T rho, const std::vector<T> &rateMultipliers) const {
         std::vector<T> screeningFactors = m_screeningModel->calculateScreeningFactors(
             m_reactions,
             m_networkSpecies,
@@ -565,7 +814,7 @@ namespace gridfire {
             const auto& reaction = m_reactions[reactionIndex];
 
             // 1. Calculate reaction rate
-            const T molarReactionFlow = screeningFactors[reactionIndex] * calculateMolarReactionFlow<T>(reaction, Y, T9, rho);
+            const T molarReactionFlow = rateMultipliers[reactionIndex] * screeningFactors[reactionIndex] * calculateMolarReactionFlow<T>(reaction, Y, T9, rho);
 
             // 2. Use the rate to update all relevant species derivatives (dY/dt)
             for (size_t speciesIndex = 0; speciesIndex < m_networkSpecies.size(); ++speciesIndex) {
@@ -1,5 +1,6 @@
 #pragma once
 #include "gridfire/engine/engine_abstract.h"
+#include "gridfire/engine/engine_graph.h"
 #include "gridfire/engine/views/engine_view_abstract.h"
 #include "gridfire/screening/screening_abstract.h"
 #include "gridfire/screening/screening_types.h"
@@ -11,6 +12,10 @@
 
 #include "quill/Logger.h"
 
+#include <limits>
+#include <memory>
+#include <vector>
+
 namespace gridfire {
     /**
      * @class AdaptiveEngineView
@@ -36,15 +41,24 @@ namespace gridfire {
      *   4. **Species Culling:** Culls species that are not reachable from the initial fuel.
      *   5. **Index Map Construction:** Constructs index maps to map between the full network indices
      *      and the active subset indices for species and reactions.
+     *   6. **Compact Engine (optional):** If `gridfire:AdaptiveEngineView:MaterializeCompactEngine`
+     *      is set (or setCompactEngineMaterialization() is called), builds a GraphEngine over the
+     *      active reactions only, with its own precomputed tables and AD tape and with the rate
+     *      multipliers of the base engine, and delegates all calculations to it.
+     *
+     * Without the compact engine every calculation goes through the full base engine, so every
+     * reaction (including the culled ones, with the culled species at zero abundance) is evaluated
+     * and the full Jacobian is built. With it, culled reactions are dropped entirely and the cost
+     * scales with the active network. The compact engine always uses the base engine's screening model.
      *
      * @implements DynamicEngine
-     * @implements EngineView<DynamicEngine>
+     * @implements IndexMappedEngineView
      *
      * @see engine_abstract.h
      * @see engine_view_abstract.h
      * @see AdaptiveEngineView::update()
      */
-    class AdaptiveEngineView final : public DynamicEngine, public EngineView<DynamicEngine> {
+    class AdaptiveEngineView final : public DynamicEngine, public IndexMappedEngineView {
     public:
         /**
          * @brief Constructs an AdaptiveEngineView.
@@ -64,8 +78,23 @@ namespace gridfire {
          * This method performs the reaction flow calculation, reaction culling, connectivity analysis,
          * and index map construction steps described above.
          *
+         * The new active set is diffed against the current one. If no reaction is added or dropped the
+         * index maps, hypergraph and compact engine are kept as they are, so keeping a stable network
+         * current costs only the flow evaluation. Otherwise the index maps are patched in place with the
+         * added and dropped reactions (see applyActiveSetDelta()), and the compact engine masks or
+         * unmasks reactions through its rate multipliers (see updateCompactEngine()). A CppAD tape
+         * cannot be extended, so a reaction which the compact engine does not yet hold still requires
+         * a new compact engine and tape.
+         *
          * The culling thresholds are read from the configuration using the following keys:
-         *   - `gridfire:AdaptiveEngineView:RelativeCullingThreshold` (default: 1e-75)
+         *   - `gridfire:AdaptiveEngineView:RelativeCullingThreshold` (default: 1e-75), the relative flow
+         *     above which a reaction is added
+         *   - `gridfire:AdaptiveEngineView:RelativeDropThreshold` (default: 1e-2 times the culling
+         *     threshold), the relative flow below which an active reaction is dropped
+         *   - `gridfire:AdaptiveEngineView:MaterializeCompactEngine` (default: false), whether to rebuild
+         *     the compact engine for the new active reaction set
+         *   - `gridfire:AdaptiveEngineView:MaxMaskedReactionFraction` (default: 0.5), the fraction of masked
+         *     reactions in the compact engine above which it is rebuilt
          *
          * @throws std::runtime_error If there is a mismatch between the active reactions and the base engine.
          * @post The active species and reactions are updated, and the index maps are reconstructed.
@@ -103,6 +132,43 @@ namespace gridfire {
             const double rho
         ) const override;
 
+        /**
+         * @brief Calculates dY/dt for a subset of the active species.
+         *
+         * @param Y_culled A vector of abundances for the active species.
+         * @param speciesIndices Culled indices of the species whose derivatives are needed.
+         * @param T9 The temperature in units of 10^9 K.
+         * @param rho The density in g/cm^3.
+         * @return Derivatives of the requested species, in the order of `speciesIndices`.
+         *
+         * The requested indices are mapped to the full network and the subset evaluation is
+         * forwarded to the base engine.
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         */
+        [[nodiscard]] std::vector<double> calculateRHSSubset(
+            const std::vector<double> &Y_culled,
+            const std::vector<size_t> &speciesIndices,
+            const double T9,
+            const double rho
+        ) const override;
+
+        /**
+         * @brief Calculates the Jacobian block of a subset of the active species.
+         *
+         * The species indices are mapped onto the compact engine (or the base engine) and the call is
+         * forwarded; the block pattern is the same in either index space.
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         */
+        [[nodiscard]] std::vector<double> calculateJacobianSubset(
+            const std::vector<double> &Y_culled,
+            const std::vector<size_t> &speciesIndices,
+            const utils::SparsityPattern &pattern,
+            const double T9,
+            const double rho
+        ) override;
+
         /**
          * @brief Generates the Jacobian matrix for the active species.
          *
@@ -141,6 +207,41 @@ namespace gridfire {
             const int j_culled
         ) const override;
 
+        /**
+         * @brief Gets the block lower triangular Jacobian ordering of the active species.
+         *
+         * @return The base engine's ordering restricted to the active species, in culled indices.
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         * @see utils::restrictBlockOrdering
+         */
+        [[nodiscard]] utils::BlockOrdering getJacobianBlockOrdering() const override;
+
+        /**
+         * @brief Gets the structural Jacobian sparsity pattern of the active species.
+         *
+         * @return The base engine's pattern restricted to the active species, in culled indices.
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         */
+        [[nodiscard]] utils::SparsityPattern getJacobianSparsityPattern() const override;
+
+        /**
+         * @brief Gets the stoichiometry sparsity pattern of the active species and reactions.
+         *
+         * @return The base engine's pattern restricted to the active species and reactions, in culled indices.
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         */
+        [[nodiscard]] utils::SparsityPattern getStoichiometrySparsityPattern() const override;
+
+        /**
+         * @brief Gets the reaction hypergraph of the active species and reactions.
+         *
+         * @return The hypergraph in culled indices, rebuilt by every update().
+         */
+        [[nodiscard]] const utils::NetworkHypergraph& getNetworkHypergraph() const override;
+
         /**
          * @brief Generates the stoichiometry matrix for the active reactions and species.
          *
@@ -193,6 +294,22 @@ namespace gridfire {
             double rho
         ) const override;
 
+        /**
+         * @brief Calculates the molar reaction flows of all active reactions in one pass.
+         *
+         * @param Y_culled Vector of current abundances for the active species.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The flow of each active reaction, in the order of getNetworkReactions().
+         *
+         * @throws std::runtime_error If the AdaptiveEngineView is stale (i.e., `update()` has not been called).
+         */
+        [[nodiscard]] std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y_culled,
+            double T9,
+            double rho
+        ) const override;
+
         /**
          * @brief Gets the set of active logical reactions in the network.
          *
@@ -225,6 +342,28 @@ namespace gridfire {
          */
         [[nodiscard]] const DynamicEngine& getBaseEngine() const override { return m_baseEngine; }
 
+        /**
+         * @brief Gets the engine the index maps point into.
+         *
+         * @return The compact engine if it is materialized, otherwise the base engine.
+         */
+        [[nodiscard]] DynamicEngine& getMappedEngine() const override;
+
+        /**
+         * @brief Gets the index of each active species in the mapped engine.
+         */
+        [[nodiscard]] const std::vector<size_t>& getSpeciesIndexMap() const override;
+
+        /**
+         * @brief Gets the index of each active reaction in the mapped engine.
+         */
+        [[nodiscard]] const std::vector<size_t>& getReactionIndexMap() const override;
+
+        /**
+         * @brief Gets the generation of the index maps, incremented whenever update() changes the active set.
+         */
+        [[nodiscard]] uint64_t getIndexMapGeneration() const override { return m_indexMapGeneration; }
+
         /**
          * @brief Sets the screening model for the base engine.
          *
@@ -256,6 +395,31 @@ namespace gridfire {
          * @endcode
          */
         [[nodiscard]] screening::ScreeningType getScreeningModel() const override;
+
+        /**
+         * @brief Gets the rate multipliers of the base engine for the active reactions.
+         *
+         * @return One multiplier per active reaction, in the order of getNetworkReactions().
+         *
+         * The compact engine, if materialized, carries the same multipliers; it takes them over again
+         * before its next use whenever the base engine's multipliers change.
+         */
+        [[nodiscard]] std::vector<double> getRateMultipliers() const override;
+
+        /**
+         * @brief Gets the rate multiplier generation of the base engine.
+         */
+        [[nodiscard]] uint64_t getRateMultiplierGeneration() const override;
+
+        /**
+         * @brief Enables or disables the compact engine.
+         *
+         * @param materialize Whether update() builds a GraphEngine over the active reactions only.
+         *
+         * The initial value is read from `gridfire:AdaptiveEngineView:MaterializeCompactEngine`. The
+         * view is marked stale, so the change takes effect on the next call to update().
+         */
+        void setCompactEngineMaterialization(bool materialize);
     private:
         using Config = fourdst::config::Config;
         using LogManager = fourdst::logging::LogManager;
@@ -277,8 +441,32 @@ namespace gridfire {
         /** @brief A map from the indices of the active reactions to the indices of the corresponding reactions in the full network. */
         std::vector<size_t> m_reactionIndexMap;
 
+        /** @brief Engine over (a superset of) the active reactions, used instead of the base engine if materialized. Inactive reactions have a zero rate multiplier. */
+        std::unique_ptr<GraphEngine> m_compactEngine;
+        /** @brief A map from the indices of the active species to the indices of the same species in the compact engine. */
+        std::vector<size_t> m_compactSpeciesIndexMap;
+        /** @brief A map from the indices of the active reactions to the indices of the same reactions in the compact engine. */
+        std::vector<size_t> m_compactReactionIndexMap;
+        /** @brief Compact engine index of each base engine species, or NOT_IN_COMPACT_ENGINE. */
+        std::vector<size_t> m_compactSpeciesOfBase;
+        /** @brief Compact engine index of each base engine reaction, or NOT_IN_COMPACT_ENGINE. */
+        std::vector<size_t> m_compactReactionOfBase;
+        /** @brief Number of active reactions in which each base engine species is a reactant or product. */
+        std::vector<size_t> m_speciesReactionCount;
+        /** @brief Index-based incidence of the active species and reactions. */
+        utils::NetworkHypergraph m_hypergraph;
+
+        /** @brief Whether update() materializes the compact engine. */
+        bool m_materializeCompactEngine = m_config.get<bool>("gridfire:AdaptiveEngineView:MaterializeCompactEngine", false);
         /** @brief A flag indicating whether the view is stale and needs to be updated. */
         bool m_isStale = true;
+        /** @brief Generation of the index maps, incremented whenever they are rebuilt. */
+        uint64_t m_indexMapGeneration = 0;
+        /** @brief Rate multiplier generation of the base engine when the compact engine last took over its multipliers. */
+        mutable uint64_t m_compactMultiplierGeneration = 0;
+
+        /** @brief Marks a base engine species or reaction which the compact engine does not hold. */
+        static constexpr size_t NOT_IN_COMPACT_ENGINE = std::numeric_limits<size_t>::max();
 
     private:
         /**
@@ -351,6 +539,53 @@ namespace gridfire {
          */
         [[nodiscard]] size_t mapCulledToFullReactionIndex(size_t culledReactionIndex) const;
 
+        /**
+         * @brief Builds the compact engine over the active reactions and its species index map.
+         *
+         * This records a new AD tape and redoes the precomputation of the compact engine.
+         *
+         * @throws std::runtime_error If an active species is missing from the compact engine.
+         */
+        void materializeCompactEngine();
+
+        /**
+         * @brief Brings the compact engine in line with a changed active set.
+         *
+         * Reactions dropped from the active set stay in the compact engine but are masked with a zero
+         * rate multiplier, and reactions which return are unmasked; both only swap the dynamic
+         * parameters of the tape. The compact engine is rebuilt, with a new tape, only if an active
+         * reaction is not in it, or if the fraction of masked reactions exceeds
+         * `gridfire:AdaptiveEngineView:MaxMaskedReactionFraction` (default: 0.5).
+         */
+        void updateCompactEngine();
+
+        /**
+         * @brief Rebuilds the compact index maps from the active set and applies the masked multipliers.
+         *
+         * @return False if an active species or reaction is not in the compact engine.
+         */
+        bool mapActiveSetToCompactEngine();
+
+        /**
+         * @brief Sets the compact engine's multipliers: the base engine's for active reactions, zero otherwise.
+         */
+        void applyCompactRateMultipliers() const;
+
+        /**
+         * @brief Gets the compact engine, first re-applying the multipliers if those of the base engine changed.
+         */
+        [[nodiscard]] GraphEngine& compactEngine() const;
+
+        /**
+         * @brief Maps a vector of culled abundances to the species order of the compact engine.
+         */
+        [[nodiscard]] std::vector<double> mapCulledToCompact(const std::vector<double>& culled) const;
+
+        /**
+         * @brief Maps a vector in the species order of the compact engine to the culled species order.
+         */
+        [[nodiscard]] std::vector<double> mapCompactToCulled(const std::vector<double>& compact) const;
+
         /**
          * @brief Validates that the AdaptiveEngineView is not stale.
          *
@@ -375,9 +610,8 @@ namespace gridfire {
          * 2. Iterates through all species in the base engine's network.
          * 3. For each species, it retrieves the molar abundance from `netIn.composition`. If the species is not found, its abundance is set to 0.0.
          * 4. Converts the temperature from Kelvin to T9.
-         * 5. Iterates through all reactions in the base engine's network.
-         * 6. For each reaction, it calls the base engine's `calculateMolarReactionFlow` to get the flow rate.
-         * 7. Stores the reaction pointer and its flow rate in a `ReactionFlow` struct and adds it to the returned vector.
+         * 5. Calls the base engine's `calculateAllMolarReactionFlows` to get the flow rates of all reactions in one pass.
+         * 6. Stores each reaction pointer and its flow rate in a `ReactionFlow` struct and adds it to the returned vector.
          */
         std::vector<ReactionFlow> calculateAllReactionFlows(
             const NetIn& netIn,
@@ -391,16 +625,15 @@ namespace gridfire {
          * mass fraction is above a certain threshold (`ABUNDANCE_FLOOR`).
          *
          * @param netIn The current network input, containing the initial composition.
-         * @return An unordered set of all reachable species.
+         * @return A flag per species of the base engine, true if the species is reachable.
          *
          * @par Algorithm:
-         * 1. Initializes a set `reachable` and a queue `to_visit` with the initial fuel species.
-         * 2. Iteratively processes the reaction network until no new species can be reached.
-         * 3. In each pass, it iterates through all reactions in the base engine's network.
-         * 4. If all reactants of a reaction are in the `reachable` set, all products of that reaction are added to the `reachable` set.
-         * 5. The process continues until a full pass over all reactions does not add any new species to the `reachable` set.
+         * 1. Collects the indices of the initial fuel species in the base engine.
+         * 2. Runs utils::NetworkHypergraph::reachableFrom() on the base engine's hypergraph: a single
+         *    worklist search in which each reaction fires once the countdown of its unreached
+         *    reactants reaches zero, making its products reachable.
          */
-        [[nodiscard]] std::unordered_set<fourdst::atomic::Species> findReachableSpecies(
+        [[nodiscard]] std::vector<bool> findReachableSpecies(
             const NetIn& netIn
         ) const;
         /**
@@ -410,42 +643,66 @@ namespace gridfire {
          * above an absolute culling threshold. The threshold is calculated by multiplying the
          * maximum flow rate by a relative culling threshold read from the configuration.
          *
-         * @param allFlows A vector of all reactions and their flow rates.
-         * @param reachableSpecies A set of all species reachable from the initial fuel.
+         * @param allFlows A vector of all reactions and their flow rates, in base engine reaction order.
+         * @param reachableSpecies Reachability flag of each base engine species, from findReachableSpecies().
          * @param Y_full A vector of molar abundances for all species in the full network.
          * @param maxFlow The maximum reaction flow rate in the network.
-         * @return A vector of pointers to the reactions that have been kept after culling.
+         * @return The base engine indices of the reactions kept after culling, in increasing order.
          *
          * @par Algorithm:
-         * 1. Retrieves the `RelativeCullingThreshold` from the configuration.
-         * 2. Calculates the `absoluteCullingThreshold` by multiplying `maxFlow` with the relative threshold.
+         * 1. Retrieves the `RelativeCullingThreshold` and `RelativeDropThreshold` from the configuration.
+         * 2. Scales both by `maxFlow` to absolute thresholds.
          * 3. Iterates through `allFlows`.
-         * 4. A reaction is kept if its `flowRate` is greater than the `absoluteCullingThreshold`.
-         * 5. The pointers to the kept reactions are stored in a vector and returned.
+         * 4. A reaction is kept if its `flowRate` is greater than the culling threshold, or if it is
+         *    currently active and its `flowRate` is greater than the lower drop threshold. The gap
+         *    between the two thresholds stops reactions near the threshold from flapping.
+         * 5. A reaction with zero flow is also kept if one of its reactants is absent but reachable.
          */
-        [[nodiscard]] std::vector<const reaction::LogicalReaction*> cullReactionsByFlow(
+        [[nodiscard]] std::vector<size_t> cullReactionsByFlow(
             const std::vector<ReactionFlow>& allFlows,
-            const std::unordered_set<fourdst::atomic::Species>& reachableSpecies,
+            const std::vector<bool>& reachableSpecies,
             const std::vector<double>& Y_full,
             double maxFlow
         ) const;
         /**
          * @brief Finalizes the set of active species and reactions.
          *
-         * This method takes the final list of culled reactions and populates the
-         * `m_activeReactions` and `m_activeSpecies` members. The active species are
-         * determined by collecting all reactants and products from the final reactions.
-         * The active species list is then sorted by mass.
+         * This method takes the base engine indices of the reactions kept by culling and populates
+         * `m_activeReactions`, `m_activeSpecies` and both index maps. The active species are the
+         * reactants and products of the kept reactions, found through the base engine's hypergraph.
          *
-         * @param finalReactions A vector of pointers to the reactions to be included in the active set.
+         * @param finalReactionIndices Base engine indices of the reactions to be included in the active set.
          *
          * @post
-         * - `m_activeReactions` is cleared and populated with the reactions from `finalReactions`.
-         * - `m_activeSpecies` is cleared and populated with all unique species present in `finalReactions`.
-         * - `m_activeSpecies` is sorted by atomic mass.
+         * - `m_activeReactions` holds the reactions of `finalReactionIndices`, in that order, and
+         *   `m_reactionIndexMap` equals `finalReactionIndices`.
+         * - `m_activeSpecies` holds all unique species present in those reactions, sorted by atomic
+         *   mass, and `m_speciesIndexMap` maps them to the base engine.
          */
         void finalizeActiveSet(
-            const std::vector<const reaction::LogicalReaction*>& finalReactions
+            const std::vector<size_t>& finalReactionIndices
         );
+
+        /**
+         * @brief Patches the active set with the reactions added and dropped by update().
+         *
+         * @param added Base engine indices of the reactions entering the active set.
+         * @param dropped Base engine indices of the reactions leaving the active set.
+         *
+         * Dropped reactions are erased from `m_activeReactions` and `m_reactionIndexMap` in place and
+         * added ones appended. Each species keeps a count of the active reactions it takes part in,
+         * so only the species of the changed reactions are examined: those whose count falls to
+         * zero are erased and new ones are inserted at their place in the mass order. The cost is
+         * proportional to the size of the active set, not of the base network.
+         */
+        void applyActiveSetDelta(
+            const std::vector<size_t>& added,
+            const std::vector<size_t>& dropped
+        );
+
+        /**
+         * @brief Order of the active species: by atomic mass, ties broken by base engine index.
+         */
+        [[nodiscard]] bool activeSpeciesBefore(size_t a, size_t b) const;
     };
 }
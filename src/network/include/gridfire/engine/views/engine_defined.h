@@ -31,9 +31,9 @@ namespace gridfire{
      * network context, and the results are mapped back.
      *
      * @implements DynamicEngine
-     * @implements EngineView<DynamicEngine>
+     * @implements IndexMappedEngineView
      */
-    class FileDefinedEngineView final: public DynamicEngine, public EngineView<DynamicEngine> {
+    class FileDefinedEngineView final: public DynamicEngine, public IndexMappedEngineView {
     public:
         /**
          * @brief Constructs a FileDefinedEngineView.
@@ -65,6 +65,26 @@ namespace gridfire{
          */
         const DynamicEngine& getBaseEngine() const override;
 
+        /**
+         * @brief Gets the engine the index maps point into, which is the base engine.
+         */
+        [[nodiscard]] DynamicEngine& getMappedEngine() const override;
+
+        /**
+         * @brief Gets the index of each defined species in the base engine.
+         */
+        [[nodiscard]] const std::vector<size_t>& getSpeciesIndexMap() const override;
+
+        /**
+         * @brief Gets the index of each defined reaction in the base engine.
+         */
+        [[nodiscard]] const std::vector<size_t>& getReactionIndexMap() const override;
+
+        /**
+         * @brief Gets the generation of the index maps, incremented whenever the network file is read.
+         */
+        [[nodiscard]] uint64_t getIndexMapGeneration() const override { return m_indexMapGeneration; }
+
         // --- Engine Interface ---
         /**
          * @brief Gets the list of active species in the network defined by the file.
@@ -89,6 +109,37 @@ namespace gridfire{
             const double T9,
             const double rho
         ) const override;
+
+        /**
+         * @brief Calculates dY/dt for a subset of the active species.
+         *
+         * @param Y_defined A vector of abundances for the active species.
+         * @param speciesIndices View indices of the species whose derivatives are needed.
+         * @param T9 The temperature in units of 10^9 K.
+         * @param rho The density in g/cm^3.
+         * @return Derivatives of the requested species, in the order of `speciesIndices`.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] std::vector<double> calculateRHSSubset(
+            const std::vector<double>& Y_defined,
+            const std::vector<size_t>& speciesIndices,
+            const double T9,
+            const double rho
+        ) const override;
+
+        /**
+         * @brief Calculates the Jacobian block of a subset of the view's species on the base engine.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] std::vector<double> calculateJacobianSubset(
+            const std::vector<double>& Y_defined,
+            const std::vector<size_t>& speciesIndices,
+            const utils::SparsityPattern& pattern,
+            const double T9,
+            const double rho
+        ) override;
         /**
          * @brief Generates the Jacobian matrix for the active species.
          *
@@ -117,6 +168,40 @@ namespace gridfire{
             const int i_defined,
             const int j_defined
         ) const override;
+        /**
+         * @brief Gets the block lower triangular Jacobian ordering of the active species.
+         *
+         * @return The base engine's ordering restricted to the active species, in defined indices.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] utils::BlockOrdering getJacobianBlockOrdering() const override;
+
+        /**
+         * @brief Gets the structural Jacobian sparsity pattern of the active species.
+         *
+         * @return The base engine's pattern restricted to the active species, in defined indices.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] utils::SparsityPattern getJacobianSparsityPattern() const override;
+
+        /**
+         * @brief Gets the stoichiometry sparsity pattern of the active species and reactions.
+         *
+         * @return The base engine's pattern restricted to the active species and reactions, in defined indices.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] utils::SparsityPattern getStoichiometrySparsityPattern() const override;
+        /**
+         * @brief Gets the reaction hypergraph of the active species and reactions.
+         *
+         * @return The hypergraph in defined indices, rebuilt whenever the network file is read.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] const utils::NetworkHypergraph& getNetworkHypergraph() const override;
         /**
          * @brief Generates the stoichiometry matrix for the active reactions and species.
          *
@@ -154,6 +239,22 @@ namespace gridfire{
             const double T9,
             const double rho
         ) const override;
+
+        /**
+         * @brief Calculates the molar reaction flows of all active reactions in one pass.
+         *
+         * @param Y_defined Vector of current abundances for the active species.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The flow of each active reaction, in the order of getNetworkReactions().
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y_defined,
+            double T9,
+            double rho
+        ) const override;
         /**
          * @brief Gets the set of active logical reactions in the network.
          *
@@ -182,7 +283,9 @@ namespace gridfire{
          * @brief Updates the engine view if it is marked as stale.
          *
          * This method checks if the view is stale (e.g., after `setNetworkFile` was called).
-         * If it is, it rebuilds the active network from the currently set file.
+         * If it is, it rebuilds the active network from the currently set file. Parses are
+         * cached by the parser, and if the file's content hash matches the one the active
+         * network was built from, the view is kept as it is.
          * The `netIn` parameter is not used by this implementation but is required by the interface.
          *
          * @param netIn The current network input (unused).
@@ -219,6 +322,18 @@ namespace gridfire{
          * @return The current screening model type.
          */
         [[nodiscard]] screening::ScreeningType getScreeningModel() const override;
+
+        /**
+         * @brief Gets the rate multipliers of the base engine for the reactions in the view.
+         *
+         * @return One multiplier per reaction, in the order of getNetworkReactions().
+         */
+        [[nodiscard]] std::vector<double> getRateMultipliers() const override;
+
+        /**
+         * @brief Gets the rate multiplier generation of the base engine.
+         */
+        [[nodiscard]] uint64_t getRateMultiplierGeneration() const override;
     private:
         using Config = fourdst::config::Config;
         using LogManager = fourdst::logging::LogManager;
@@ -243,19 +358,30 @@ namespace gridfire{
         std::vector<size_t> m_speciesIndexMap;
         ///< Maps indices of active reactions to indices in the full network.
         std::vector<size_t> m_reactionIndexMap;
+        ///< Index-based incidence of the active species and reactions.
+        utils::NetworkHypergraph m_hypergraph;
 
         /** @brief A flag indicating whether the view is stale and needs to be updated. */
         bool m_isStale = true;
+        /** @brief Generation of the index maps, incremented whenever they are rebuilt. */
+        uint64_t m_indexMapGeneration = 0;
+        /** @brief Content hash of the file the active network was built from. */
+        uint64_t m_contentHash = 0;
 
     private:
         /**
          * @brief Builds the active species and reaction sets from a file.
          *
-         * This method uses the provided parser to read reaction names from the given file.
-         * It then finds these reactions in the base engine's full network and populates
+         * This method uses the provided parser to read the network definition from the given file.
+         * It then finds the defined reactions in the base engine's full network and populates
          * the `m_activeReactions` and `m_activeSpecies` members. Finally, it constructs
          * the index maps for the active sets.
          *
+         * Reactions are taken, in this order and without duplicates, from the PEN-style names,
+         * from the reaction specifications (matched by reactants and products), and, if requested,
+         * from every base reaction among the declared isotopes. Declared isotopes which take part
+         * in no selected reaction are not active species.
+         *
          * @param fileName The path to the network definition file.
          *
          * @post
@@ -267,6 +393,13 @@ namespace gridfire{
          */
         void buildFromFile(const std::string& fileName);
 
+        /**
+         * @brief Gets the base engine index of every reaction defined by parsed network data.
+         *
+         * @throws std::runtime_error If a named or specified reaction is not found in the base engine.
+         */
+        [[nodiscard]] std::vector<size_t> selectReactions(const io::ParsedNetworkData& parsed) const;
+
         /**
          * @brief Constructs the species index map.
          *
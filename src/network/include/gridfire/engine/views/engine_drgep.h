@@ -0,0 +1,349 @@
+#pragma once
+
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_view_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/config/config.h"
+#include "fourdst/logging/logging.h"
+
+#include "quill/Logger.h"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace gridfire {
+    /**
+     * @class DRGEPEngineView
+     * @brief An engine view which reduces the network to an error-controlled skeleton with DRGEP.
+     *
+     * The AdaptiveEngineView culls reactions whose flow falls below a single relative threshold,
+     * which bounds nothing about the error this introduces. This view instead applies
+     * directed relation graph reduction with error propagation (DRGEP): it asks how strongly each
+     * species influences a set of user-chosen target species (and, optionally, the nuclear energy
+     * generation rate), and keeps the smallest set of species and reactions which reproduces the
+     * targets to a stated accuracy.
+     *
+     * @par Algorithm
+     * With reaction flows \f$\omega_j\f$ and net stoichiometric coefficients \f$\nu_{A,j}\f$ at the
+     * conditions passed to update(), the direct interaction coefficient of species A on species B is
+     * \f[
+     *   r_{AB} = \frac{\left|\sum_j \nu_{A,j}\,\omega_j\,\delta_{B,j}\right|}{\max(P_A, C_A)},
+     * \f]
+     * where \f$\delta_{B,j} = 1\f$ if B takes part in reaction j and \f$P_A\f$, \f$C_A\f$ are the
+     * total production and consumption rates of A. The nuclear energy generation rate is treated as
+     * one more target whose "stoichiometric coefficients" are the reaction Q-values. The
+     * importance of B is the strongest path-product \f$R_{TB} = \max_{\text{paths}} \prod r\f$
+     * from any target T to B, found with a max-product Dijkstra search seeded at the targets.
+     *
+     * Keeping every species with importance of at least \f$\varepsilon\f$ (and every reaction whose
+     * species are all kept) gives a nested family of skeletal networks. For each candidate the
+     * error is the contribution of the removed reactions to each target's rate, relative to the
+     * target's gross turnover \f$\max(P_T, C_T)\f$ (and likewise for the energy generation rate).
+     * The view selects the largest \f$\varepsilon\f$ whose error stays within
+     * `gridfire:DRGEPEngineView:RelativeTolerance`, found by bisection over the distinct
+     * importance values.
+     *
+     * The skeleton is built as its own GraphEngine, so removed reactions cost nothing at runtime
+     * and the cost of every calculation scales with the skeletal network. The skeletal engine takes
+     * the base engine's rate multipliers of its reactions. The view's species and reactions are
+     * exactly those of the skeletal engine, in its order. Target species which take part in no kept
+     * reaction are not part of the skeleton. If nothing can be removed, no skeletal engine is built
+     * and the view delegates to the base engine directly.
+     *
+     * @par Configuration
+     *   - `gridfire:DRGEPEngineView:RelativeTolerance` (default: 0.01), the largest relative error
+     *     allowed in any target rate
+     *   - `gridfire:DRGEPEngineView:TargetEnergyGeneration` (default: true), whether the nuclear
+     *     energy generation rate is a target
+     *
+     * @par Usage Example:
+     * @code
+     * GraphEngine graph(composition);
+     * using fourdst::atomic::species;
+     * DRGEPEngineView skeletal(graph, {species.at("H-1"), species.at("He-4"), species.at("C-12")});
+     * skeletal.update(netIn);
+     * solver::DirectNetworkSolver solver(skeletal);
+     * @endcode
+     *
+     * @implements DynamicEngine
+     * @implements IndexMappedEngineView
+     */
+    class DRGEPEngineView final : public DynamicEngine, public IndexMappedEngineView {
+    public:
+        /**
+         * @brief Constructs a DRGEPEngineView.
+         *
+         * @param baseEngine The full network to reduce.
+         * @param targets Species whose rates the skeleton must reproduce.
+         *
+         * The view starts out mapped onto the full base engine, without building a copy of it, and is
+         * stale until update() is called.
+         *
+         * @throws std::runtime_error If a target species is not part of the base engine's network.
+         */
+        DRGEPEngineView(DynamicEngine& baseEngine, std::vector<fourdst::atomic::Species> targets);
+
+        // --- EngineView Interface ---
+        /**
+         * @brief Gets the full network this view reduces.
+         */
+        [[nodiscard]] const DynamicEngine& getBaseEngine() const override { return m_baseEngine; }
+
+        /**
+         * @brief Gets the skeletal engine all calculations are delegated to.
+         *
+         * @return The skeletal engine, or the base engine while the skeleton is the full network
+         *         (in particular before the first update()). The skeletal engine first takes over the
+         *         base engine's multipliers again if they changed since it last did.
+         */
+        [[nodiscard]] DynamicEngine& getMappedEngine() const override;
+
+        /**
+         * @brief Gets the species index map into the mapped engine, which is the identity.
+         */
+        [[nodiscard]] const std::vector<size_t>& getSpeciesIndexMap() const override { return m_identitySpeciesMap; }
+
+        /**
+         * @brief Gets the reaction index map into the mapped engine, which is the identity.
+         */
+        [[nodiscard]] const std::vector<size_t>& getReactionIndexMap() const override { return m_identityReactionMap; }
+
+        /**
+         * @brief Gets the generation of the skeleton, incremented whenever update() rebuilds it.
+         */
+        [[nodiscard]] uint64_t getIndexMapGeneration() const override { return m_indexMapGeneration; }
+
+        // --- Engine Interface ---
+        /**
+         * @brief Gets the species of the skeletal network.
+         */
+        [[nodiscard]] const std::vector<fourdst::atomic::Species>& getNetworkSpecies() const override;
+
+        /**
+         * @brief Calculates dY/dt and the energy generation rate of the skeletal network.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        [[nodiscard]] StepDerivatives<double> calculateRHSAndEnergy(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        // --- DynamicEngine Interface ---
+        [[nodiscard]] std::vector<double> calculateRHSSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            double T9,
+            double rho
+        ) const override;
+
+        [[nodiscard]] std::vector<double> calculateJacobianSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const utils::SparsityPattern& pattern,
+            double T9,
+            double rho
+        ) override;
+
+        void generateJacobianMatrix(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) override;
+
+        [[nodiscard]] double getJacobianMatrixEntry(
+            int i,
+            int j
+        ) const override;
+
+        [[nodiscard]] utils::SparsityPattern getJacobianSparsityPattern() const override;
+
+        [[nodiscard]] utils::SparsityPattern getStoichiometrySparsityPattern() const override;
+
+        [[nodiscard]] const utils::NetworkHypergraph& getNetworkHypergraph() const override;
+
+        [[nodiscard]] utils::BlockOrdering getJacobianBlockOrdering() const override;
+
+        void generateStoichiometryMatrix() override;
+
+        [[nodiscard]] int getStoichiometryMatrixEntry(
+            int speciesIndex,
+            int reactionIndex
+        ) const override;
+
+        [[nodiscard]] double calculateMolarReactionFlow(
+            const reaction::Reaction& reaction,
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        [[nodiscard]] std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        /**
+         * @brief Gets the reactions of the skeletal network.
+         */
+        [[nodiscard]] const reaction::LogicalReactionSet& getNetworkReactions() const override;
+
+        [[nodiscard]] std::unordered_map<fourdst::atomic::Species, double> getSpeciesTimescales(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        /**
+         * @brief Reduces the base network at the given conditions.
+         *
+         * @param netIn The conditions and composition to reduce at.
+         *
+         * Computes the DRGEP importance of every species of the base network and selects the
+         * smallest skeleton meeting the configured tolerance. If the selected reactions are the
+         * current ones the skeletal engine is kept as it is.
+         *
+         * @post The view is no longer stale.
+         */
+        void update(const NetIn& netIn) override;
+
+        /**
+         * @brief Sets the screening model of the base and skeletal engines.
+         */
+        void setScreeningModel(screening::ScreeningType model) override;
+
+        /**
+         * @brief Gets the screening model of the base engine.
+         */
+        [[nodiscard]] screening::ScreeningType getScreeningModel() const override;
+
+        /**
+         * @brief Gets the base engine's rate multipliers for the skeletal reactions.
+         *
+         * @return One multiplier per skeletal reaction, in the order of getNetworkReactions().
+         */
+        [[nodiscard]] std::vector<double> getRateMultipliers() const override;
+
+        /**
+         * @brief Gets the rate multiplier generation of the base engine.
+         */
+        [[nodiscard]] uint64_t getRateMultiplierGeneration() const override;
+
+        /**
+         * @brief DRGEP importance of each base engine species from the last update(), in base engine order.
+         */
+        [[nodiscard]] const std::vector<double>& getSpeciesImportance() const { return m_importance; }
+
+        /**
+         * @brief Estimated relative error in the target rates of the current skeleton.
+         */
+        [[nodiscard]] double getReductionError() const { return m_reductionError; }
+
+    private:
+        using Config = fourdst::config::Config;
+        using LogManager = fourdst::logging::LogManager;
+        /** @brief A reference to the singleton Config instance. */
+        Config& m_config = Config::getInstance();
+        /** @brief A pointer to the logger instance. */
+        quill::Logger* m_logger = LogManager::getInstance().getLogger("log");
+
+        /**
+         * @brief Net stoichiometric coefficient of one species in one reaction.
+         */
+        struct Participant {
+            size_t species; ///< Base engine species index.
+            int coefficient; ///< Products minus reactants; zero for a species on both sides in equal number.
+        };
+
+        /** @brief The full network this view reduces. */
+        DynamicEngine& m_baseEngine;
+        /** @brief Base engine indices of the target species. */
+        std::vector<size_t> m_targetIndices;
+
+        /** @brief Engine over the skeletal reactions, which all calculations are delegated to; null while the skeleton is the full network. */
+        std::unique_ptr<GraphEngine> m_skeletalEngine;
+        /** @brief Base engine index of each skeletal species. */
+        std::vector<size_t> m_speciesIndexMap;
+        /** @brief Base engine index of each skeletal reaction. */
+        std::vector<size_t> m_reactionIndexMap;
+        /** @brief Identity map over the skeletal species. */
+        std::vector<size_t> m_identitySpeciesMap;
+        /** @brief Identity map over the skeletal reactions. */
+        std::vector<size_t> m_identityReactionMap;
+
+        /** @brief DRGEP importance of each base engine species from the last update. */
+        std::vector<double> m_importance;
+        /** @brief Estimated relative error of the current skeleton. */
+        double m_reductionError = 0.0;
+
+        /** @brief Generation of the skeleton, incremented whenever it is rebuilt. */
+        uint64_t m_indexMapGeneration = 0;
+        /** @brief Rate multiplier generation of the base engine when the skeletal engine last took over its multipliers. */
+        mutable uint64_t m_skeletalMultiplierGeneration = 0;
+        /** @brief A flag indicating whether the view is stale and needs to be updated. */
+        bool m_isStale = true;
+
+    private:
+        /**
+         * @brief Collects the participants of every base engine reaction, in CSR form.
+         */
+        void collectParticipants(
+            std::vector<size_t>& offsets,
+            std::vector<Participant>& participants
+        ) const;
+
+        /**
+         * @brief Computes the DRGEP importance of every base engine species.
+         *
+         * @param offsets CSR offsets of the reaction participants.
+         * @param participants Reaction participants.
+         * @param flows Molar flow of each base engine reaction.
+         * @param energyTarget Whether the energy generation rate is a target.
+         * @return The importance of each base engine species, in [0, 1]; targets have importance 1.
+         */
+        [[nodiscard]] std::vector<double> computeImportance(
+            const std::vector<size_t>& offsets,
+            const std::vector<Participant>& participants,
+            const std::vector<double>& flows,
+            bool energyTarget
+        ) const;
+
+        /**
+         * @brief Relative error in the target rates from removing the reactions not in `keptReactions`.
+         */
+        [[nodiscard]] double reductionError(
+            const std::vector<size_t>& offsets,
+            const std::vector<Participant>& participants,
+            const std::vector<double>& flows,
+            const std::vector<bool>& keptReactions,
+            bool energyTarget
+        ) const;
+
+        /**
+         * @brief Builds the skeletal engine over the given base engine reactions and its index maps.
+         *
+         * If the reactions are all of the base engine's, no engine is built and the view maps onto
+         * the base engine.
+         */
+        void buildSkeleton(const std::vector<size_t>& reactionIndices);
+
+        /**
+         * @brief Sets the skeletal engine's multipliers to the base engine's for its reactions.
+         */
+        void applySkeletalRateMultipliers() const;
+
+        /**
+         * @brief Validates that the view is not stale.
+         *
+         * @throws std::runtime_error If the view is stale.
+         */
+        void validateState() const;
+    };
+}
@@ -0,0 +1,253 @@
+#pragma once
+
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/engine/views/engine_view_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/logging/logging.h"
+
+#include "quill/Logger.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace gridfire {
+    /**
+     * @class FusedEngineView
+     * @brief Collapses a stack of index-mapped views into one gather/scatter onto the innermost engine.
+     *
+     * Stacking views (e.g. a FileDefinedEngineView over an AdaptiveEngineView over a GraphEngine)
+     * means every call allocates and remaps the abundance vector at each layer and checks each
+     * layer's state on the way down. Because an IndexMappedEngineView is fully described by its
+     * species and reaction index maps, the maps of a chain compose: view index `i` of the top view
+     * is index `m_k(...m_2(m_1(i)))` of the innermost (root) engine.
+     *
+     * This view walks the chain below the engine it wraps, composes the maps, and from then on
+     * talks to the root engine directly with a single scatter of the abundances and a single
+     * gather of the results. It presents exactly the species and reactions of the wrapped engine,
+     * in the same order, so it is a drop-in replacement for it.
+     *
+     * The composed maps are rebuilt by update() whenever the generation counter of any layer has
+     * changed. Calling update() directly on a wrapped view leaves the fused maps out of date; every
+     * call which touches the root engine checks the generations and throws rather than using them.
+     * The root engine itself is resolved through the chain on each call, never cached.
+     *
+     * @par Usage Example:
+     * @code
+     * GraphEngine graph(composition);
+     * AdaptiveEngineView adaptive(graph);
+     * FileDefinedEngineView defined(adaptive, "network.net", parser);
+     * FusedEngineView fused(defined);
+     * solver::DirectNetworkSolver solver(fused);
+     * @endcode
+     *
+     * @implements DynamicEngine
+     * @implements EngineView<DynamicEngine>
+     */
+    class FusedEngineView final : public DynamicEngine, public EngineView<DynamicEngine> {
+    public:
+        /**
+         * @brief Constructs a FusedEngineView over an engine, typically the top of a stack of views.
+         *
+         * @param topEngine The engine to present. If it is not an IndexMappedEngineView the fused
+         *                  maps are the identity and the root engine is `topEngine` itself.
+         */
+        explicit FusedEngineView(DynamicEngine& topEngine);
+
+        // --- EngineView Interface ---
+        /**
+         * @brief Gets the root engine that all calculations are delegated to.
+         *
+         * @throws std::runtime_error If the fused maps are out of date.
+         */
+        [[nodiscard]] const DynamicEngine& getBaseEngine() const override { return rootEngine(); }
+
+        // --- Engine Interface ---
+        /**
+         * @brief Gets the species of the wrapped engine.
+         */
+        [[nodiscard]] const std::vector<fourdst::atomic::Species>& getNetworkSpecies() const override;
+
+        [[nodiscard]] StepDerivatives<double> calculateRHSAndEnergy(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        // --- DynamicEngine Interface ---
+        [[nodiscard]] std::vector<double> calculateRHSSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            double T9,
+            double rho
+        ) const override;
+
+        [[nodiscard]] std::vector<double> calculateJacobianSubset(
+            const std::vector<double>& Y,
+            const std::vector<size_t>& speciesIndices,
+            const utils::SparsityPattern& pattern,
+            double T9,
+            double rho
+        ) override;
+
+        void generateJacobianMatrix(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) override;
+
+        [[nodiscard]] double getJacobianMatrixEntry(
+            int i,
+            int j
+        ) const override;
+
+        /**
+         * @brief Gets the root engine's Jacobian sparsity pattern restricted through the fused species map.
+         */
+        [[nodiscard]] utils::SparsityPattern getJacobianSparsityPattern() const override;
+
+        /**
+         * @brief Gets the root engine's stoichiometry sparsity pattern restricted through the fused maps.
+         */
+        [[nodiscard]] utils::SparsityPattern getStoichiometrySparsityPattern() const override;
+
+        /**
+         * @brief Gets the reaction hypergraph of the wrapped engine.
+         */
+        [[nodiscard]] const utils::NetworkHypergraph& getNetworkHypergraph() const override;
+
+        /**
+         * @brief Gets the root engine's block ordering restricted through the fused species map.
+         */
+        [[nodiscard]] utils::BlockOrdering getJacobianBlockOrdering() const override;
+
+        void generateStoichiometryMatrix() override;
+
+        [[nodiscard]] int getStoichiometryMatrixEntry(
+            int speciesIndex,
+            int reactionIndex
+        ) const override;
+
+        /**
+         * @brief Calculates the molar flow of a reaction of the wrapped engine.
+         *
+         * @throws std::runtime_error If the reaction is not part of the wrapped engine's network.
+         */
+        [[nodiscard]] double calculateMolarReactionFlow(
+            const reaction::Reaction& reaction,
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        [[nodiscard]] std::vector<double> calculateAllMolarReactionFlows(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        /**
+         * @brief Gets the reactions of the wrapped engine.
+         */
+        [[nodiscard]] const reaction::LogicalReactionSet& getNetworkReactions() const override;
+
+        [[nodiscard]] std::unordered_map<fourdst::atomic::Species, double> getSpeciesTimescales(
+            const std::vector<double>& Y,
+            double T9,
+            double rho
+        ) const override;
+
+        /**
+         * @brief Updates the wrapped engine and recomposes the index maps if any layer changed.
+         *
+         * @param netIn The current network input, passed on to the wrapped engine.
+         */
+        void update(const NetIn& netIn) override;
+
+        /**
+         * @brief Sets the screening model of the wrapped engine.
+         */
+        void setScreeningModel(screening::ScreeningType model) override;
+
+        /**
+         * @brief Gets the screening model of the root engine.
+         */
+        [[nodiscard]] screening::ScreeningType getScreeningModel() const override;
+
+        /**
+         * @brief Gets the rate multipliers of the wrapped engine.
+         *
+         * Views which build an engine of their own bring its multipliers up to date when the chain
+         * is resolved, so the root engine always evaluates with these multipliers.
+         */
+        [[nodiscard]] std::vector<double> getRateMultipliers() const override;
+
+        /**
+         * @brief Gets the rate multiplier generation of the wrapped engine.
+         */
+        [[nodiscard]] uint64_t getRateMultiplierGeneration() const override;
+
+        /**
+         * @brief Number of index-mapped views fused into a single map.
+         */
+        [[nodiscard]] size_t numFusedLayers() const { return m_layers.size(); }
+
+    private:
+        using LogManager = fourdst::logging::LogManager;
+        quill::Logger* m_logger = LogManager::getInstance().getLogger("log");
+
+        /**
+         * @brief An index-mapped view of the chain and the generation its maps were composed at.
+         */
+        struct FusedLayer {
+            const IndexMappedEngineView* view; ///< View in the chain.
+            uint64_t generation; ///< Index map generation of the view when the maps were composed.
+        };
+
+        DynamicEngine& m_topEngine; ///< Engine presented by this view.
+        std::vector<FusedLayer> m_layers; ///< Index-mapped views between the top and root engines, outermost first.
+        std::vector<size_t> m_speciesIndexMap; ///< Root engine species index of each top species.
+        std::vector<size_t> m_reactionIndexMap; ///< Root engine reaction index of each top reaction.
+
+    private:
+        /**
+         * @brief Walks the chain below the top engine and composes its index maps.
+         */
+        void fuse();
+
+        /**
+         * @brief Whether every fused layer still has the generation its maps were composed at.
+         */
+        [[nodiscard]] bool isCurrent() const;
+
+        /**
+         * @brief Throws if any layer has changed since the maps were composed.
+         *
+         * @throws std::runtime_error If the fused maps are out of date.
+         */
+        void validateState() const;
+
+        /**
+         * @brief Resolves the innermost engine, which all calculations are delegated to.
+         *
+         * The root is looked up through the last fused layer on every access rather than cached,
+         * because views such as AdaptiveEngineView and DRGEPEngineView replace the engine they own
+         * when they are updated; a cached pointer would dangle.
+         *
+         * @throws std::runtime_error If the fused maps are out of date.
+         */
+        [[nodiscard]] DynamicEngine& rootEngine() const;
+
+        /**
+         * @brief Scatters top abundances into a root engine abundance vector; other species are zero.
+         */
+        [[nodiscard]] std::vector<double> mapTopToRoot(const std::vector<double>& Y, const DynamicEngine& root) const;
+
+        /**
+         * @brief Gathers the top species entries of a root engine species vector.
+         */
+        [[nodiscard]] std::vector<double> mapRootToTop(const std::vector<double>& root) const;
+    };
+}
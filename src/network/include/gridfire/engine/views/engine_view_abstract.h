@@ -2,6 +2,9 @@
 
 #include "gridfire/engine/engine_abstract.h"
 
+#include <cstdint>
+#include <vector>
+
 /**
  * @file engine_view_abstract.h
  * @brief Abstract interfaces for engine "views" in GridFire.
@@ -95,4 +98,43 @@ namespace gridfire {
         virtual const EngineT& getBaseEngine() const = 0;
     };
 
+    /**
+     * @brief Abstract base class for views which only select and reorder species and reactions.
+     *
+     * An index-mapped view evaluates everything by scattering its abundances into the vector of
+     * another engine (its mapped engine), calling that engine, and gathering the results back. The
+     * whole view is therefore described by two index maps, and a chain of such views collapses into
+     * a single composed map onto the innermost engine (see FusedEngineView).
+     *
+     * The mapped engine is normally the base engine, but need not be: a view may delegate to an
+     * engine it owns. The generation counter must change whenever either index map or the mapped
+     * engine changes, so that composed maps can tell when they are out of date.
+     *
+     * @see gridfire::FusedEngineView
+     */
+    class IndexMappedEngineView : public EngineView<DynamicEngine> {
+    public:
+        /**
+         * @brief Access the engine that the index maps point into.
+         *
+         * @return Reference to the engine all calculations of the view are delegated to.
+         */
+        [[nodiscard]] virtual DynamicEngine& getMappedEngine() const = 0;
+
+        /**
+         * @brief Index of each view species in the mapped engine's species list.
+         */
+        [[nodiscard]] virtual const std::vector<size_t>& getSpeciesIndexMap() const = 0;
+
+        /**
+         * @brief Index of each view reaction in the mapped engine's reaction set.
+         */
+        [[nodiscard]] virtual const std::vector<size_t>& getReactionIndexMap() const = 0;
+
+        /**
+         * @brief Counter incremented whenever the index maps or the mapped engine change.
+         */
+        [[nodiscard]] virtual uint64_t getIndexMapGeneration() const = 0;
+    };
+
 }
\ No newline at end of file
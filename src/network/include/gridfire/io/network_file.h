@@ -1,15 +1,37 @@
 #pragma once
 
-#include "fourdst/config/config.h"
+#include "fourdst/composition/atomicSpecies.h"
 #include "fourdst/logging/logging.h"
 
 #include "quill/Logger.h"
 
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace gridfire::io {
 
+    /**
+     * @struct ReactionSpecification
+     * @brief A reaction given by its nuclear participants rather than by name.
+     *
+     * Formats such as MESA's name reactions in their own convention (e.g. `r_c12_ag_o16`), which
+     * does not map one to one onto PEN-style names. Such reactions are matched against the base
+     * network by their reactants and products instead. Photons, leptons, and neutrinos are omitted.
+     */
+    struct ReactionSpecification {
+        std::string label; ///< Name of the reaction in the file, for diagnostics.
+        std::vector<fourdst::atomic::Species> reactants; ///< Nuclear reactants, with multiplicity.
+        std::vector<fourdst::atomic::Species> products; ///< Nuclear products, with multiplicity.
+    };
+
     /**
      * @struct ParsedNetworkData
      * @brief Holds the data parsed from a network file.
@@ -25,18 +47,133 @@ namespace gridfire::io {
          * nuclear reactions as strings.
          */
         std::vector<std::string> reactionPENames;
+        /**
+         * @brief Reactions given by their participants, to be matched against the base network.
+         */
+        std::vector<ReactionSpecification> reactionSpecifications;
+        /**
+         * @brief Isotopes declared by the file, in declaration order and without duplicates.
+         */
+        std::vector<fourdst::atomic::Species> isotopes;
+        /**
+         * @brief Whether every base network reaction among `isotopes` belongs to the network.
+         */
+        bool includeIsotopeReactions = false;
+        /**
+         * @brief XXHash64 of the file content the data was parsed from.
+         */
+        uint64_t contentHash = 0;
+    };
+
+    /**
+     * @class NetworkFileParseCache
+     * @brief A bounded, thread-safe cache of parsed network files, shareable between parsers.
+     *
+     * Parsed data is kept by parser type and content hash, and the least recently used entry is
+     * evicted once the cache holds `capacity` entries. The content hash of each path is remembered
+     * along with the file's size and modification time, for at most `capacity` paths, so a file
+     * which has not changed since it was last seen need not be read at all.
+     */
+    class NetworkFileParseCache {
+    public:
+        /**
+         * @brief Size and modification time of a file when its content hash was taken.
+         */
+        struct FileStamp {
+            uint64_t size; ///< File size in bytes.
+            int64_t modificationTime; ///< Modification time in nanoseconds.
+            uint64_t contentHash; ///< Content hash at that size and modification time.
+        };
+
+        /**
+         * @brief Constructs an empty cache.
+         *
+         * @param capacity Maximum number of parsed files kept; at least 1.
+         */
+        explicit NetworkFileParseCache(size_t capacity = 16);
+
+        /**
+         * @brief Gets the content hash remembered for a path, if its stamp still matches.
+         *
+         * @param filename The path of the file.
+         * @param size The current size of the file.
+         * @param modificationTime The current modification time of the file.
+         * @return Whether a hash was found, and the hash.
+         */
+        [[nodiscard]] std::pair<bool, uint64_t> findContentHash(const std::string& filename, uint64_t size, int64_t modificationTime) const;
+
+        /**
+         * @brief Remembers the content hash of a path at the given size and modification time.
+         */
+        void rememberContentHash(const std::string& filename, const FileStamp& stamp);
+
+        /**
+         * @brief Looks up the data a parser of the given type parsed from content with the given hash.
+         *
+         * @return Whether the data was found, and a copy of it. A hit marks the entry most recently used.
+         */
+        [[nodiscard]] std::pair<bool, ParsedNetworkData> find(std::type_index parser, uint64_t contentHash);
+
+        /**
+         * @brief Stores parsed data, evicting the least recently used entry if the cache is full.
+         */
+        void insert(std::type_index parser, const ParsedNetworkData& parsed);
+
+        /**
+         * @brief Number of parsed files currently held.
+         */
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * @brief Maximum number of parsed files held.
+         */
+        [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    private:
+        /**
+         * @brief Key of a cache entry: the parser type and the content hash.
+         */
+        struct Key {
+            std::type_index parser; ///< Type of the parser which produced the data.
+            uint64_t contentHash; ///< Hash of the parsed content.
+
+            bool operator==(const Key& other) const = default;
+        };
+
+        /**
+         * @brief Hash of a cache key.
+         */
+        struct KeyHash {
+            size_t operator()(const Key& key) const {
+                return key.parser.hash_code() ^ static_cast<size_t>(key.contentHash);
+            }
+        };
+
+        using Entry = std::pair<Key, ParsedNetworkData>;
+
+        size_t m_capacity; ///< Maximum number of parsed files held.
+        mutable std::mutex m_mutex; ///< Guards all members below.
+        std::unordered_map<std::string, FileStamp> m_fileStamps; ///< Last seen stamp of each path.
+        std::list<Entry> m_entries; ///< Parsed data, most recently used first.
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index; ///< Position of each key in m_entries.
     };
 
     /**
      * @class NetworkFileParser
      * @brief An abstract base class for network file parsers.
      *
-     * This class defines the interface for parsing files that contain
-     * reaction network definitions. Derived classes must implement the `parse`
-     * method to handle specific file formats.
+     * This class defines the interface for parsing files that contain reaction network
+     * definitions. Derived classes implement parseContent() to handle a specific file format;
+     * parsers written against the filename interface may instead override parse(), which is then
+     * used by parseCached() as well. Parsers are copyable; copies share their parse cache.
      */
     class NetworkFileParser {
     public:
+        /**
+         * @brief Constructs a parser with a cache of its own.
+         */
+        NetworkFileParser();
+
         /**
          * @brief Virtual destructor for the base class.
          */
@@ -45,9 +182,8 @@ namespace gridfire::io {
         /**
          * @brief Parses a network file and returns the parsed data.
          *
-         * This is a pure virtual function that must be implemented by derived
-         * classes. It takes a filename as input and returns a `ParsedNetworkData`
-         * struct containing the information extracted from the file.
+         * Memory-maps the file, hashes its content into `ParsedNetworkData::contentHash`, and
+         * hands the mapped bytes to parseContent(), so no copy of the file is ever made.
          *
          * @param filename The path to the network file to parse.
          * @return A `ParsedNetworkData` struct containing the parsed reaction data.
@@ -68,8 +204,54 @@ namespace gridfire::io {
          * }
          * @endcode
          */
-        [[nodiscard]] virtual ParsedNetworkData parse(const std::string& filename) const = 0;
+        [[nodiscard]] virtual ParsedNetworkData parse(const std::string& filename) const;
 
+        /**
+         * @brief Parses a network file, reusing the result of an earlier parse of the same content.
+         *
+         * Results are kept in the parser's NetworkFileParseCache by parser type and content hash,
+         * so a file which has not changed since it was last seen is not read at all.
+         *
+         * @param filename The path to the network file to parse.
+         * @return The parsed data, identical to what parse() would return.
+         *
+         * @throws std::runtime_error If the file cannot be opened or a parsing error occurs.
+         */
+        [[nodiscard]] ParsedNetworkData parseCached(const std::string& filename) const;
+
+        /**
+         * @brief Replaces the parse cache, e.g. to share one cache between several parsers.
+         *
+         * @throws std::runtime_error If the cache is null.
+         */
+        void setCache(std::shared_ptr<NetworkFileParseCache> cache);
+
+        /**
+         * @brief Gets the parse cache.
+         */
+        [[nodiscard]] const std::shared_ptr<NetworkFileParseCache>& getCache() const { return m_cache; }
+
+    protected:
+        /**
+         * @brief Parses the content of a network file.
+         *
+         * The default forwards to parse(filename), for parsers which override parse() instead;
+         * the file is then read once more by that parse(). A parser must override one of the two.
+         *
+         * @param content The full content of the file.
+         * @param filename The path the content was read from, for diagnostics.
+         * @return The parsed data; `contentHash` is filled in by the caller.
+         *
+         * @throws std::runtime_error If a parsing error occurs, or if the parser overrides neither
+         * parse() nor parseContent().
+         */
+        [[nodiscard]] virtual ParsedNetworkData parseContent(
+            std::string_view content,
+            const std::string& filename
+        ) const;
+
+    private:
+        std::shared_ptr<NetworkFileParseCache> m_cache; ///< Parsed data by content hash; shared between copies of the parser.
     };
 
     /**
@@ -89,25 +271,24 @@ namespace gridfire::io {
          * @post The parser is initialized and ready to parse files.
          */
         explicit SimpleReactionListFileParser();
+    protected:
         /**
-         * @brief Parses a simple reaction list file.
+         * @brief Parses the content of a simple reaction list file.
          *
-         * This method reads the specified file line by line. It trims whitespace
+         * This method walks the content line by line. It trims whitespace
          * from each line, ignores lines that are empty or start with a '#'
          * comment character, and stores the remaining lines as reaction names.
          *
-         * @param filename The path to the simple reaction list file.
+         * @param content The content of the simple reaction list file.
+         * @param filename The path the content was read from.
          * @return A `ParsedNetworkData` struct containing the list of reaction names.
          *
-         * @throws std::runtime_error If the file cannot be opened for reading.
-         *
          * @b Algorithm
-         * 1. Opens the specified file.
-         * 2. Reads the file line by line.
-         * 3. For each line, it removes any trailing comments (starting with '#').
-         * 4. Trims leading and trailing whitespace.
-         * 5. If the line is not empty, it is added to the list of reaction names.
-         * 6. Returns the populated `ParsedNetworkData` struct.
+         * 1. Splits the content into lines, as views into the mapped file.
+         * 2. For each line, it removes any trailing comments (starting with '#').
+         * 3. Trims leading and trailing whitespace.
+         * 4. If the line is not empty, it is added to the list of reaction names.
+         * 5. Returns the populated `ParsedNetworkData` struct.
          *
          * @b Usage
          * @code
@@ -115,11 +296,9 @@ namespace gridfire::io {
          * ParsedNetworkData data = parser.parse("reactions.txt");
          * @endcode
          */
-        ParsedNetworkData parse(const std::string& filename) const override;
+        ParsedNetworkData parseContent(std::string_view content, const std::string& filename) const override;
     private:
-        using Config = fourdst::config::Config;
         using LogManager = fourdst::logging::LogManager;
-        Config& m_config = Config::getInstance();
         quill::Logger* m_logger = LogManager::getInstance().getLogger("log");
     };
 
@@ -128,7 +307,24 @@ namespace gridfire::io {
      * @brief A parser for MESA-format network files.
      *
      * This class is designed to parse reaction network files that follow the
-     * format used by the MESA stellar evolution code.
+     * format used by the MESA stellar evolution code. A MESA `.net` file is a sequence of
+     * commands, each followed by a parenthesised list:
+     *
+     *   - `add_isos(...)` declares isotopes.
+     *   - `add_isos_and_reactions(...)` declares isotopes and includes every reaction of the base
+     *     network among the declared isotopes.
+     *   - `add_reactions(...)` includes reactions by their MESA names.
+     *
+     * Isotopes are written either by name (`c12`, `neut`, `prot`) or as an element symbol followed
+     * by a mass number or an inclusive mass number range (`fe 52 58` is fe52 through fe58).
+     * Reaction names are of the form `r_<reactants>_<xy>_<products>`, where `x` and `y` are one of
+     * `n`, `p`, `a`, `g` (e.g. `r_c12_ag_o16`), `r_<reactants>_wk_<products>` or `_ec_` for weak
+     * reactions, or `r_<reactants>_to_<products>` (e.g. `r_he4_he4_he4_to_c12`). They are
+     * returned as ReactionSpecification entries. Comments start with `!`; commas count as
+     * whitespace. MESA's compound approximate rates (e.g. `rpp_to_he3`) have no counterpart in
+     * the base networks and are rejected. MESA's isomer names carry the state as a suffix: the
+     * ground state (`al26-1`) is read as the plain isotope, while excited states (`al26-2`) are
+     * not held by the base networks and are rejected.
      *
      * @implements NetworkFileParser
      */
@@ -143,23 +339,25 @@ namespace gridfire::io {
          * @post The parser is initialized with the context of the given file.
          */
         explicit MESANetworkFileParser(const std::string& filename);
+    protected:
         /**
-         * @brief Parses a MESA-format network file.
+         * @brief Parses the content of a MESA-format network file.
          *
-         * This method will read and interpret the structure of a MESA network
-         * file to extract the list of reactions.
+         * This method interprets the commands of a MESA network file to extract the declared
+         * isotopes and reactions. Tokens are views into the mapped file; only the results are
+         * allocated.
          *
-         * @param filename The path to the MESA network file.
-         * @return A `ParsedNetworkData` struct containing the list of reaction names.
+         * @param content The content of the MESA network file.
+         * @param filename The path the content was read from, for diagnostics.
+         * @return A `ParsedNetworkData` struct with the isotopes and reaction specifications.
          *
-         * @throws std::runtime_error If the file cannot be opened or if it
-         * contains formatting errors.
+         * @throws std::runtime_error If the content contains an unknown command, an unbalanced
+         * parenthesis, an unknown isotope, an excited isomeric state, or a reaction name which
+         * cannot be interpreted.
          */
-        ParsedNetworkData parse(const std::string& filename) const override;
+        ParsedNetworkData parseContent(std::string_view content, const std::string& filename) const override;
     private:
-        using Config = fourdst::config::Config;
         using LogManager = fourdst::logging::LogManager;
-        Config& m_config = Config::getInstance();
         quill::Logger* m_logger = LogManager::getInstance().getLogger("log");
 
         std::string m_filename;
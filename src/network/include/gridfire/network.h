@@ -21,6 +21,7 @@
 #pragma once
 
 #include <vector>
+#include <string>
 
 #include "fourdst/logging/logging.h"
 #include "fourdst/config/config.h"
@@ -66,9 +67,15 @@ namespace gridfire {
         fourdst::composition::Composition composition; ///< Composition of the network after evaluation
         int num_steps; ///< Number of steps taken in the evaluation
         double energy; ///< Energy in ergs after evaluation
+        double time = 0.0; ///< Time reached by the evaluation in seconds (NetIn::tMax unless an event stopped it early)
+        std::string triggeredEvent; ///< Name of the event which stopped the evaluation early, empty if it ran to NetIn::tMax
 
         friend std::ostream& operator<<(std::ostream& os, const NetOut& netOut) {
-            os << "NetOut(composition=" << netOut.composition << ", num_steps=" << netOut.num_steps << ", energy=" << netOut.energy << ")";
+            os << "NetOut(composition=" << netOut.composition << ", num_steps=" << netOut.num_steps << ", energy=" << netOut.energy << ", time=" << netOut.time;
+            if (!netOut.triggeredEvent.empty()) {
+                os << ", triggeredEvent=" << netOut.triggeredEvent;
+            }
+            os << ")";
             return os;
         }
     };
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "gridfire/utils/graph.h"
+
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "Eigen/SparseLU"
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @file block_triangular.h
+ * @brief Sparse LU factorization of block lower triangular matrices by blocks and forward substitution.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @class BlockTriangularLU
+     * @brief Factorizes a matrix which is block lower triangular under a known symmetric permutation.
+     *
+     * Reaction networks are only partially cyclic: light-particle captures and their reverses tie the
+     * light species together, while heavy species they feed often do not feed back. Permuted by
+     * DynamicEngine::getJacobianBlockOrdering(), the Jacobian (and hence any iteration matrix
+     * \f$I - h\gamma J\f$) is block lower triangular, so
+     * \f[
+     *   A x = b \quad\Longleftrightarrow\quad
+     *   A_{kk} x_k = b_k - \sum_{l < k} A_{kl} x_l, \qquad k = 1, \dots, K.
+     * \f]
+     * Only the diagonal blocks are factorized; the couplings below them are applied by forward
+     * substitution. Small blocks are factorized densely, large ones with a sparse LU.
+     *
+     * Entries of the matrix above the diagonal blocks do not fit the ordering. They are dropped, so
+     * the solve is then with a nearby matrix; this suits the simplified Newton iterations of the
+     * implicit solvers, which converge to the exact solution as long as the residual is exact.
+     * droppedEntries() reports how many were dropped by the last factorization.
+     *
+     * @par Usage Example:
+     * @code
+     * BlockTriangularLU lu;
+     * lu.setOrdering(engine.getJacobianBlockOrdering());
+     * if (lu.factorize(iterationMatrix)) {
+     *     Eigen::VectorXd x = lu.solve(b);
+     * }
+     * @endcode
+     */
+    class BlockTriangularLU {
+    public:
+        /**
+         * @brief Sets the block ordering of the matrices to be factorized.
+         * @param ordering Block lower triangular ordering over the matrix indices.
+         *
+         * Invalidates the current factorization.
+         */
+        void setOrdering(utils::BlockOrdering ordering);
+
+        /**
+         * @brief Gets the block ordering in use.
+         */
+        [[nodiscard]] const utils::BlockOrdering& getOrdering() const { return m_ordering; }
+
+        /**
+         * @brief Factorizes the diagonal blocks of a matrix and stores the couplings below them.
+         * @param A Square matrix with the dimension of the ordering.
+         * @return True if every diagonal block was factorized; false if one is singular.
+         */
+        bool factorize(const Eigen::SparseMatrix<double>& A);
+
+        /**
+         * @brief Solves \f$A x = b\f$ with the current factorization.
+         * @param b Right-hand side.
+         * @return The solution.
+         *
+         * @pre factorize() returned true.
+         */
+        [[nodiscard]] Eigen::VectorXd solve(const Eigen::VectorXd& b) const;
+
+        /**
+         * @brief Number of matrix entries above the diagonal blocks that the last factorize() dropped.
+         */
+        [[nodiscard]] size_t droppedEntries() const { return m_droppedEntries; }
+    private:
+        /**
+         * @brief Factorization of one diagonal block.
+         */
+        struct DiagonalBlock {
+            size_t begin = 0; ///< First permuted index of the block.
+            size_t size = 0; ///< Number of rows of the block.
+            Eigen::PartialPivLU<Eigen::MatrixXd> denseLU; ///< Factorization of blocks up to DENSE_BLOCK_LIMIT rows.
+            std::unique_ptr<Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>> sparseLU; ///< Factorization of larger blocks.
+        };
+
+        static constexpr size_t DENSE_BLOCK_LIMIT = 64; ///< Largest block factorized densely.
+
+        utils::BlockOrdering m_ordering; ///< Block ordering of the matrix.
+        std::vector<size_t> m_permutedIndex; ///< Permuted index of each matrix index.
+        std::vector<size_t> m_blockOf; ///< Block containing each permuted index.
+        std::vector<DiagonalBlock> m_blocks; ///< Factorized diagonal blocks, in block order.
+        Eigen::SparseMatrix<double, Eigen::RowMajor> m_coupling; ///< Entries below the diagonal blocks, in permuted indices.
+        size_t m_droppedEntries = 0; ///< Entries above the diagonal blocks dropped by the last factorization.
+    };
+}
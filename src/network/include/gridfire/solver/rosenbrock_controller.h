@@ -0,0 +1,18 @@
+#pragma once
+
+#include <boost/numeric/odeint.hpp>
+
+namespace gridfire::solver {
+
+    /**
+     * @struct RosenbrockController
+     * @brief The odeint Rosenbrock4 step size controller (and its stepper storage) kept in a SolverState.
+     *
+     * SolverState only holds a pointer to the controller, so that solver.h does not pull odeint into
+     * every translation unit which includes it. Solvers which integrate with the controller include
+     * this header.
+     */
+    struct RosenbrockController : boost::numeric::odeint::rosenbrock4_controller<boost::numeric::odeint::rosenbrock4<double>> {
+        using rosenbrock4_controller::rosenbrock4_controller;
+    };
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gridfire/engine/engine_graph.h"
+#include "gridfire/solver/solver_events.h"
 #include "gridfire/engine/engine_abstract.h"
 #include "../engine/views/engine_adaptive.h"
 #include "gridfire/network.h"
@@ -10,23 +11,149 @@
 
 #include "quill/Logger.h"
 
-#include "unsupported/Eigen/NonLinearOptimization" // Required for LevenbergMarquardt
+#include "Eigen/Core"
+#include "Eigen/SparseCore"
 
 #include <vector>
+#include <memory>
+#include <unordered_map>
+#include <deque>
+#include <utility>
+#include <optional>
+#include <cstdint>
 
 namespace gridfire::solver {
 
+    /**
+     * @struct QSECluster
+     * @brief An equilibrium cluster whose members follow its anchor through the Saha equation.
+     *
+     * In equilibrium with the free nucleons, each member \f$m\f$ of the cluster is related to the
+     * anchor \f$a\f$ by the ratio of their Saha abundances (see NSENetworkSolver::sahaLogOffset()),
+     * \f[
+     *   \ln Y_m = \ln Y_a + \ln R_m + \sum_k w_{mk} \ln Y_k,
+     * \f]
+     * where \f$k\f$ runs over the free proton, free neutron and α particle, and the exponents
+     * \f$w_{mk}\f$ make up the charge and neutron number difference between the member and the anchor
+     * from those present in the network.
+     */
+    struct QSECluster {
+        /**
+         * @brief A member of a cluster other than its anchor.
+         */
+        struct Member {
+            size_t speciesIndex; ///< Index of the member.
+            double lnRatio; ///< \f$\ln R_m\f$, the log ratio to the anchor at unit light particle abundances.
+            std::vector<std::pair<size_t, double>> lightExponents; ///< (Index, \f$w_{mk}\f$) of each light particle the member depends on.
+        };
+
+        size_t anchorIndex; ///< Index of the anchor; its dynamic slot holds the total abundance of the cluster.
+        std::vector<Member> members; ///< The other members of the cluster.
+    };
+
     /**
      * @struct dynamicQSESpeciesIndices
      * @brief Structure to hold indices of dynamic and QSE species.
      *
      * This structure is used by the QSENetworkSolver to store the indices of species
      * that are treated dynamically and those that are assumed to be in Quasi-Steady-State
-     * Equilibrium (QSE).
+     * Equilibrium (QSE). Members of equilibrium clusters other than their anchors are in neither list.
      */
     struct dynamicQSESpeciesIndices {
         std::vector<size_t> dynamicSpeciesIndices; ///< Indices of slow species that are not in QSE.
         std::vector<size_t> QSESpeciesIndices;  ///< Indices of fast species that are in QSE.
+        std::vector<QSECluster> QSEClusters; ///< Equilibrium clusters found in cluster mode.
+    };
+
+    /**
+     * @struct IMEXSpeciesPartition
+     * @brief Partition of the network species into implicitly and explicitly integrated sets.
+     *
+     * This structure is used by the IMEXNetworkSolver. Both index vectors are sorted in
+     * ascending order and index into the species list of the engine the solver was constructed with.
+     */
+    struct IMEXSpeciesPartition {
+        std::vector<size_t> implicitSpeciesIndices; ///< Indices of fast (stiff) species treated implicitly.
+        std::vector<size_t> explicitSpeciesIndices; ///< Indices of slow species treated explicitly.
+    };
+
+    struct IMEXImplicitSystem;
+    struct RosenbrockController;
+
+    /**
+     * @struct SolverState
+     * @brief Opt-in, per-zone state carried between successive calls to NetworkSolverStrategy::evaluate().
+     *
+     * In an evolution code the same zone is evaluated again one timestep later at nearly the same
+     * conditions. Without a persistent state every call starts from `NetIn::dt0` with a fresh step size
+     * controller, a fresh species partition and no Jacobian, so the first few steps of each call are
+     * typically rejected. Passing the same SolverState back in lets a solver warm start from where the
+     * previous call finished.
+     *
+     * A SolverState is bound to the species list of the engine it was last used with. If the species
+     * list changes (e.g. because an adaptive view was updated) the state is reset on the next call.
+     * Each solver only uses the fields relevant to it; the others are left untouched.
+     *
+     * SolverState is move-only. Keep one instance per zone. The Rosenbrock controller and the IMEX
+     * implicit system are held by pointer and only defined in rosenbrock_controller.h and
+     * solver_imex.h, so that this header does not depend on odeint or the sparse LU.
+     *
+     * @par Usage Example:
+     * @code
+     * DirectNetworkSolver solver(engine);
+     * std::vector<SolverState> zoneStates(numZones);
+     * for (size_t step = 0; step < numSteps; ++step) {
+     *     for (size_t z = 0; z < numZones; ++z) {
+     *         NetOut out = solver.evaluate(zoneInputs[z], zoneStates[z]);
+     *     }
+     * }
+     * @endcode
+     */
+    struct SolverState {
+        SolverState();
+        ~SolverState();
+        SolverState(SolverState&&) noexcept;
+        SolverState& operator=(SolverState&&) noexcept;
+
+        // --- Identity of the network the state was built for ---
+        size_t numSpecies = 0; ///< Number of species in the bound network.
+        uint64_t speciesHash = 0; ///< Hash of the ordered species names of the bound network.
+        double T9 = 0.0; ///< Temperature (in units of 10^9 K) of the last evaluation.
+        double rho = 0.0; ///< Density (g/cm^3) of the last evaluation.
+
+        // --- Step size control ---
+        double lastStepSize = 0.0; ///< Step size proposed by the controller at the end of the last evaluation (0 if none).
+        std::unique_ptr<RosenbrockController> rosenbrockController; ///< Controller (and stepper storage) of the DirectNetworkSolver, including its step size history.
+
+        // --- QSENetworkSolver ---
+        std::optional<dynamicQSESpeciesIndices> QSEPartition; ///< Dynamic / QSE partition of the last evaluation.
+        Eigen::VectorXd Y_QSE; ///< QSE abundances of the last evaluation, used as the initial guess of the next solve.
+
+        // --- IMEXNetworkSolver ---
+        IMEXSpeciesPartition IMEXPartition; ///< Implicit / explicit partition of the last accepted step.
+        std::unique_ptr<IMEXImplicitSystem> implicitSystem; ///< Fast block Jacobian and its factorization.
+        size_t stepsSinceJacobian = 0; ///< Accepted IMEX steps since the Jacobian was last evaluated.
+
+        // --- StiffnessDispatchNetworkSolver ---
+        std::optional<bool> stiff; ///< Whether the zone was being integrated implicitly at the end of the last evaluation.
+        std::vector<double> dominantEigenvector; ///< Last power iteration vector, used to warm start the spectral radius estimate.
+
+        // --- NSENetworkSolver / NSEDispatchNetworkSolver ---
+        std::optional<std::pair<double, double>> NSELogNucleonAbundances; ///< ln Y_p and ln Y_n of the last NSE solve, used as the initial guess of the next one.
+        std::optional<bool> inNSE; ///< Whether the zone was evaluated in NSE by the last call.
+
+        /**
+         * @brief Checks whether this state was built for the species list of the given engine.
+         * @param engine The engine about to be used.
+         * @return True if the state can be reused with `engine`.
+         */
+        [[nodiscard]] bool isCompatibleWith(const Engine& engine) const;
+
+        /**
+         * @brief Discards all solver data and binds the state to the species list of the given engine.
+         * @param engine The engine the state will be used with.
+         */
+        void bind(const Engine& engine);
     };
 
     /**
@@ -59,8 +186,47 @@ namespace gridfire::solver {
          * @return The output conditions after the timestep.
          */
         virtual NetOut evaluate(const NetIn& netIn) = 0;
+
+        /**
+         * @brief Evaluates the network for a given timestep, warm starting from a persistent state.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone state from a previous call. Updated in place for the next call.
+         * @return The output conditions after the timestep.
+         *
+         * The default implementation ignores the state and calls evaluate(netIn). Strategies which
+         * can reuse step sizes, partitions or factorizations between calls override this.
+         *
+         * @see SolverState
+         */
+        virtual NetOut evaluate(const NetIn& netIn, [[maybe_unused]] SolverState& state) {
+            return evaluate(netIn);
+        }
+
+        /**
+         * @brief Adds an event which stops the integration early when it fires.
+         * @param event The event to add.
+         *
+         * Every subsequent evaluate() call monitors all added events. When the first one fires, the
+         * solver returns the state at the located event time, with NetOut::time set to that time and
+         * NetOut::triggeredEvent set to the event name.
+         *
+         * @see solver_events.h for predefined events.
+         */
+        void addEvent(SolverEvent event) { m_events.push_back(std::move(event)); }
+
+        /**
+         * @brief Removes all events.
+         */
+        void clearEvents() { m_events.clear(); }
+
+        /**
+         * @brief Gets the events monitored by this solver.
+         * @return The events, in the order they were added.
+         */
+        [[nodiscard]] const std::vector<SolverEvent>& getEvents() const { return m_events; }
     protected:
         EngineT& m_engine; ///< The engine used by this solver strategy.
+        std::vector<SolverEvent> m_events; ///< Events which stop the integration early.
     };
 
     /**
@@ -112,7 +278,11 @@ namespace gridfire::solver {
          *   1. Updates the adaptive engine view (if necessary).
          *   2. Partitions the species into dynamic and QSE species based on their timescales.
          *   3. Calculates the steady-state abundances of the QSE species.
-         *   4. Integrates the ODEs for the dynamic species using a Runge-Kutta solver.
+         *   4. Integrates the ODEs for the dynamic species using a Runge-Kutta solver. After every
+         *      `gridfire:solver:QSE:reequilibrationInterval` (1) accepted steps the QSE species are
+         *      re-projected onto their steady state with a Newton solve warm started from their current
+         *      abundances, so that the dynamic species can take long steps. An interval of zero freezes
+         *      the QSE abundances for the whole call.
          *   5. Marshals the output variables into a NetOut struct.
          *
          * @throws std::runtime_error If the steady-state abundances cannot be calculated.
@@ -122,21 +292,76 @@ namespace gridfire::solver {
          * @see calculateSteadyStateAbundances()
          */
         NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the network using the QSE approach, warm starting from a persistent state.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state.
+         * @return The output conditions after the timestep.
+         *
+         * The species are repartitioned with hysteresis against the partition of the previous call
+         * (see packSpeciesTypeIndexVectors()). If the partition is unchanged, the QSE solve is started
+         * from the previous QSE abundances. The integration of the dynamic species starts from the last
+         * step size proposed by the controller.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
     private: // methods
         /**
          * @brief Packs the species indices into vectors based on their type (dynamic or QSE).
          * @param Y Vector of current abundances for all species.
          * @param T9 Temperature in units of 10^9 K.
          * @param rho Density in g/cm^3.
+         * @param previous The partition used by the previous evaluation, if any.
          * @return A dynamicQSESpeciesIndices struct containing the indices of the dynamic and QSE species.
          *
          * This method determines whether each species should be treated dynamically or as
          * being in QSE based on its timescale and abundance.  Species with short timescales
-         * or low abundances are assumed to be in QSE.
+         * or low abundances are assumed to be in QSE. The timescales \f$|Y_i / \dot{Y}_i|\f$ are
+         * taken from a single right-hand side evaluation.
          *
-         * @see DynamicEngine::getSpeciesTimescales()
+         * If a previous partition is given, a species only changes sides once it is past the
+         * cutoffs by a factor of `gridfire:solver:QSE:partition:hysteresis` (10): a QSE species
+         * becomes dynamic once its timescale and abundance exceed the cutoffs times the factor, and a
+         * dynamic species becomes QSE once either drops below the cutoffs divided by the factor. This
+         * keeps species near the cutoff from flapping between evaluations, which would discard the
+         * warm start of the QSE solve.
+         *
+         * If `gridfire:solver:QSE:clusters:enabled` (false) is set, the species are additionally grouped
+         * into equilibrium clusters (see detectQSEClusters()), which are parametrized by their anchor and
+         * the light particle abundances through the Saha equation (see QSECluster), with the partition
+         * functions of NSENetworkSolver::groundStatePartitionFunction(). The anchor and the light
+         * particles the members depend on become dynamic. The dynamic slot of the anchor carries the
+         * total abundance of the cluster, whose rate of change is free of the fast flows within it; the
+         * total is split over the members by their Saha ratios whenever the full abundances are needed.
+         * Members whose charge and neutron number difference to the anchor cannot be made up from the
+         * light particles in the network (e.g. a change of neutron number without free neutrons or α
+         * particles) are left to the flat QSE solve.
          */
         dynamicQSESpeciesIndices packSpeciesTypeIndexVectors(
+            const std::vector<double>& Y,
+            const double T9,
+            const double rho,
+            const std::optional<dynamicQSESpeciesIndices>& previous
+        ) const;
+
+        /**
+         * @brief Detects clusters of species linked by fast reactions.
+         * @param Y Vector of current abundances for all species.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The clusters, each with its most abundant member (the anchor) first.
+         *
+         * A reaction is a fast link from each of its reactants to each of its products if it would
+         * consume the reactant on a timescale shorter than `gridfire:solver:QSE:clusters:linkTimescale`
+         * (1e-5 s). Species that are mutually in equilibrium are linked both ways, by a reaction and its
+         * reverse or by a closed cycle, so the clusters are the strongly connected components of the
+         * fast-link graph. The free nucleons and α particles parametrize the clusters rather than belong
+         * to them, so they are removed from the components, and only components with at least
+         * `gridfire:solver:QSE:clusters:minSize` (2) remaining members are kept.
+         *
+         * @see utils::stronglyConnectedComponents()
+         */
+        std::vector<std::vector<size_t>> detectQSEClusters(
             const std::vector<double>& Y,
             const double T9,
             const double rho
@@ -150,10 +375,23 @@ namespace gridfire::solver {
          * @param indices A dynamicQSESpeciesIndices struct containing the indices of the dynamic and QSE species.
          * @return An Eigen::VectorXd containing the steady-state abundances of the QSE species.
          *
-         * This method solves a system of algebraic equations to determine the steady-state
-         * abundances of the QSE species.
+         * This method solves \f$\dot{Y}_i = 0\f$ for the QSE species with a damped Newton iteration
+         * in log space (see QSENewtonSystem):
+         *   - Each Newton system is solved with a sparse LU factorization of the QSE sub-Jacobian.
+         *   - Steps are limited to `maxLogStep` in \f$\ln Y\f$ and then backtracked until the Armijo
+         *     condition on \f$\frac{1}{2}\|F\|^2\f$ holds.
+         *   - The factorization is reused across iterations (simplified Newton) as long as successive
+         *     steps contract by at least `jacobianReuseRate`. If a stale factorization fails to give a
+         *     descent direction, the Jacobian is re-evaluated before giving up.
          *
-         * @throws std::runtime_error If the steady-state abundances cannot be calculated.
+         * The iteration converges when the largest step in \f$\ln Y\f$ drops below `tolerance`. The
+         * following configuration keys are read (with defaults):
+         *   - `gridfire:solver:QSE:newton:maxIterations` (50)
+         *   - `gridfire:solver:QSE:newton:tolerance` (1e-8)
+         *   - `gridfire:solver:QSE:newton:maxLogStep` (5.0)
+         *   - `gridfire:solver:QSE:newton:jacobianReuseRate` (0.5)
+         *
+         * @throws std::runtime_error If the Newton iteration fails to converge.
          */
         Eigen::VectorXd calculateSteadyStateAbundances(
             const std::vector<double>& Y,
@@ -171,11 +409,30 @@ namespace gridfire::solver {
          * density to ignite the network and bring it closer to equilibrium.  This can improve
          * the convergence of the QSE solver.
          *
+         * The ignition is skipped, and the input composition returned unchanged, if the
+         * composition already has populated intermediates (see hasPopulatedIntermediates()).
+         * Otherwise the result is cached, keyed by an XXHash64 of the molar abundances of the
+         * network species and the ignition conditions, seeded with the hash of the engine's
+         * reaction set. The cache holds at most `gridfire:solver:QSE:ignition:cacheSize` (64)
+         * entries and evicts the oldest entry first; a size of zero disables caching.
+         *
          * @see DirectNetworkSolver::evaluate()
          */
         NetOut initializeNetworkWithShortIgnition(
             const NetIn& netIn
-        ) const;
+        );
+
+        /**
+         * @brief Determines whether a composition is already populated well enough to skip ignition.
+         * @param netIn The input conditions for the network.
+         * @return True if at least `gridfire:solver:QSE:ignition:populatedFraction` (0.9) of the network
+         *         species have a molar abundance of at least `gridfire:solver:QSE:ignition:populatedAbundance` (1e-20).
+         *
+         * The ignition pre-burn exists to seed the intermediate species of a fresh composition so that
+         * the QSE partition and solve have something to work with. Compositions coming out of a
+         * previous evaluation of the same network already carry those intermediates.
+         */
+        bool hasPopulatedIntermediates(const NetIn& netIn) const;
 
         /**
          * @brief Determines whether the adaptive engine view should be updated.
@@ -202,6 +459,7 @@ namespace gridfire::solver {
             DynamicEngine& m_engine; ///< The engine used to evaluate the network.
             const std::vector<size_t>& m_dynamicSpeciesIndices; ///< Indices of the dynamic species.
             const std::vector<size_t>& m_QSESpeciesIndices; ///< Indices of the QSE species.
+            const std::vector<QSECluster>& m_QSEClusters; ///< Equilibrium clusters; their anchors carry the cluster totals.
             const Eigen::VectorXd& m_Y_QSE; ///< Steady-state abundances of the QSE species.
             const double m_T9; ///< Temperature in units of 10^9 K.
             const double m_rho; ///< Density in g/cm^3.
@@ -213,6 +471,7 @@ namespace gridfire::solver {
              * @param engine The engine used to evaluate the network.
              * @param dynamicSpeciesIndices Indices of the dynamic species.
              * @param QSESpeciesIndices Indices of the QSE species.
+             * @param QSEClusters Equilibrium clusters.
              * @param Y_QSE Steady-state abundances of the QSE species.
              * @param T9 Temperature in units of 10^9 K.
              * @param rho Density in g/cm^3.
@@ -221,6 +480,7 @@ namespace gridfire::solver {
                 DynamicEngine& engine,
                 const std::vector<size_t>& dynamicSpeciesIndices,
                 const std::vector<size_t>& QSESpeciesIndices,
+                const std::vector<QSECluster>& QSEClusters,
                 const Eigen::VectorXd& Y_QSE,
                 const double T9,
                 const double rho
@@ -228,6 +488,7 @@ namespace gridfire::solver {
             m_engine(engine),
             m_dynamicSpeciesIndices(dynamicSpeciesIndices),
             m_QSESpeciesIndices(QSESpeciesIndices),
+            m_QSEClusters(QSEClusters),
             m_Y_QSE(Y_QSE),
             m_T9(T9),
             m_rho(rho) {}
@@ -300,70 +561,60 @@ namespace gridfire::solver {
         };
 
         /**
-         * @struct EigenFunctor
-         * @brief Functor for calculating the residual and Jacobian for the QSE species using Eigen.
+         * @struct QSENewtonSystem
+         * @brief Residual and sparse log-space Jacobian of the QSE conditions, used by the Newton solve.
          *
-         * @tparam T The numeric type to use for the calculation (double or ADDouble).
+         * The unknowns are \f$v_i = \ln Y_i\f$ for the QSE species, which keeps the abundances positive
+         * and makes Newton steps relative changes. The residual is \f$F_i(v) = \dot{Y}_i\f$ for each QSE
+         * species with all other abundances held fixed, and the Jacobian is
+         * \f$\partial F_i / \partial v_j = J_{ij} Y_j\f$.
          */
-        template<typename T>
-        struct EigenFunctor {
-            using InputType = Eigen::Matrix<T, Eigen::Dynamic, 1>;
-            using OutputType = Eigen::Matrix<T, Eigen::Dynamic, 1>;
-            using JacobianType = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
-            enum {
-                InputsAtCompileTime = Eigen::Dynamic,
-                ValuesAtCompileTime = Eigen::Dynamic
-            };
-
+        struct QSENewtonSystem {
             DynamicEngine& m_engine; ///< The engine used to evaluate the network.
-            const std::vector<double>& m_YFull; ///< The full, initial abundance vector
-            const std::vector<size_t>& m_dynamicSpeciesIndices; ///< Indices of the dynamic species.
+            std::vector<double> m_Y; ///< Full abundance vector; QSE entries are overwritten at each evaluation.
             const std::vector<size_t>& m_QSESpeciesIndices; ///< Indices of the QSE species.
             const double m_T9; ///< Temperature in units of 10^9 K.
             const double m_rho; ///< Density in g/cm^3.
+            const utils::SparsityPattern m_jacobianPattern; ///< Structural pattern of the QSE block of the engine Jacobian.
 
             /**
-             * @brief Constructor for the EigenFunctor.
+             * @brief Constructor for the QSENewtonSystem.
              * @param engine The engine used to evaluate the network.
-             * @param YFull Abundances of the dynamic species.
-             * @param dynamicSpeciesIndices Indices of the dynamic species.
+             * @param Y Abundances of all species; the dynamic entries are held fixed.
              * @param QSESpeciesIndices Indices of the QSE species.
              * @param T9 Temperature in units of 10^9 K.
              * @param rho Density in g/cm^3.
              */
-            EigenFunctor(
+            QSENewtonSystem(
                 DynamicEngine& engine,
-                const std::vector<double>& YFull,
-                const std::vector<size_t>& dynamicSpeciesIndices,
+                const std::vector<double>& Y,
                 const std::vector<size_t>& QSESpeciesIndices,
                 const double T9,
                 const double rho
             ) :
             m_engine(engine),
-            m_YFull(YFull),
-            m_dynamicSpeciesIndices(dynamicSpeciesIndices),
+            m_Y(Y),
             m_QSESpeciesIndices(QSESpeciesIndices),
             m_T9(T9),
-            m_rho(rho) {}
-
-            int values() const { return m_QSESpeciesIndices.size(); }
-            int inputs() const { return m_QSESpeciesIndices.size(); }
+            m_rho(rho),
+            m_jacobianPattern(utils::restrictSparsityPattern(engine.getJacobianSparsityPattern(), QSESpeciesIndices, QSESpeciesIndices)) {}
 
             /**
              * @brief Calculates the residual vector for the QSE species.
-             * @param v_QSE_log Input vector of QSE species abundances (logarithmic).
+             * @param v_QSE_log QSE species abundances (logarithmic).
              * @param f_QSE Output vector of residuals.
-             * @return 0 for success.
              */
-            int operator()(const InputType& v_QSE_log, OutputType& f_QSE) const;
+            void residual(const Eigen::VectorXd& v_QSE_log, Eigen::VectorXd& f_QSE);
 
             /**
-             * @brief Calculates the Jacobian matrix for the QSE species.
-             * @param v_QSE_log Input vector of QSE species abundances (logarithmic).
-             * @param J_QSE Output Jacobian matrix.
-             * @return 0 for success.
+             * @brief Calculates the sparse log-space Jacobian of the residual.
+             * @param v_QSE_log QSE species abundances (logarithmic).
+             * @param J_QSE Output Jacobian; only entries which are nonzero in the engine Jacobian are stored.
+             *
+             * Only the QSE block is evaluated, at the entries of its structural pattern, with
+             * DynamicEngine::calculateJacobianSubset(); the full network Jacobian is never formed.
              */
-            int df(const InputType& v_QSE_log, JacobianType& J_QSE) const;
+            void jacobian(const Eigen::VectorXd& v_QSE_log, Eigen::SparseMatrix<double>& J_QSE);
         };
     private:
         quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
@@ -371,6 +622,9 @@ namespace gridfire::solver {
 
         bool m_isViewInitialized = false; ///< Flag indicating whether the adaptive engine view has been initialized.
         NetIn m_lastSeenConditions; ///< The last seen input conditions.
+
+        std::unordered_map<uint64_t, NetOut> m_ignitionCache; ///< Ignition results keyed by composition, conditions, reaction set and rate multiplier generation.
+        std::deque<uint64_t> m_ignitionCacheOrder; ///< Insertion order of the ignition cache keys, oldest first.
     };
 
     /**
@@ -381,15 +635,45 @@ namespace gridfire::solver {
      * ODEs. It is simpler than the QSENetworkSolver, but it can be less efficient for
      * stiff networks with disparate timescales.
      *
-     * @implements DynamicNetworkSolverStrategy
+     * Over a long evaluation the reactions that matter change (e.g. CNO ignition early on, fuel
+     * depletion late). With re-culling on (see setRecullDuringIntegration()), the solver checks
+     * every `gridfire:solver:DirectNetworkSolver:RecullCheckInterval` accepted steps (default 50)
+     * how far the relative reaction flows have drifted since the network was last culled. Once any flow has moved by
+     * more than `RecullFlowDrift` decades (default 2) it stops at that step boundary, calls
+     * DynamicEngine::update() with the current composition, remaps the abundances onto the new
+     * species list and continues. Species dropped from the network keep their last abundance and
+     * are reported in the output composition, so mass is conserved across re-culls.
+     *
+     * The solver is templated on the engine type. DirectNetworkSolver, the instantiation on
+     * DynamicEngine, accepts any engine or view and reaches it through the virtual interface. An
+     * instantiation on a final engine type (GraphEngine or one of the engine views) calls that
+     * type's methods directly, so the per-step calls of the integrator (calculateRHSAndEnergy(),
+     * and getJacobianMatrixEntry() for every Jacobian entry) can be inlined. The view a solver
+     * holds still reaches its own base engine virtually; wrap a stack of views in a
+     * FusedEngineView to reduce it to a single layer. Instantiations are provided for
+     * DynamicEngine, GraphEngine, AdaptiveEngineView, FileDefinedEngineView, FusedEngineView and
+     * DRGEPEngineView. For any other final engine type, include `gridfire/solver/solver.inl`,
+     * which holds the member definitions, where the solver is used.
+     *
+     * @tparam EngineT The engine type, either DynamicEngine or a final engine type.
+     *
+     * @par Usage Example:
+     * @code
+     * GraphEngine graph(composition);
+     * BasicDirectNetworkSolver solver(graph); // BasicDirectNetworkSolver<GraphEngine>
+     * NetOut netOut = solver.evaluate(netIn);
+     * @endcode
+     *
+     * @implements NetworkSolverStrategy
      */
-    class DirectNetworkSolver final : public DynamicNetworkSolverStrategy {
+    template <SolverEngineType EngineT>
+    class BasicDirectNetworkSolver final : public NetworkSolverStrategy<EngineT> {
     public:
         /**
-         * @brief Constructor for the DirectNetworkSolver.
-         * @param engine The dynamic engine to use for evaluating the network.
+         * @brief Constructor for the BasicDirectNetworkSolver.
+         * @param engine The engine to use for evaluating the network.
          */
-        using DynamicNetworkSolverStrategy::DynamicNetworkSolverStrategy;
+        using NetworkSolverStrategy<EngineT>::NetworkSolverStrategy;
 
         /**
          * @brief Evaluates the network for a given timestep using direct integration.
@@ -397,7 +681,37 @@ namespace gridfire::solver {
          * @return The output conditions after the timestep.
          */
         NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the network using direct integration, warm starting from a persistent state.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state.
+         * @return The output conditions after the timestep.
+         *
+         * The Rosenbrock step size controller (including its step size history) is kept in the state,
+         * so the first step of this call is the step the controller would have taken next in the
+         * previous call rather than `netIn.dt0`.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
+
+        /**
+         * @brief Turns re-culling of the engine during integration on or off for this solver.
+         * @param recull Whether to call DynamicEngine::update() when the reaction flows have drifted.
+         *
+         * Defaults to `gridfire:solver:DirectNetworkSolver:RecullDuringIntegration` (false). Turn it
+         * off for solvers which integrate an engine at conditions other than those it is culled for,
+         * such as the ignition pre-burn of the QSENetworkSolver.
+         */
+        void setRecullDuringIntegration(bool recull);
+
+        /**
+         * @brief Whether this solver re-culls the engine during integration.
+         */
+        [[nodiscard]] bool getRecullDuringIntegration() const;
     private:
+        using NetworkSolverStrategy<EngineT>::m_engine;
+        using NetworkSolverStrategy<EngineT>::m_events;
+
         /**
          * @struct RHSFunctor
          * @brief Functor for calculating the right-hand side of the ODEs.
@@ -407,7 +721,7 @@ namespace gridfire::solver {
          * time derivatives.
          */
         struct RHSFunctor {
-            DynamicEngine& m_engine; ///< The engine used to evaluate the network.
+            EngineT& m_engine; ///< The engine used to evaluate the network.
             const double m_T9; ///< Temperature in units of 10^9 K.
             const double m_rho; ///< Density in g/cm^3.
             const size_t m_numSpecies; ///< The number of species in the network.
@@ -420,7 +734,7 @@ namespace gridfire::solver {
              * @param rho Density in g/cm^3.
              */
             RHSFunctor(
-                DynamicEngine& engine,
+                EngineT& engine,
                 const double T9,
                 const double rho
             ) :
@@ -450,7 +764,7 @@ namespace gridfire::solver {
          * ODEs. It takes the current abundances as input and returns the Jacobian matrix.
          */
         struct JacobianFunctor {
-            DynamicEngine& m_engine; ///< The engine used to evaluate the network.
+            EngineT& m_engine; ///< The engine used to evaluate the network.
             const double m_T9; ///< Temperature in units of 10^9 K.
             const double m_rho; ///< Density in g/cm^3.
             const size_t m_numSpecies; ///< The number of species in the network.
@@ -462,7 +776,7 @@ namespace gridfire::solver {
              * @param rho Density in g/cm^3.
              */
             JacobianFunctor(
-                DynamicEngine& engine,
+                EngineT& engine,
                 const double T9,
                 const double rho
             ) :
@@ -490,49 +804,18 @@ namespace gridfire::solver {
     private:
         quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
         fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
-    };
-
-    template<typename T>
-    int QSENetworkSolver::EigenFunctor<T>::operator()(const InputType &v_QSE_log, OutputType &f_QSE) const {
-        std::vector<double> y = m_YFull; // Full vector of species abundances
-        Eigen::VectorXd Y_QSE = v_QSE_log.array().exp();
-
-        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
-            y[m_QSESpeciesIndices[i]] = Y_QSE(i);
-        }
-
-
-        const auto [dydt, specificEnergyRate] = m_engine.calculateRHSAndEnergy(y, m_T9, m_rho);
-        f_QSE.resize(m_QSESpeciesIndices.size());
-        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
-            f_QSE(i) = dydt[m_QSESpeciesIndices[i]];
-        }
-        return 0; // Success
-    }
-
-    template <typename T>
-    int QSENetworkSolver::EigenFunctor<T>::df(const InputType& v_QSE_log, JacobianType& J_QSE) const {
-        std::vector<double> y = m_YFull;
-        Eigen::VectorXd Y_QSE = v_QSE_log.array().exp();
-
-        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
-            y[m_QSESpeciesIndices[i]] = Y_QSE(i);
-        }
-
-        m_engine.generateJacobianMatrix(y, m_T9, m_rho);
 
-        J_QSE.resize(m_QSESpeciesIndices.size(), m_QSESpeciesIndices.size());
-        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
-            for (size_t j = 0; j < m_QSESpeciesIndices.size(); ++j) {
-                J_QSE(i, j) = m_engine.getJacobianMatrixEntry(m_QSESpeciesIndices[i], m_QSESpeciesIndices[j]);
-            }
-        }
-
-        for (long j = 0; j < J_QSE.cols(); ++j) {
-            J_QSE(j, j) *= Y_QSE(j); // chain rule for log space transformation
-        }
-        return 0;
-    }
+        bool m_recullDuringIntegration = m_config.get<bool>("gridfire:solver:DirectNetworkSolver:RecullDuringIntegration", false); ///< Whether to re-cull the engine during integration.
+    };
 
+    /**
+     * @brief Deduces the engine type of a BasicDirectNetworkSolver from the engine it is built on.
+     */
+    template <SolverEngineType EngineT>
+    BasicDirectNetworkSolver(EngineT&) -> BasicDirectNetworkSolver<EngineT>;
 
-}
\ No newline at end of file
+    /**
+     * @brief Type alias for the direct solver that dispatches through the DynamicEngine interface.
+     */
+    using DirectNetworkSolver = BasicDirectNetworkSolver<DynamicEngine>;
+}
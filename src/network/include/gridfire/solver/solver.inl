@@ -0,0 +1,409 @@
+#pragma once
+
+/**
+ * @file solver.inl
+ * @brief Member definitions of BasicDirectNetworkSolver.
+ *
+ * The library instantiates BasicDirectNetworkSolver for DynamicEngine and for its own final engine
+ * types (see the extern declarations at the end of this file). To run the solver on another final
+ * engine type with static dispatch, include this file in one translation unit which uses it.
+ */
+
+#include "gridfire/solver/solver.h"
+#include "gridfire/solver/solver_events.h"
+#include "gridfire/solver/rosenbrock_controller.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_adaptive.h"
+#include "gridfire/engine/views/engine_defined.h"
+#include "gridfire/engine/views/engine_fused.h"
+#include "gridfire/engine/views/engine_drgep.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/composition/composition.h"
+
+#include "quill/LogMacros.h"
+
+#include <boost/numeric/odeint.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gridfire::solver {
+    namespace detail {
+        inline constexpr size_t MAX_FAILED_STEP_ATTEMPTS = 500; ///< Matches odeint's default failed step checker.
+
+        /**
+         * @brief Integrates from tStart to tEnd with an odeint controlled stepper, one try_step at a time.
+         *
+         * Unlike odeint::integrate_adaptive, the controller is taken by reference (so any internal
+         * history it keeps survives the call) and the step size the controller would take next is
+         * written back to `dt`. The final step is clamped to land on tEnd; that clamping does not
+         * shrink the returned proposal.
+         *
+         * After every accepted step `onAcceptedStep(t, x)` is called; returning true stops the
+         * integration (e.g. because an event fired).
+         *
+         * @return The number of accepted steps.
+         */
+        template <typename Controller, typename System, typename State, typename StepObserver>
+        size_t integrateControlled(
+            Controller& controller,
+            System system,
+            State& x,
+            const double tStart,
+            const double tEnd,
+            double& dt,
+            quill::Logger* logger,
+            StepObserver&& onAcceptedStep
+        ) {
+            namespace odeint = boost::numeric::odeint;
+
+            double t = tStart;
+            size_t stepCount = 0;
+            size_t failedAttempts = 0;
+            double dtProposal = dt;
+            while (tEnd - t > std::numeric_limits<double>::epsilon() * std::abs(tEnd)) {
+                double dtTry = std::min(dtProposal, tEnd - t);
+                const bool clamped = dtTry < dtProposal;
+                if (controller.try_step(system, x, t, dtTry) == odeint::success) {
+                    ++stepCount;
+                    failedAttempts = 0;
+                    dtProposal = clamped ? std::max(dtTry, dtProposal) : dtTry;
+                    if (onAcceptedStep(t, x)) {
+                        break;
+                    }
+                } else {
+                    if (++failedAttempts >= MAX_FAILED_STEP_ATTEMPTS) {
+                        LOG_ERROR(logger, "Step size adjustment failed {} times in a row at t = {:0.3E} s (dt = {:0.3E} s).", failedAttempts, t, dtTry);
+                        logger->flush_log();
+                        throw std::runtime_error("Step size adjustment failed after " + std::to_string(failedAttempts) + " attempts.");
+                    }
+                    dtProposal = dtTry;
+                }
+            }
+            dt = dtProposal;
+            return stepCount;
+        }
+
+        /**
+         * @brief Molar abundances of every species a network has held during one evaluation.
+         *
+         * When the network is re-culled mid-integration, species dropped from it keep their last
+         * abundance here, so no mass is lost, and species added to it start from the abundance they
+         * had when they were last active (zero if never). Entries keep their insertion order so the
+         * output composition is deterministic.
+         */
+        class AbundanceLedger {
+        public:
+            /**
+             * @brief Records the abundances of a network.
+             * @param species Species of the network.
+             * @param Y Molar abundances, in the order of `species` (extra trailing entries are ignored).
+             */
+            template <typename Vector>
+            void record(const std::vector<fourdst::atomic::Species>& species, const Vector& Y) {
+                for (size_t i = 0; i < species.size(); ++i) {
+                    const auto [it, inserted] = m_index.try_emplace(species[i], m_species.size());
+                    if (inserted) {
+                        m_species.push_back(species[i]);
+                        m_Y.push_back(Y(i));
+                    } else {
+                        m_Y[it->second] = Y(i);
+                    }
+                }
+            }
+
+            /**
+             * @brief Last recorded abundance of a species, or zero if it was never recorded.
+             */
+            [[nodiscard]] double abundance(const fourdst::atomic::Species& species) const {
+                const auto it = m_index.find(species);
+                return it == m_index.end() ? 0.0 : m_Y[it->second];
+            }
+
+            [[nodiscard]] const std::vector<fourdst::atomic::Species>& species() const { return m_species; }
+            [[nodiscard]] const std::vector<double>& abundances() const { return m_Y; }
+        private:
+            std::unordered_map<fourdst::atomic::Species, size_t> m_index;
+            std::vector<fourdst::atomic::Species> m_species;
+            std::vector<double> m_Y;
+        };
+
+        /**
+         * @brief Largest change, in decades, of any reaction's flow relative to the strongest flow.
+         *
+         * Flows are normalized by their maximum and floored at `floor` before comparing, so reactions
+         * which are negligible at both points do not count.
+         */
+        inline double relativeFlowDrift(const std::vector<double>& reference, const std::vector<double>& current, const double floor) {
+            if (reference.size() != current.size() || reference.empty()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            const double referenceMax = *std::ranges::max_element(reference);
+            const double currentMax = *std::ranges::max_element(current);
+            if (referenceMax <= 0.0 || currentMax <= 0.0) {
+                return 0.0;
+            }
+            double drift = 0.0;
+            for (size_t j = 0; j < reference.size(); ++j) {
+                const double a = std::max(reference[j] / referenceMax, floor);
+                const double b = std::max(current[j] / currentMax, floor);
+                drift = std::max(drift, std::abs(std::log10(b) - std::log10(a)));
+            }
+            return drift;
+        }
+    }
+
+    template <SolverEngineType EngineT>
+    NetOut BasicDirectNetworkSolver<EngineT>::evaluate(const NetIn &netIn) {
+        SolverState state;
+        return evaluate(netIn, state);
+    }
+
+    template <SolverEngineType EngineT>
+    void BasicDirectNetworkSolver<EngineT>::setRecullDuringIntegration(const bool recull) {
+        m_recullDuringIntegration = recull;
+    }
+
+    template <SolverEngineType EngineT>
+    bool BasicDirectNetworkSolver<EngineT>::getRecullDuringIntegration() const {
+        return m_recullDuringIntegration;
+    }
+
+    template <SolverEngineType EngineT>
+    NetOut BasicDirectNetworkSolver<EngineT>::evaluate(const NetIn &netIn, SolverState &state) {
+        namespace ublas = boost::numeric::ublas;
+        namespace odeint = boost::numeric::odeint;
+        using fourdst::composition::Composition;
+
+
+        const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
+
+        const auto absTol = m_config.get<double>("gridfire:solver:DirectNetworkSolver:absTol", 1.0e-8);
+        const auto relTol = m_config.get<double>("gridfire:solver:DirectNetworkSolver:relTol", 1.0e-8);
+
+        const bool recull = m_recullDuringIntegration;
+        const auto recullInterval = m_config.get<int>("gridfire:solver:DirectNetworkSolver:RecullCheckInterval", 50);
+        const auto recullFlowDrift = m_config.get<double>("gridfire:solver:DirectNetworkSolver:RecullFlowDrift", 2.0);
+        constexpr double FLOW_DRIFT_FLOOR = 1.0e-20; // Relative flows below this are treated as negligible when measuring drift
+
+        size_t stepCount = 0;
+        size_t numSpecies = m_engine.getNetworkSpecies().size();
+
+        ublas::vector<double> Y(numSpecies + 1);
+
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const auto& species = m_engine.getNetworkSpecies()[i];
+            try {
+                Y(i) = netIn.composition.getMolarAbundance(std::string(species.name()));
+            } catch (const std::runtime_error) {
+                LOG_DEBUG(m_logger, "Species '{}' not found in composition. Setting abundance to 0.0.", species.name());
+                Y(i) = 0.0;
+            }
+        }
+        Y(numSpecies) = 0.0;
+
+        // Abundances at the start of the evaluation, and the running ledger of every species the
+        // network has held; both survive re-culling so events and the output see one continuous state.
+        detail::AbundanceLedger initialLedger;
+        initialLedger.record(m_engine.getNetworkSpecies(), Y);
+        detail::AbundanceLedger ledger;
+
+        if (!state.isCompatibleWith(m_engine)) {
+            LOG_DEBUG(m_logger, "Solver state does not match the current network, resetting it.");
+            state.bind(m_engine);
+        }
+
+        std::optional<EventLocation> event;
+        double t = 0.0;
+        double dt = state.lastStepSize > 0.0 ? state.lastStepSize : netIn.dt0;
+
+        // --- Integrate in segments; each segment ends at tMax, an event, or a re-cull of the network ---
+        while (true) {
+            RHSFunctor rhsFunctor(m_engine, T9, netIn.density);
+            JacobianFunctor jacobianFunctor(m_engine, T9, netIn.density);
+            if (!state.rosenbrockController) {
+                state.rosenbrockController = std::make_unique<RosenbrockController>(absTol, relTol);
+            }
+
+            EventMonitor eventMonitor(m_events, m_engine, T9, netIn.density);
+            auto makeEventEndpoint = [&](const double tEndpoint, const ublas::vector<double>& x) -> EventStepEndpoint {
+                return eventMonitor.makeEndpoint(tEndpoint, std::vector<double>(x.begin(), x.begin() + numSpecies), x(numSpecies));
+            };
+            if (!eventMonitor.empty()) {
+                std::vector<double> Y0;
+                Y0.reserve(numSpecies);
+                for (const auto& species : m_engine.getNetworkSpecies()) {
+                    Y0.push_back(initialLedger.abundance(species));
+                }
+                eventMonitor.initialize(makeEventEndpoint(t, Y), std::move(Y0));
+            }
+
+            std::vector<double> referenceFlows;
+            if (recull) {
+                referenceFlows = m_engine.calculateAllMolarReactionFlows(std::vector<double>(Y.begin(), Y.begin() + numSpecies), T9, netIn.density);
+            }
+            size_t stepsSinceCheck = 0;
+            bool recullRequested = false;
+            double tStop = netIn.tMax;
+
+            stepCount += detail::integrateControlled(
+                *state.rosenbrockController,
+                std::make_pair(rhsFunctor, jacobianFunctor),
+                Y,
+                t,
+                netIn.tMax,
+                dt,
+                m_logger,
+                [&](const double tStep, const ublas::vector<double>& x) -> bool {
+                    if (!eventMonitor.empty()) {
+                        event = eventMonitor.checkStep(makeEventEndpoint(tStep, x));
+                        if (event.has_value()) {
+                            return true;
+                        }
+                    }
+                    if (recull && ++stepsSinceCheck >= static_cast<size_t>(recullInterval)) {
+                        stepsSinceCheck = 0;
+                        const auto flows = m_engine.calculateAllMolarReactionFlows(std::vector<double>(x.begin(), x.begin() + numSpecies), T9, netIn.density);
+                        const double drift = detail::relativeFlowDrift(referenceFlows, flows, FLOW_DRIFT_FLOOR);
+                        if (drift > recullFlowDrift && tStep < netIn.tMax) {
+                            LOG_DEBUG(m_logger, "Reaction flows drifted by {:0.2f} decades at t = {:0.3E} s, re-culling the network.", drift, tStep);
+                            recullRequested = true;
+                            tStop = tStep;
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+            );
+            if (event.has_value() || !recullRequested) {
+                break;
+            }
+
+            // --- Re-cull at the step boundary and remap the state onto the new network ---
+            t = tStop;
+            ledger.record(m_engine.getNetworkSpecies(), Y);
+            const double energy = Y(numSpecies);
+
+            std::vector<std::string> ledgerNames;
+            std::vector<double> ledgerMassFractions;
+            ledgerNames.reserve(ledger.species().size());
+            ledgerMassFractions.reserve(ledger.species().size());
+            for (size_t i = 0; i < ledger.species().size(); ++i) {
+                ledgerNames.push_back(std::string(ledger.species()[i].name()));
+                ledgerMassFractions.push_back(ledger.abundances()[i] * ledger.species()[i].mass());
+            }
+            NetIn recullIn = netIn;
+            recullIn.composition = fourdst::composition::Composition(ledgerNames);
+            recullIn.composition.setMassFraction(ledgerNames, ledgerMassFractions);
+            recullIn.composition.finalize(true);
+            m_engine.update(recullIn);
+
+            if (!state.isCompatibleWith(m_engine)) {
+                state.bind(m_engine);
+                numSpecies = m_engine.getNetworkSpecies().size();
+                Y.resize(numSpecies + 1, false);
+                for (size_t i = 0; i < numSpecies; ++i) {
+                    Y(i) = ledger.abundance(m_engine.getNetworkSpecies()[i]);
+                }
+                Y(numSpecies) = energy;
+                LOG_DEBUG(m_logger, "Network re-culled at t = {:0.3E} s; integrating {} species.", t, numSpecies);
+            }
+        }
+
+        if (event.has_value()) {
+            LOG_INFO(m_logger, "Event '{}' triggered at t = {:0.3E} s.", event->name, event->t);
+            std::ranges::copy(event->Y, Y.begin());
+            Y(numSpecies) = event->energy;
+        }
+        state.lastStepSize = dt;
+        state.T9 = T9;
+        state.rho = netIn.density;
+
+        // --- Species dropped by a re-cull keep their last abundance ---
+        ledger.record(m_engine.getNetworkSpecies(), Y);
+        const auto& outputSpecies = ledger.species();
+        std::vector<double> finalMassFractions(outputSpecies.size());
+        for (size_t i = 0; i < outputSpecies.size(); ++i) {
+            const double molarMass = outputSpecies[i].mass();
+            finalMassFractions[i] = ledger.abundances()[i] * molarMass; // Convert from molar abundance to mass fraction
+            if (finalMassFractions[i] < MIN_ABUNDANCE_THRESHOLD) {
+                finalMassFractions[i] = 0.0;
+            }
+        }
+
+        std::vector<std::string> speciesNames;
+        speciesNames.reserve(outputSpecies.size());
+        for (const auto& species : outputSpecies) {
+            speciesNames.push_back(std::string(species.name()));
+        }
+
+        Composition outputComposition(speciesNames);
+        outputComposition.setMassFraction(speciesNames, finalMassFractions);
+        outputComposition.finalize(true);
+
+        NetOut netOut;
+        netOut.composition = std::move(outputComposition);
+        netOut.energy = Y(numSpecies); // Specific energy rate
+        netOut.num_steps = stepCount;
+        netOut.time = event.has_value() ? event->t : netIn.tMax;
+        netOut.triggeredEvent = event.has_value() ? event->name : "";
+
+        return netOut;
+    }
+
+    template <SolverEngineType EngineT>
+    void BasicDirectNetworkSolver<EngineT>::RHSFunctor::operator()(
+        const boost::numeric::ublas::vector<double> &Y,
+        boost::numeric::ublas::vector<double> &dYdt,
+        double t
+    ) const {
+        const std::vector<double> y(Y.begin(), m_numSpecies + Y.begin());
+
+        // std::string timescales = utils::formatNuclearTimescaleLogString(
+        //     m_engine,
+        //     y,
+        //     m_T9,
+        //     m_rho
+        // );
+        // LOG_TRACE_L2(m_logger, "{}", timescales);
+
+        auto [dydt, eps] = m_engine.calculateRHSAndEnergy(y, m_T9, m_rho);
+        dYdt.resize(m_numSpecies + 1);
+        std::ranges::copy(dydt, dYdt.begin());
+        dYdt(m_numSpecies) = eps;
+    }
+
+    template <SolverEngineType EngineT>
+    void BasicDirectNetworkSolver<EngineT>::JacobianFunctor::operator()(
+        const boost::numeric::ublas::vector<double> &Y,
+        boost::numeric::ublas::matrix<double> &J,
+        double t,
+        boost::numeric::ublas::vector<double> &dfdt
+    ) const {
+        J.resize(m_numSpecies+1, m_numSpecies+1);
+        J.clear();
+        for (int i = 0; i < m_numSpecies; ++i) {
+            for (int j = 0; j < m_numSpecies; ++j) {
+                J(i, j) = m_engine.getJacobianMatrixEntry(i, j);
+            }
+        }
+    }
+
+    // --- Instantiated in the library: dynamic dispatch, and static dispatch on each final engine type ---
+    extern template class BasicDirectNetworkSolver<DynamicEngine>;
+    extern template class BasicDirectNetworkSolver<GraphEngine>;
+    extern template class BasicDirectNetworkSolver<AdaptiveEngineView>;
+    extern template class BasicDirectNetworkSolver<FileDefinedEngineView>;
+    extern template class BasicDirectNetworkSolver<FusedEngineView>;
+    extern template class BasicDirectNetworkSolver<DRGEPEngineView>;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "gridfire/solver/solver.h"
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/logging/logging.h"
+#include "fourdst/config/config.h"
+
+#include "quill/Logger.h"
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @file solver_batched.h
+ * @brief Explicit solver strategy which advances many zones in lockstep.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @class BatchedExplicitNetworkSolver
+     * @brief Dormand-Prince 5(4) solver which integrates many independent zones simultaneously.
+     *
+     * This solver is intended for regions (e.g. cool zones of a stellar model) where the network is
+     * not stiff and an explicit method is efficient. Rather than integrating one zone at a time,
+     * all zones are advanced in lockstep: every Runge-Kutta stage is a single sweep over all zones
+     * and every right-hand side evaluation is a single call to Engine::calculateRHSAndEnergyBatch().
+     *
+     * The state is stored species-major with the zone index varying fastest (Y[i * numZones + z]) so
+     * that the stage updates, the error norm, and engines providing a batched kernel vectorize across
+     * zones. Each zone keeps its own time, step size and error control; zones which have reached their
+     * end time, or whose step was rejected, are masked rather than removed from the batch.
+     *
+     * The specific energy is integrated with the same Runge-Kutta weights as the abundances but is not
+     * included in the error norm, since it does not feed back into the abundance evolution.
+     *
+     * The following configuration keys are read (with defaults):
+     *   - `gridfire:solver:BatchedExplicitNetworkSolver:absTol` (1e-8)
+     *   - `gridfire:solver:BatchedExplicitNetworkSolver:relTol` (1e-8)
+     *   - `gridfire:solver:BatchedExplicitNetworkSolver:maxSteps` (1e6), per zone
+     *
+     * @implements StaticNetworkSolverStrategy
+     *
+     * @par Usage Example:
+     * @code
+     * GraphEngine engine(composition);
+     * BatchedExplicitNetworkSolver solver(engine);
+     * std::vector<NetIn> zones = ...; // one NetIn per zone
+     * std::vector<NetOut> results = solver.evaluate(zones);
+     * @endcode
+     */
+    class BatchedExplicitNetworkSolver final : public StaticNetworkSolverStrategy {
+    public:
+        /**
+         * @brief Constructor for the BatchedExplicitNetworkSolver.
+         * @param engine The engine to use for evaluating the network.
+         */
+        using StaticNetworkSolverStrategy::StaticNetworkSolverStrategy;
+        using StaticNetworkSolverStrategy::evaluate;
+
+        /**
+         * @brief Evaluates the network for a single zone.
+         * @param netIn The input conditions for the network.
+         * @return The output conditions after the timestep.
+         *
+         * This is equivalent to evaluating a batch containing only `netIn`.
+         */
+        NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the network for a batch of independent zones.
+         * @param netIns The input conditions for each zone. Zones may have different temperatures,
+         *               densities, compositions, end times and initial step sizes.
+         * @return The output conditions of each zone, in the same order as `netIns`.
+         *
+         * @throws std::runtime_error If any zone exceeds the maximum number of steps or its step size underflows.
+         */
+        std::vector<NetOut> evaluate(const std::vector<NetIn>& netIns);
+    private:
+        quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
+        fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
+    };
+}
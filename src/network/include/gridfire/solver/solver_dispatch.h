@@ -0,0 +1,162 @@
+#pragma once
+
+#include "gridfire/solver/solver.h"
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/logging/logging.h"
+#include "fourdst/config/config.h"
+
+#include "quill/Logger.h"
+
+#include <vector>
+
+/**
+ * @file solver_dispatch.h
+ * @brief Solver strategy which chooses between an explicit and an implicit integrator per zone.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @class StiffnessDispatchNetworkSolver
+     * @brief A network solver which detects stiffness and routes each zone to an explicit or implicit method.
+     *
+     * Rather than relying on a manual stiffness flag (as `Network::isStiff()` does), this strategy estimates
+     * the spectral radius \f$\rho(J)\f$ of the Jacobian with a few power iterations. Each iteration needs only
+     * one extra right-hand side evaluation, because the Jacobian-vector products are approximated by finite
+     * differences, so the Jacobian is never assembled for zones that turn out to be non-stiff.
+     *
+     * The explicit Dormand-Prince 5(4) method is stable for \f$\rho h\f$ up to about 3.3. Over the remaining
+     * interval \f$\Delta t\f$ it therefore needs at least \f$n_{stab} = \rho \Delta t / 3.3\f$ steps no matter
+     * how smooth the solution is.
+     *   - At the start of a cold evaluation, the zone is integrated implicitly (Rosenbrock 4) if
+     *     \f$n_{stab}\f$ exceeds `maxExplicitStabilitySteps`, and explicitly otherwise.
+     *   - Every `checkInterval` accepted steps, \f$\rho\f$ is re-estimated (warm starting the power iteration).
+     *     An explicit integration switches to implicit once its steps are limited by stability
+     *     (\f$\rho h \ge 0.9 \times 3.3\f$) and \f$n_{stab}\f$ is large. An implicit integration switches back
+     *     once its step would be stable for the explicit method by a margin of `hysteresis`, or
+     *     \f$n_{stab}\f$ has dropped below the threshold by the same margin.
+     *
+     * When used with a SolverState, the last mode and the power iteration vector are carried between calls,
+     * so a zone which was stiff stays on the implicit path without a fresh decision.
+     *
+     * The dispatcher reaches its engine through the DynamicEngine interface. It is not templated on the
+     * engine type like BasicDirectNetworkSolver, so it cannot be built on a statically dispatched engine,
+     * and a statically dispatched solver such as `BasicDirectNetworkSolver<GraphEngine>` is not a
+     * DynamicNetworkSolverStrategy and cannot be used where one is expected (e.g. as the fallback of
+     * NSEDispatchNetworkSolver). Use DirectNetworkSolver there.
+     *
+     * The following configuration keys are read (with defaults):
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:absTol` (1e-8)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:relTol` (1e-8)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:stabilityLimit` (3.3)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:maxExplicitStabilitySteps` (50)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:checkInterval` (25)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:hysteresis` (2.0)
+     *   - `gridfire:solver:StiffnessDispatchNetworkSolver:powerIterations` (8)
+     *
+     * @implements DynamicNetworkSolverStrategy
+     */
+    class StiffnessDispatchNetworkSolver final : public DynamicNetworkSolverStrategy {
+    public:
+        /**
+         * @brief Constructor for the StiffnessDispatchNetworkSolver.
+         * @param engine The dynamic engine to use for evaluating the network.
+         */
+        using DynamicNetworkSolverStrategy::DynamicNetworkSolverStrategy;
+
+        /**
+         * @brief Evaluates the network, choosing the integrator from the estimated stiffness.
+         * @param netIn The input conditions for the network.
+         * @return The output conditions after the timestep.
+         */
+        NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the network, warm starting the stiffness decision from a persistent state.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state.
+         * @return The output conditions after the timestep.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
+
+        /**
+         * @brief Estimates the spectral radius of the Jacobian with matrix-free power iteration.
+         * @param Y Current molar abundances.
+         * @param dydt Derivatives at `Y`.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @param v On input, the starting vector (may be empty). On output, the last iterate, which can be
+         *          passed back in to warm start the next estimate.
+         * @param maxIterations Maximum number of power iterations.
+         * @return The estimated spectral radius in s^-1.
+         *
+         * Jacobian-vector products are approximated by the forward difference
+         * \f$Jv \approx (f(Y + \epsilon v) - f(Y)) / \epsilon\f$. The result is a lower bound on the spectral
+         * radius that converges quickly for the well separated, real, negative eigenvalues typical of
+         * stiff reaction networks.
+         */
+        [[nodiscard]] double estimateSpectralRadius(
+            const std::vector<double>& Y,
+            const std::vector<double>& dydt,
+            double T9,
+            double rho,
+            std::vector<double>& v,
+            int maxIterations
+        ) const;
+    private: // types
+        /**
+         * @struct RHSFunctor
+         * @brief Functor for calculating the right-hand side of the ODEs, shared by both integrators.
+         */
+        struct RHSFunctor {
+            DynamicEngine& m_engine; ///< The engine used to evaluate the network.
+            const double m_T9; ///< Temperature in units of 10^9 K.
+            const double m_rho; ///< Density in g/cm^3.
+            const size_t m_numSpecies; ///< The number of species in the network.
+
+            RHSFunctor(DynamicEngine& engine, const double T9, const double rho) :
+            m_engine(engine),
+            m_T9(T9),
+            m_rho(rho),
+            m_numSpecies(engine.getNetworkSpecies().size()) {}
+
+            void operator()(
+                const boost::numeric::ublas::vector<double>& Y,
+                boost::numeric::ublas::vector<double>& dYdt,
+                double t
+            ) const;
+        };
+
+        /**
+         * @struct JacobianFunctor
+         * @brief Functor which regenerates the engine Jacobian and copies it into the Rosenbrock matrix.
+         */
+        struct JacobianFunctor {
+            DynamicEngine& m_engine; ///< The engine used to evaluate the network.
+            const double m_T9; ///< Temperature in units of 10^9 K.
+            const double m_rho; ///< Density in g/cm^3.
+            const size_t m_numSpecies; ///< The number of species in the network.
+
+            JacobianFunctor(DynamicEngine& engine, const double T9, const double rho) :
+            m_engine(engine),
+            m_T9(T9),
+            m_rho(rho),
+            m_numSpecies(engine.getNetworkSpecies().size()) {}
+
+            void operator()(
+                const boost::numeric::ublas::vector<double>& Y,
+                boost::numeric::ublas::matrix<double>& J,
+                double t,
+                boost::numeric::ublas::vector<double>& dfdt
+            ) const;
+        };
+    private:
+        quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
+        fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
+    };
+}
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "gridfire/engine/engine_abstract.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <optional>
+
+/**
+ * @file solver_events.h
+ * @brief Events which stop a network integration early, and the machinery used to locate them.
+ *
+ * An event is a scalar function \f$g(t, Y)\f$ of the network state. The event fires when \f$g\f$ crosses
+ * zero from below during an accepted step; the crossing time is then located on the dense output of the
+ * step and the solver returns the state at that time instead of integrating on to `NetIn::tMax`.
+ * Events whose function is already non-negative at the start of an evaluation only fire on a subsequent
+ * upward crossing.
+ *
+ * @par Usage Example:
+ * @code
+ * DirectNetworkSolver solver(engine);
+ * solver.addEvent(events::massFractionBelow("H-1", 1.0e-4));
+ * solver.addEvent(events::energyGenerationAbove(1.0e10));
+ * NetOut out = solver.evaluate(netIn);
+ * if (!out.triggeredEvent.empty()) {
+ *     std::cout << out.triggeredEvent << " at t = " << out.time << " s\n";
+ * }
+ * @endcode
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @struct EventContext
+     * @brief The network state handed to an event function.
+     */
+    struct EventContext {
+        double t; ///< Time since the start of the evaluation (s).
+        const std::vector<double>& Y; ///< Current molar abundances.
+        const std::vector<double>& Y0; ///< Molar abundances at the start of the evaluation.
+        double nuclearEnergyGenerationRate; ///< Current specific energy generation rate (erg/g/s).
+        const std::vector<fourdst::atomic::Species>& species; ///< Species corresponding to the entries of Y.
+    };
+
+    /**
+     * @struct SolverEvent
+     * @brief A named event function.
+     */
+    struct SolverEvent {
+        std::string name; ///< Name reported in NetOut::triggeredEvent.
+        std::function<double(const EventContext&)> condition; ///< g(t, Y); the event fires when g crosses zero from below.
+    };
+
+    namespace events {
+        /**
+         * @brief Event which fires when the mass fraction of a species drops below a threshold.
+         * @param speciesName Name of the species (e.g. "H-1").
+         * @param threshold Mass fraction threshold.
+         * @return The event. If the species is not part of the network the event never fires.
+         */
+        SolverEvent massFractionBelow(const std::string& speciesName, double threshold);
+
+        /**
+         * @brief Event which fires when the specific nuclear energy generation rate exceeds a value.
+         * @param threshold Energy generation rate threshold (erg/g/s).
+         * @return The event.
+         */
+        SolverEvent energyGenerationAbove(double threshold);
+
+        /**
+         * @brief Event which fires when any abundance changes by more than a relative amount.
+         * @param relativeChange Relative change (e.g. 0.1 for 10%) measured against the abundance at the start of the evaluation.
+         * @param abundanceFloor Species whose initial molar abundance is below this floor are ignored, since any production would be an unbounded relative change.
+         * @return The event.
+         */
+        SolverEvent abundanceChangeExceeds(double relativeChange, double abundanceFloor = 1.0e-10);
+    }
+
+    /**
+     * @struct EventStepEndpoint
+     * @brief State at one end of an accepted step, as needed for cubic Hermite dense output.
+     */
+    struct EventStepEndpoint {
+        double t = 0.0; ///< Time (s).
+        std::vector<double> Y; ///< Molar abundances.
+        std::vector<double> dydt; ///< Derivatives of the molar abundances.
+        double energy = 0.0; ///< Specific energy released since the start of the evaluation (erg/g).
+        double nuclearEnergyGenerationRate = 0.0; ///< Specific energy generation rate (erg/g/s), the derivative of `energy`.
+    };
+
+    /**
+     * @struct EventLocation
+     * @brief Result of a located event.
+     */
+    struct EventLocation {
+        size_t eventIndex; ///< Index of the event that fired.
+        std::string name; ///< Name of the event that fired.
+        double t; ///< Located event time (s).
+        std::vector<double> Y; ///< Molar abundances at the event time.
+        double energy; ///< Specific energy released up to the event time (erg/g).
+    };
+
+    /**
+     * @class EventMonitor
+     * @brief Tracks a set of events over the accepted steps of an integration and locates crossings.
+     *
+     * The solver feeds every accepted step endpoint to checkStep(). The monitor evaluates all event
+     * functions at the new endpoint and compares against the previous one. If any function crossed zero
+     * from below, the crossing is located with the Illinois variant of regula falsi on the cubic Hermite
+     * interpolant built from the two endpoints and their derivatives, and the earliest crossing is returned.
+     *
+     * Because the Hermite interpolant only needs endpoint values and derivatives, the same monitor works
+     * for every solver strategy regardless of whether its stepper exposes dense output.
+     */
+    class EventMonitor {
+    public:
+        /**
+         * @brief Constructs a monitor.
+         * @param events The events to monitor.
+         * @param engine The engine, used to evaluate the energy generation rate at interpolated states.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         */
+        EventMonitor(
+            const std::vector<SolverEvent>& events,
+            const Engine& engine,
+            double T9,
+            double rho
+        );
+
+        /**
+         * @brief Whether there are any events to monitor. Solvers can skip all event bookkeeping if not.
+         */
+        [[nodiscard]] bool empty() const { return m_events.empty(); }
+
+        /**
+         * @brief Records the state at the start of the evaluation.
+         * @param start The initial endpoint.
+         */
+        void initialize(const EventStepEndpoint& start);
+
+        /**
+         * @brief Restarts monitoring mid-evaluation, e.g. after the network was re-culled.
+         * @param start The endpoint monitoring restarts from.
+         * @param Y0 Molar abundances at the start of the evaluation, in the order of `start.Y`.
+         */
+        void initialize(const EventStepEndpoint& start, std::vector<double> Y0);
+
+        /**
+         * @brief Checks the step from the previously recorded endpoint to `end`.
+         * @param end The endpoint of the accepted step.
+         * @return The earliest located event in the step, or std::nullopt if no event fired.
+         *
+         * If no event fired, `end` becomes the start of the next step.
+         */
+        std::optional<EventLocation> checkStep(const EventStepEndpoint& end);
+
+        /**
+         * @brief Builds an endpoint, evaluating the derivatives with the engine.
+         * @param t Time (s).
+         * @param Y Molar abundances.
+         * @param energy Specific energy released since the start of the evaluation (erg/g).
+         * @return The endpoint.
+         */
+        [[nodiscard]] EventStepEndpoint makeEndpoint(
+            double t,
+            std::vector<double> Y,
+            double energy
+        ) const;
+    private:
+        const std::vector<SolverEvent>& m_events; ///< Monitored events.
+        const Engine& m_engine; ///< Engine used to evaluate interpolated energy generation rates.
+        const double m_T9; ///< Temperature in units of 10^9 K.
+        const double m_rho; ///< Density in g/cm^3.
+
+        std::vector<double> m_Y0; ///< Abundances at the start of the evaluation.
+        EventStepEndpoint m_previous; ///< Start of the current step.
+        std::vector<double> m_previousValues; ///< Event function values at m_previous.
+    private:
+        [[nodiscard]] double evaluateCondition(
+            size_t eventIndex,
+            double t,
+            const std::vector<double>& Y,
+            double nuclearEnergyGenerationRate
+        ) const;
+
+        void interpolate(
+            const EventStepEndpoint& end,
+            double t,
+            std::vector<double>& Y,
+            double& energy
+        ) const;
+    };
+}
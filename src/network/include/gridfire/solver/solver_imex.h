@@ -0,0 +1,214 @@
+#pragma once
+
+#include "gridfire/solver/solver.h"
+#include "gridfire/solver/block_triangular.h"
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/logging/logging.h"
+#include "fourdst/config/config.h"
+
+#include "quill/Logger.h"
+
+#include "Eigen/SparseCore"
+#include "Eigen/SparseLU"
+
+#include <vector>
+
+/**
+ * @file solver_imex.h
+ * @brief Implicit-explicit (IMEX) Runge-Kutta solver strategy.
+ *
+ * The IMEX strategy splits the network species by their characteristic timescale. Species
+ * which evolve faster than the current step would allow an explicit method to remain stable
+ * are advanced implicitly, while the remaining (slow) species are advanced explicitly. Only the
+ * fast block of the Jacobian is ever factorized, which for typical networks (a handful of stiff
+ * light species and many slowly evolving heavy species) is much smaller than the full system.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @struct IMEXImplicitSystem
+     * @brief Workspace for the Newton iterations over the implicit (fast) species of the IMEXNetworkSolver.
+     *
+     * Holds the fast-fast block of the Jacobian and its sparse LU factorization of
+     * \f$I - h\gamma J_{ff}\f$. The factorization is only recomputed when the Jacobian block or the
+     * partition changes, or when the product \f$h\gamma\f$ moves too far from the value it was computed at. When the engine's Jacobian block ordering
+     * splits the fast species into more than one block, the matrix is factorized block by block
+     * instead (see BlockTriangularLU).
+     */
+    struct IMEXImplicitSystem {
+        Eigen::SparseMatrix<double> jacobian; ///< Fast-fast block of the engine Jacobian.
+        Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> lu; ///< Factorization of I - hγJ_ff.
+        BlockTriangularLU blockLU; ///< Block triangular factorization of I - hγJ_ff, used instead of `lu` if `useBlockLU`.
+        bool useBlockLU = false; ///< Whether the fast species split into several Jacobian blocks.
+        double factoredHGamma = 0.0; ///< The value of hγ used for the current factorization.
+        bool jacobianValid = false; ///< Whether `jacobian` matches the current partition.
+        bool factorizationValid = false; ///< Whether `lu` is consistent with `jacobian` and `factoredHGamma`.
+    };
+
+    /**
+     * @class IMEXNetworkSolver
+     * @brief A network solver which treats fast species implicitly and slow species explicitly.
+     *
+     * Time integration uses the second order, stiffly accurate ARS(2,2,2) additive Runge-Kutta
+     * scheme of Ascher, Ruuth & Spiteri (1997). The right-hand side is split by species: the
+     * implicit part contains the derivatives of the fast species and the explicit part contains
+     * the derivatives of the slow species. Each implicit stage therefore only requires a Newton
+     * solve over the fast species, using the sub-block J_ff of the engine Jacobian.
+     *
+     * The partition is recomputed at the start of every step from the timescales
+     * \f$\tau_i = |Y_i / \dot{Y}_i|\f$, which are obtained for free from the first stage of the
+     * scheme. A species is moved to the implicit set when \f$\tau_i < \kappa h\f$ and is only
+     * returned to the explicit set once \f$\tau_i > \kappa h H\f$, where \f$H\f$ is a hysteresis
+     * factor. This prevents species near the threshold from flapping between the two sets.
+     *
+     * Step size control uses the embedded first order solution given by the weights
+     * \f$\hat{b}_E = (1, 0, 0)\f$ and \f$\hat{b}_I = (0, 0, 1)\f$.
+     *
+     * The following configuration keys are read (with defaults):
+     *   - `gridfire:solver:IMEXNetworkSolver:absTol` (1e-8)
+     *   - `gridfire:solver:IMEXNetworkSolver:relTol` (1e-8)
+     *   - `gridfire:solver:IMEXNetworkSolver:stiffnessFactor` (1.0), \f$\kappa\f$ above
+     *   - `gridfire:solver:IMEXNetworkSolver:hysteresis` (2.0), \f$H\f$ above
+     *   - `gridfire:solver:IMEXNetworkSolver:jacobianInterval` (10), accepted steps between Jacobian refreshes
+     *   - `gridfire:solver:IMEXNetworkSolver:factorizationReuseTolerance` (0.2), largest relative change of
+     *     \f$h\gamma\f$ for which the factorization of \f$I - h\gamma J_{ff}\f$ is reused
+     *   - `gridfire:solver:IMEXNetworkSolver:newton:maxIterations` (8)
+     *   - `gridfire:solver:IMEXNetworkSolver:newton:tolerance` (1e-2), in units of the weighted error norm
+     *   - `gridfire:solver:IMEXNetworkSolver:maxSteps` (1e7)
+     *
+     * @implements DynamicNetworkSolverStrategy
+     *
+     * @see QSENetworkSolver for an algebraic (rather than implicit) treatment of the fast species.
+     */
+    class IMEXNetworkSolver final : public DynamicNetworkSolverStrategy {
+    public:
+        /**
+         * @brief Constructor for the IMEXNetworkSolver.
+         * @param engine The dynamic engine to use for evaluating the network.
+         */
+        using DynamicNetworkSolverStrategy::DynamicNetworkSolverStrategy;
+
+        /**
+         * @brief Evaluates the network for a given timestep using the IMEX scheme.
+         * @param netIn The input conditions for the network.
+         * @return The output conditions after the timestep.
+         *
+         * @throws std::runtime_error If the maximum number of steps is exceeded or if the step size
+         *         underflows after repeated Newton failures.
+         */
+        NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the network using the IMEX scheme, warm starting from a persistent state.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state.
+         * @return The output conditions after the timestep.
+         *
+         * The previous partition (and therefore its hysteresis), the last proposed step size, and the
+         * fast block Jacobian with its factorization are carried over. The Jacobian is only reused if
+         * temperature and density changed by less than
+         * `gridfire:solver:IMEXNetworkSolver:jacobianReuseTolerance` (0.01, relative) since the last call.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
+    private: // types
+        /**
+         * @struct IntegrationControls
+         * @brief Tolerances and tuning parameters read from the configuration once per evaluation.
+         */
+        struct IntegrationControls {
+            double absTol; ///< Absolute tolerance on the molar abundances.
+            double relTol; ///< Relative tolerance on the molar abundances.
+            double stiffnessFactor; ///< Species with τ < stiffnessFactor * h are treated implicitly.
+            double hysteresis; ///< Implicit species return to the explicit set only once τ > stiffnessFactor * h * hysteresis.
+            int newtonMaxIterations; ///< Maximum number of Newton iterations per implicit stage.
+            double newtonTolerance; ///< Convergence threshold on the weighted norm of the Newton update.
+            bool blockTriangular; ///< Whether to factorize the implicit system by Jacobian blocks when it splits into several.
+            double factorizationReuseTolerance; ///< Largest relative change of hγ for which the factorization is reused.
+        };
+    private: // methods
+        /**
+         * @brief Partitions the species into implicit and explicit sets.
+         * @param Y Current molar abundances.
+         * @param dydt Current derivatives of the molar abundances.
+         * @param h The step size about to be attempted.
+         * @param previous The partition used for the previous step (used for hysteresis).
+         * @param controls Integration controls providing the stiffness factor, hysteresis and abundance floor.
+         * @return The new partition.
+         */
+        [[nodiscard]] static IMEXSpeciesPartition partitionSpecies(
+            const std::vector<double>& Y,
+            const std::vector<double>& dydt,
+            double h,
+            const IMEXSpeciesPartition& previous,
+            const IntegrationControls& controls
+        );
+
+        /**
+         * @brief Copies the fast-fast block of the engine's current Jacobian into the implicit system.
+         * @param partition The current species partition.
+         * @param controls Selects whether the block triangular factorization may be used.
+         * @param system The implicit system to populate.
+         *
+         * Also restricts the engine's Jacobian block ordering to the fast species.
+         *
+         * @pre `generateJacobianMatrix()` has been called on the engine.
+         */
+        void loadImplicitJacobian(
+            const IMEXSpeciesPartition& partition,
+            const IntegrationControls& controls,
+            IMEXImplicitSystem& system
+        ) const;
+
+        /**
+         * @brief Factorizes \f$I - h\gamma J_{ff}\f$ if the current factorization is out of date.
+         * @param hGamma The product of the step size and the diagonal coefficient of the implicit tableau.
+         * @param reuseTolerance Largest relative change of hγ since the last factorization for which it is kept.
+         * @param system The implicit system to factorize.
+         * @return True if the factorization succeeded.
+         *
+         * Under adaptive stepping hγ changes on almost every step. The Newton iteration only needs an
+         * approximation of the iteration matrix, so a factorization at a nearby hγ is kept; if the
+         * iteration then fails the caller invalidates the factorization and retries.
+         */
+        static bool factorizeImplicitSystem(
+            double hGamma,
+            double reuseTolerance,
+            IMEXImplicitSystem& system
+        );
+
+        /**
+         * @brief Solves one implicit stage of the IMEX scheme with a simplified Newton iteration.
+         * @param Ystage On input, the explicit species hold their (already known) stage values and the
+         *               implicit species hold the initial guess. On output, the stage solution.
+         * @param fastConstant The known part of the implicit stage equation for each implicit species.
+         * @param hGamma The product of the step size and the diagonal coefficient of the implicit tableau.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @param partition The current species partition.
+         * @param controls Newton iteration limits and the tolerances used to weight the update norm.
+         * @param system The (factorized) implicit system.
+         * @param stageDerivatives On output, the derivatives evaluated at the stage solution.
+         * @return True if the Newton iteration converged.
+         */
+        bool solveImplicitStage(
+            std::vector<double>& Ystage,
+            const std::vector<double>& fastConstant,
+            double hGamma,
+            double T9,
+            double rho,
+            const IMEXSpeciesPartition& partition,
+            const IntegrationControls& controls,
+            IMEXImplicitSystem& system,
+            StepDerivatives<double>& stageDerivatives
+        ) const;
+    private:
+        quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
+        fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
+    };
+}
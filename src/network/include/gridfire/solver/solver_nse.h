@@ -0,0 +1,217 @@
+#pragma once
+
+#include "gridfire/solver/solver.h"
+#include "gridfire/engine/engine_abstract.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/logging/logging.h"
+#include "fourdst/config/config.h"
+
+#include "quill/Logger.h"
+
+#include <vector>
+#include <functional>
+
+/**
+ * @file solver_nse.h
+ * @brief Nuclear statistical equilibrium (NSE) solver strategy and a temperature based dispatcher.
+ *
+ * Above \f$T_9 \approx 5\f$ strong and electromagnetic reactions are fast enough that the abundances
+ * relax to NSE, which depends only on \f$(T, \rho, Y_e)\f$. Integrating the full network there is
+ * wasteful: the NSE composition can be found by solving for just two unknowns.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::solver {
+
+    /**
+     * @class NSENetworkSolver
+     * @brief A network "solver" which returns the NSE composition over the engine species.
+     *
+     * In NSE the abundance of every nucleus follows from the free proton and neutron abundances
+     * through the Saha equation,
+     * \f[
+     *   Y_i = G_i(T)\, A_i^{3/2}\, 2^{-A_i} \left(\frac{\rho N_A}{n_Q}\right)^{A_i - 1}
+     *         Y_p^{Z_i}\, Y_n^{N_i}\, \exp\left(\frac{B_i}{kT}\right),
+     *   \qquad n_Q = \left(\frac{m_u k T}{2\pi\hbar^2}\right)^{3/2},
+     * \f]
+     * where \f$B_i\f$ is the binding energy, computed from the species masses. \f$\ln Y_p\f$ and
+     * \f$\ln Y_n\f$ are found with a damped two dimensional Newton iteration on the logarithms of the
+     * mass and charge conservation constraints,
+     * \f$\sum_i A_i Y_i = 1\f$ and \f$\sum_i Z_i Y_i = Y_e\f$, with \f$Y_e\f$ taken from the input
+     * composition. Sums are evaluated with a shifted exponent so that iterates far from the solution
+     * do not overflow.
+     *
+     * The engines carry no nuclear partition functions, so by default \f$G_i\f$ is the ground state
+     * statistical weight of even-even nuclei (1), except for free nucleons (2). A better partition
+     * function can be supplied with setPartitionFunction().
+     *
+     * The composition is returned at NetIn::tMax; weak reactions are not followed, so \f$Y_e\f$ is
+     * conserved. NetOut::energy is the binding energy released by the rearrangement to NSE. Events
+     * are not monitored since there is no time integration. When used with a SolverState, the
+     * nucleon abundances of the previous solve are used as the initial guess.
+     *
+     * The NSE distribution only covers the species of the engine it is given. Pass the GraphEngine
+     * rather than a culled view, since the species a view drops at low temperature (e.g. the iron
+     * group) are the ones which dominate in NSE.
+     *
+     * The following configuration keys are read (with defaults):
+     *   - `gridfire:solver:NSENetworkSolver:maxIterations` (100)
+     *   - `gridfire:solver:NSENetworkSolver:tolerance` (1e-10), on the logarithmic constraint residuals
+     *
+     * @implements DynamicNetworkSolverStrategy
+     */
+    class NSENetworkSolver final : public DynamicNetworkSolverStrategy {
+    public:
+        /**
+         * @brief Partition function \f$G_i(T_9)\f$ of a species.
+         */
+        using PartitionFunction = std::function<double(const fourdst::atomic::Species&, double)>;
+
+        /**
+         * @brief Constructor for the NSENetworkSolver.
+         * @param engine The dynamic engine whose species list defines the NSE distribution.
+         */
+        using DynamicNetworkSolverStrategy::DynamicNetworkSolverStrategy;
+
+        /**
+         * @brief Computes the NSE composition at the input conditions.
+         * @param netIn The input conditions for the network.
+         * @return The NSE composition and the energy released.
+         * @throws std::runtime_error If the Newton iteration does not converge.
+         */
+        NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Computes the NSE composition, warm starting from the nucleon abundances of the previous call.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state.
+         * @return The NSE composition and the energy released.
+         * @throws std::runtime_error If the Newton iteration does not converge.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
+
+        /**
+         * @brief Replaces the partition function used in the Saha equation.
+         * @param partitionFunction Function returning \f$G_i\f$ for a species at a temperature in units of 10^9 K.
+         */
+        void setPartitionFunction(PartitionFunction partitionFunction);
+
+        /**
+         * @brief Estimates the timescale on which a zone relaxes to NSE.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @return The relaxation timescale in s, \f$\tau_{NSE} \approx \rho^{0.2} \exp(179.7 / T_9 - 40.5)\f$
+         *         (Khokhlov 1991).
+         */
+        [[nodiscard]] static double equilibrationTimescale(double T9, double rho);
+
+        /**
+         * @brief Binding energy \f$B_i\f$ of a species in MeV, computed from its mass.
+         * @param species The species.
+         * @return The binding energy in MeV; zero for the free nucleons.
+         */
+        [[nodiscard]] static double bindingEnergy(const fourdst::atomic::Species& species);
+
+        /**
+         * @brief Default partition function: the ground state weight, 2 for free nucleons and 1 otherwise.
+         * @param species The species.
+         * @param T9 Temperature in units of 10^9 K (unused).
+         * @return The statistical weight \f$G_i\f$.
+         */
+        [[nodiscard]] static double groundStatePartitionFunction(const fourdst::atomic::Species& species, double T9);
+
+        /**
+         * @brief The part of \f$\ln Y_i\f$ in the Saha equation that does not depend on \f$Y_p\f$ and \f$Y_n\f$.
+         * @param species The species.
+         * @param T9 Temperature in units of 10^9 K.
+         * @param rho Density in g/cm^3.
+         * @param G Partition function of the species at T9.
+         * @return \f$\ln Y_i - Z_i \ln Y_p - N_i \ln Y_n\f$ in equilibrium.
+         *
+         * The difference of two such offsets gives the equilibrium ratio of two nuclei at fixed
+         * nucleon abundances, which the QSENetworkSolver uses to parametrize its equilibrium clusters.
+         */
+        [[nodiscard]] static double sahaLogOffset(const fourdst::atomic::Species& species, double T9, double rho, double G);
+    private:
+        quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
+        fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
+
+        PartitionFunction m_partitionFunction; ///< User supplied partition function; the ground state weights are used if empty.
+    };
+
+    /**
+     * @class NSEDispatchNetworkSolver
+     * @brief Routes each zone either to an NSENetworkSolver or to a network integrating fallback solver.
+     *
+     * A zone is switched into NSE when \f$T_9 \ge\f$ `enterT9` and the NSE relaxation timescale
+     * (NSENetworkSolver::equilibrationTimescale()) is shorter than `equilibrationFraction` times the
+     * requested timestep, i.e. the zone would reach NSE within the step anyway. It is switched back
+     * to the fallback solver once \f$T_9 <\f$ `exitT9` or the relaxation timescale exceeds the timestep
+     * by more than `exitTimescaleFactor`. The gap between the entry and exit criteria keeps zones near
+     * the threshold from switching back and forth. The mode of the last call is kept in the
+     * SolverState.
+     *
+     * Events are only monitored by the fallback solver; add them there.
+     *
+     * The following configuration keys are read (with defaults):
+     *   - `gridfire:solver:NSEDispatchNetworkSolver:enterT9` (5.0)
+     *   - `gridfire:solver:NSEDispatchNetworkSolver:exitT9` (4.5)
+     *   - `gridfire:solver:NSEDispatchNetworkSolver:equilibrationFraction` (0.1)
+     *   - `gridfire:solver:NSEDispatchNetworkSolver:exitTimescaleFactor` (10.0)
+     *
+     * @par Usage Example:
+     * @code
+     * GraphEngine graph(composition);
+     * AdaptiveEngineView adaptiveEngine(graph);
+     * QSENetworkSolver network(adaptiveEngine);
+     * // The NSE distribution is taken over the full GraphEngine species list, not the culled view
+     * NSEDispatchNetworkSolver solver(graph, network);
+     * NetOut out = solver.evaluate(netIn, zoneState);
+     * @endcode
+     *
+     * @implements DynamicNetworkSolverStrategy
+     */
+    class NSEDispatchNetworkSolver final : public DynamicNetworkSolverStrategy {
+    public:
+        /**
+         * @brief Constructor for the NSEDispatchNetworkSolver.
+         * @param engine The dynamic engine used by the NSE solver, normally the GraphEngine underneath the
+         *               fallback solver's engine.
+         * @param fallbackSolver The solver used outside NSE. It must outlive the dispatcher. Statically
+         *                       dispatched solvers (e.g. `BasicDirectNetworkSolver<GraphEngine>`) are not
+         *                       DynamicNetworkSolverStrategy instances; use DirectNetworkSolver instead.
+         */
+        NSEDispatchNetworkSolver(DynamicEngine& engine, DynamicNetworkSolverStrategy& fallbackSolver);
+
+        /**
+         * @brief Evaluates the zone in NSE or with the fallback solver.
+         * @param netIn The input conditions for the network.
+         * @return The output conditions after the timestep.
+         */
+        NetOut evaluate(const NetIn& netIn) override;
+
+        /**
+         * @brief Evaluates the zone in NSE or with the fallback solver, with hysteresis on the previous mode.
+         * @param netIn The input conditions for the network.
+         * @param state Per-zone solver state, shared with the NSE and fallback solvers.
+         * @return The output conditions after the timestep.
+         */
+        NetOut evaluate(const NetIn& netIn, SolverState& state) override;
+
+        /**
+         * @brief Gets the NSE solver, e.g. to set its partition function.
+         * @return The NSE solver.
+         */
+        NSENetworkSolver& getNSESolver() { return m_nseSolver; }
+    private:
+        quill::Logger* m_logger = fourdst::logging::LogManager::getInstance().getLogger("log"); ///< Logger instance.
+        fourdst::config::Config& m_config = fourdst::config::Config::getInstance(); ///< Configuration instance.
+
+        NSENetworkSolver m_nseSolver; ///< Solver used for zones in NSE.
+        DynamicNetworkSolverStrategy& m_fallbackSolver; ///< Solver used for all other zones.
+    };
+}
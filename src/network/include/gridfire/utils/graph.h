@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+
+namespace gridfire::utils {
+    /**
+     * @struct BlockOrdering
+     * @brief A symmetric permutation of a matrix which brings it to block lower triangular form.
+     *
+     * Row/column `ordering[k]` of the original matrix becomes row/column `k` of the permuted
+     * matrix. The diagonal blocks are the ranges `[blockOffsets[b], blockOffsets[b + 1])` of the
+     * permuted indices; the permuted matrix has no structural entries above the diagonal blocks.
+     */
+    struct BlockOrdering {
+        std::vector<size_t> ordering; ///< Original index of each permuted index.
+        std::vector<size_t> blockOffsets; ///< Start of each diagonal block in the permuted indices, followed by the total size.
+
+        /**
+         * @brief Number of diagonal blocks.
+         */
+        [[nodiscard]] size_t numBlocks() const { return blockOffsets.empty() ? 0 : blockOffsets.size() - 1; }
+
+        /**
+         * @brief Size of the largest diagonal block.
+         */
+        [[nodiscard]] size_t largestBlock() const;
+    };
+
+    /**
+     * @struct SparsityPattern
+     * @brief Structural nonzero pattern of a sparse matrix in compressed sparse row (CSR) form.
+     *
+     * The column indices of each row are sorted and unique, so the pattern can be handed directly
+     * to the symbolic analysis of a sparse solver.
+     */
+    struct SparsityPattern {
+        size_t numRows = 0; ///< Number of rows.
+        size_t numColumns = 0; ///< Number of columns.
+        std::vector<size_t> rowOffsets; ///< Start of each row in `columnIndices`, followed by the number of nonzeros (size numRows + 1).
+        std::vector<size_t> columnIndices; ///< Column index of each structural nonzero, sorted within each row.
+
+        /**
+         * @brief Number of structural nonzeros.
+         */
+        [[nodiscard]] size_t nonZeros() const { return columnIndices.size(); }
+
+        /**
+         * @brief Whether entry (row, column) is a structural nonzero.
+         */
+        [[nodiscard]] bool contains(size_t row, size_t column) const;
+    };
+
+    /**
+     * @brief Finds the strongly connected components of a directed graph.
+     *
+     * @param numNodes Number of nodes in the graph; nodes are identified by their index.
+     * @param offsets CSR row offsets of the adjacency (size numNodes + 1). The successors of node
+     *                `i` are `targets[offsets[i]]` through `targets[offsets[i + 1] - 1]`.
+     * @param targets CSR column indices of the adjacency.
+     * @return The strongly connected components, each a list of node indices. Every node belongs
+     *         to exactly one component; a node on no cycle forms a component of its own.
+     *
+     * @b Algorithm
+     * Tarjan's algorithm, written with an explicit stack so that long reaction chains cannot
+     * overflow the call stack. It runs in O(V + E). Components are emitted in reverse topological
+     * order of the condensation: if there is an edge from component A to component B, B is
+     * returned before A.
+     *
+     * @b Usage
+     * @code
+     * // 0 -> 1 -> 2 -> 0 and 2 -> 3
+     * std::vector<size_t> offsets = {0, 1, 2, 4, 4};
+     * std::vector<size_t> targets = {1, 2, 0, 3};
+     * auto components = gridfire::utils::stronglyConnectedComponents(4, offsets, targets);
+     * // components == {{3}, {2, 1, 0}} (member order within a component is unspecified)
+     * @endcode
+     */
+    std::vector<std::vector<size_t>> stronglyConnectedComponents(
+        size_t numNodes,
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets
+    );
+
+    /**
+     * @brief Builds a CSR adjacency from an edge list.
+     *
+     * @param numNodes Number of nodes in the graph.
+     * @param edges Directed edges as (source, target) pairs. Duplicate edges are kept.
+     * @param offsets Output CSR row offsets (size numNodes + 1).
+     * @param targets Output CSR column indices.
+     */
+    void buildAdjacency(
+        size_t numNodes,
+        const std::vector<std::pair<size_t, size_t>>& edges,
+        std::vector<size_t>& offsets,
+        std::vector<size_t>& targets
+    );
+
+    /**
+     * @brief Computes a block lower triangular ordering of a square sparsity pattern.
+     *
+     * @param numNodes Dimension of the matrix.
+     * @param offsets CSR row offsets of the structural pattern; row `i` has an entry in column `j`
+     *                if `j` is among `targets[offsets[i]]` through `targets[offsets[i + 1] - 1]`.
+     * @param targets CSR column indices of the structural pattern.
+     * @return The ordering. Its diagonal blocks are the strongly connected components of the
+     *         pattern, seen as a graph with an edge from `i` to `j` for each entry (i, j).
+     *
+     * This is the fine block triangular form of a matrix with a zero-free diagonal (the
+     * Dulmage-Mendelsohn decomposition reduces to it), which holds for the iteration matrices of
+     * implicit integrators. Since stronglyConnectedComponents() emits a component after every
+     * component it has edges into, the blocks come out with all couplings below the diagonal.
+     */
+    BlockOrdering blockTriangularOrdering(
+        size_t numNodes,
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets
+    );
+
+    /**
+     * @brief Restricts a block ordering to a subset of its indices.
+     *
+     * @param ordering Block ordering over the full index range.
+     * @param subset Distinct indices of the full range to keep.
+     * @return The ordering of the principal submatrix on `subset`, in terms of positions in
+     *         `subset`. Blocks which lose all their members are dropped.
+     *
+     * Removing rows and columns can only remove couplings, so the result is still block lower
+     * triangular, although its blocks may be coarser than those of the submatrix itself.
+     */
+    BlockOrdering restrictBlockOrdering(
+        const BlockOrdering& ordering,
+        const std::vector<size_t>& subset
+    );
+
+    /**
+     * @brief Computes a reverse Cuthill-McKee ordering of an undirected graph.
+     *
+     * @param numNodes Number of nodes in the graph.
+     * @param offsets CSR row offsets of the adjacency (size numNodes + 1). The adjacency must be
+     *                symmetric and should be free of self loops and duplicate edges, which would
+     *                count towards the degree of a node.
+     * @param targets CSR column indices of the adjacency.
+     * @return The ordering: `ordering[k]` is the node placed at position `k`.
+     *
+     * Each connected component is traversed breadth first from a node of minimum degree, visiting
+     * neighbours in order of increasing degree (ties broken by node index, so the result is
+     * deterministic), and the complete order is reversed. Numbering nodes in this order
+     * concentrates the entries of the matrix near its diagonal, which reduces LU fill-in and keeps
+     * nodes that are used together close in memory.
+     */
+    std::vector<size_t> reverseCuthillMcKee(
+        size_t numNodes,
+        const std::vector<size_t>& offsets,
+        const std::vector<size_t>& targets
+    );
+
+    /**
+     * @brief Builds a sparsity pattern from a list of entries.
+     *
+     * @param numRows Number of rows of the matrix.
+     * @param numColumns Number of columns of the matrix.
+     * @param entries (row, column) pairs of the structural nonzeros; duplicates are merged.
+     * @return The pattern in CSR form with sorted column indices.
+     */
+    SparsityPattern buildSparsityPattern(
+        size_t numRows,
+        size_t numColumns,
+        std::vector<std::pair<size_t, size_t>> entries
+    );
+
+    /**
+     * @brief Restricts a sparsity pattern to a submatrix.
+     *
+     * @param pattern Pattern of the full matrix.
+     * @param rowSubset Rows of the full matrix to keep; row `k` of the result is row `rowSubset[k]`.
+     * @param columnSubset Columns of the full matrix to keep; column `k` of the result is column `columnSubset[k]`.
+     * @return The pattern of the submatrix.
+     */
+    SparsityPattern restrictSparsityPattern(
+        const SparsityPattern& pattern,
+        const std::vector<size_t>& rowSubset,
+        const std::vector<size_t>& columnSubset
+    );
+}
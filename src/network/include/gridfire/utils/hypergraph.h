@@ -0,0 +1,143 @@
+#pragma once
+
+#include "gridfire/reaction/reaction.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file hypergraph.h
+ * @brief Index-based hypergraph view of a reaction network.
+ *
+ * @author
+ * Emily M. Boudreaux
+ */
+
+namespace gridfire::utils {
+
+    /**
+     * @class NetworkHypergraph
+     * @brief Compressed incidence structure of a reaction network.
+     *
+     * A reaction network is a directed hypergraph: each reaction is a hyperedge from its set of
+     * reactants to its set of products. Walking it through the Species objects held by each
+     * reaction means hashing or linearly searching for every species on every visit. This class
+     * builds the incidence once, in compressed sparse row (CSR) arrays of integer indices:
+     *
+     * - reaction → unique reactants (with stoichiometric counts) and unique products (with counts);
+     * - species → reactions consuming it and reactions producing it.
+     *
+     * Species and reaction indices are the positions in the species vector and reaction set the
+     * hypergraph was built from, so they agree with the indices used by the owning engine. Lookup
+     * of a species index is O(1).
+     *
+     * @par Usage Example:
+     * @code
+     * utils::NetworkHypergraph graph(engine.getNetworkSpecies(), engine.getNetworkReactions());
+     * for (const size_t j : graph.consumers(graph.speciesIndex(he4))) {
+     *     // reaction j consumes he-4
+     * }
+     * @endcode
+     */
+    class NetworkHypergraph {
+    public:
+        NetworkHypergraph() = default;
+
+        /**
+         * @brief Builds the hypergraph of a reaction network.
+         * @param species Network species; their positions define the species indices.
+         * @param reactions Network reactions; their positions define the reaction indices.
+         *
+         * @throws std::runtime_error If a reaction refers to a species not in `species`.
+         */
+        NetworkHypergraph(
+            const std::vector<fourdst::atomic::Species>& species,
+            const reaction::LogicalReactionSet& reactions
+        );
+
+        /**
+         * @brief Number of species (vertices).
+         */
+        [[nodiscard]] size_t numSpecies() const { return m_consumerOffsets.empty() ? 0 : m_consumerOffsets.size() - 1; }
+
+        /**
+         * @brief Number of reactions (hyperedges).
+         */
+        [[nodiscard]] size_t numReactions() const { return m_reactantOffsets.empty() ? 0 : m_reactantOffsets.size() - 1; }
+
+        /**
+         * @brief Whether a species is a vertex of the hypergraph.
+         */
+        [[nodiscard]] bool containsSpecies(const fourdst::atomic::Species& species) const;
+
+        /**
+         * @brief Index of a species.
+         * @throws std::out_of_range If the species is not in the network.
+         */
+        [[nodiscard]] size_t speciesIndex(const fourdst::atomic::Species& species) const;
+
+        /**
+         * @brief Unique reactant indices of reaction `j`, sorted.
+         */
+        [[nodiscard]] std::span<const size_t> reactants(size_t j) const;
+
+        /**
+         * @brief Stoichiometric count of each entry of reactants(j).
+         */
+        [[nodiscard]] std::span<const int> reactantCounts(size_t j) const;
+
+        /**
+         * @brief Unique product indices of reaction `j`, sorted.
+         */
+        [[nodiscard]] std::span<const size_t> products(size_t j) const;
+
+        /**
+         * @brief Stoichiometric count of each entry of products(j).
+         */
+        [[nodiscard]] std::span<const int> productCounts(size_t j) const;
+
+        /**
+         * @brief Indices of the reactions which consume species `i`, sorted.
+         */
+        [[nodiscard]] std::span<const size_t> consumers(size_t i) const;
+
+        /**
+         * @brief Indices of the reactions which produce species `i`, sorted.
+         */
+        [[nodiscard]] std::span<const size_t> producers(size_t i) const;
+
+        /**
+         * @brief Finds every species producible from a set of seed species.
+         * @param seeds Indices of the species initially present.
+         * @return A flag per species index, true if the species is a seed or can be produced.
+         *
+         * A reaction fires once all of its reactants are reachable, making its products reachable.
+         * Each reaction keeps a countdown of its unreached unique reactants, decremented as each of
+         * them is reached; the reaction fires when the countdown hits zero. Every species and every
+         * consumer edge is visited once, so the search is O(V + E) rather than repeated sweeps
+         * over all reactions.
+         */
+        [[nodiscard]] std::vector<bool> reachableFrom(const std::vector<size_t>& seeds) const;
+
+    private:
+        std::unordered_map<fourdst::atomic::Species, size_t> m_speciesIndex; ///< Index of each species.
+
+        std::vector<size_t> m_reactantOffsets; ///< Start of each reaction's reactants, followed by the total (size numReactions + 1).
+        std::vector<size_t> m_reactantIndices; ///< Unique reactant species indices.
+        std::vector<int> m_reactantCounts; ///< Stoichiometric count of each reactant entry.
+
+        std::vector<size_t> m_productOffsets; ///< Start of each reaction's products, followed by the total (size numReactions + 1).
+        std::vector<size_t> m_productIndices; ///< Unique product species indices.
+        std::vector<int> m_productCounts; ///< Stoichiometric count of each product entry.
+
+        std::vector<size_t> m_consumerOffsets; ///< Start of each species' consuming reactions, followed by the total (size numSpecies + 1).
+        std::vector<size_t> m_consumerIndices; ///< Reaction indices consuming each species.
+
+        std::vector<size_t> m_producerOffsets; ///< Start of each species' producing reactions, followed by the total (size numSpecies + 1).
+        std::vector<size_t> m_producerIndices; ///< Reaction indices producing each species.
+    };
+}
@@ -495,6 +495,7 @@ namespace gridfire::approx8{
 		}
 		netOut.energy = m_y[Approx8Net::iEnergy];
 		netOut.num_steps = num_steps;
+		netOut.time = m_tMax;
 
 		const std::vector<std::string> symbols = {"H-1", "He-3", "He-4", "C-12", "N-14", "O-16", "Ne-20", "Mg-24"};
 		netOut.composition = fourdst::composition::Composition(symbols, outComposition);
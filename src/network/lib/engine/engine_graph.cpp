@@ -2,12 +2,14 @@
 #include "gridfire/reaction/reaction.h"
 #include "gridfire/network.h"
 #include "gridfire/screening/screening_types.h"
+#include "gridfire/utils/graph.h"
 
 #include "fourdst/composition/species.h"
 #include "fourdst/composition/atomicSpecies.h"
 
 #include "quill/LogMacros.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <set>
@@ -54,14 +56,25 @@ namespace gridfire {
             // --- The public facing interface can always use the precomputed version since taping is done internally ---
             return calculateAllDerivativesUsingPrecomputation(Y, bare_rates, T9, rho);
         } else {
-            return calculateAllDerivatives<double>(Y, T9, rho);
+            return calculateAllDerivatives<double>(Y, T9, rho, m_rateMultipliers);
         }
     }
 
 
-    void GraphEngine::syncInternalMaps() {
+    void GraphEngine::syncInternalMaps(const std::unordered_map<std::string, double>& rateMultipliersById) {
         collectNetworkSpecies();
+        m_hypergraph = utils::NetworkHypergraph(m_networkSpecies, m_reactions);
         populateReactionIDMap();
+
+        // --- Multipliers follow their reactions by id; the tape recorded below takes them as its dynamic parameters ---
+        m_rateMultipliers.assign(m_reactions.size(), 1.0);
+        for (const auto& [id, multiplier] : rateMultipliersById) {
+            if (const auto it = m_reactionIndexMap.find(id); it != m_reactionIndexMap.end()) {
+                m_rateMultipliers[it->second] = multiplier;
+            }
+        }
+        ++m_rateMultiplierGeneration;
+
         populateSpeciesToIndexMap();
         generateStoichiometryMatrix();
         reserveJacobianMatrix();
@@ -101,8 +114,11 @@ namespace gridfire {
     void GraphEngine::populateReactionIDMap() {
         LOG_TRACE_L1(m_logger, "Populating reaction ID map for REACLIB graph network (serif::network::GraphNetwork)...");
         m_reactionIDMap.clear();
-        for (auto& reaction: m_reactions) {
+        m_reactionIndexMap.clear();
+        for (size_t j = 0; j < m_reactions.size(); ++j) {
+            auto& reaction = m_reactions[j];
             m_reactionIDMap.emplace(reaction.id(), &reaction);
+            m_reactionIndexMap.emplace(reaction.id(), j);
         }
         LOG_TRACE_L1(m_logger, "Populated {} reactions in the reaction ID map.", m_reactionIDMap.size());
     }
@@ -148,39 +164,29 @@ namespace gridfire {
     bool GraphEngine::validateConservation() const {
         LOG_TRACE_L1(m_logger, "Validating mass (A) and charge (Z) conservation across all reactions in the network.");
 
-        for (const auto& reaction : m_reactions) {
+        for (size_t j = 0; j < m_reactions.size(); ++j) {
+            const auto& reaction = m_reactions[j];
             uint64_t totalReactantA = 0;
             uint64_t totalReactantZ = 0;
             uint64_t totalProductA = 0;
             uint64_t totalProductZ = 0;
 
-            // Calculate total A and Z for reactants
-            for (const auto& reactant : reaction.reactants()) {
-                auto it = m_networkSpeciesMap.find(reactant.name());
-                if (it != m_networkSpeciesMap.end()) {
-                    totalReactantA += it->second.a();
-                    totalReactantZ += it->second.z();
-                } else {
-                    // This scenario indicates a severe data integrity issue:
-                    // a reactant is part of a reaction but not in the network's species map.
-                    LOG_ERROR(m_logger, "CRITICAL ERROR: Reactant species '{}' in reaction '{}' not found in network species map during conservation validation.",
-                             reactant.name(), reaction.id());
-                    return false;
-                }
+            // Every species of the hypergraph is a network species by construction, so the totals
+            // are plain index lookups weighted by the stoichiometric counts.
+            const auto reactants = m_hypergraph.reactants(j);
+            const auto reactantCounts = m_hypergraph.reactantCounts(j);
+            for (size_t k = 0; k < reactants.size(); ++k) {
+                const auto& reactant = m_networkSpecies[reactants[k]];
+                totalReactantA += static_cast<uint64_t>(reactantCounts[k]) * reactant.a();
+                totalReactantZ += static_cast<uint64_t>(reactantCounts[k]) * reactant.z();
             }
 
-            // Calculate total A and Z for products
-            for (const auto& product : reaction.products()) {
-                auto it = m_networkSpeciesMap.find(product.name());
-                if (it != m_networkSpeciesMap.end()) {
-                    totalProductA += it->second.a();
-                    totalProductZ += it->second.z();
-                } else {
-                    // Similar critical error for product species
-                    LOG_ERROR(m_logger, "CRITICAL ERROR: Product species '{}' in reaction '{}' not found in network species map during conservation validation.",
-                             product.name(), reaction.id());
-                    return false;
-                }
+            const auto products = m_hypergraph.products(j);
+            const auto productCounts = m_hypergraph.productCounts(j);
+            for (size_t k = 0; k < products.size(); ++k) {
+                const auto& product = m_networkSpecies[products[k]];
+                totalProductA += static_cast<uint64_t>(productCounts[k]) * product.a();
+                totalProductZ += static_cast<uint64_t>(productCounts[k]) * product.z();
             }
 
             // Compare totals for conservation
@@ -215,8 +221,16 @@ namespace gridfire {
         // This allows for dynamic network modification while retaining caching for networks which are very similar.
         if (validationReactionSet != m_reactions) {
             LOG_DEBUG(m_logger, "Reaction set not cached. Rebuilding the reaction set for T9={} and culling={}.", T9, culling);
+            // The ids are copied out: the keys of m_reactionIndexMap view into the reactions replaced below
+            std::unordered_map<std::string, double> rateMultipliersById;
+            for (const auto& [id, j] : m_reactionIndexMap) {
+                if (m_rateMultipliers[j] != 1.0) {
+                    rateMultipliersById.emplace(std::string(id), m_rateMultipliers[j]);
+                }
+            }
             m_reactions = validationReactionSet;
-            syncInternalMaps(); // Re-sync internal maps after updating reactions. Note this will also retrace the AD tape.
+            syncInternalMaps(rateMultipliersById); // Re-sync internal maps after updating reactions. Note this will also retrace the AD tape.
+            precomputeNetwork(); // The precomputed reactions and the species-to-reaction adjacency index into the new reaction set.
         }
     }
 
@@ -235,46 +249,23 @@ namespace gridfire {
             rho
         );
 
-        // --- Optimized loop ---
+        // --- Optimized loop, in local species order ---
+        const std::vector<double> Y_local = toLocalSpeciesOrder(Y_in);
         std::vector<double> molarReactionFlows;
         molarReactionFlows.reserve(m_precomputedReactions.size());
 
         for (const auto& precomp : m_precomputedReactions) {
-            double abundanceProduct = 1.0;
-            bool below_threshold = false;
-            for (size_t i = 0; i < precomp.unique_reactant_indices.size(); ++i) {
-                const size_t reactantIndex = precomp.unique_reactant_indices[i];
-                const int power = precomp.reactant_powers[i];
-                const double abundance = Y_in[reactantIndex];
-                if (abundance < MIN_ABUNDANCE_THRESHOLD) {
-                    below_threshold = true;
-                    break;
-                }
-
-                abundanceProduct *= std::pow(Y_in[reactantIndex], power);
-            }
-            if (below_threshold) {
-                molarReactionFlows.push_back(0.0);
-                continue; // Skip this reaction if any reactant is below the abundance threshold
-            }
-
-            const double bare_rate = bare_rates[precomp.reaction_index];
-            const double screeningFactor = screeningFactors[precomp.reaction_index];
-            const size_t numReactants = m_reactions[precomp.reaction_index].reactants().size();
-
-            const double molarReactionFlow =
-                    screeningFactor *
-                    bare_rate *
-                    precomp.symmetry_factor *
-                    abundanceProduct *
-                    std::pow(rho, numReactants);
-
-            molarReactionFlows.push_back(molarReactionFlow);
+            molarReactionFlows.push_back(calculatePrecomputedMolarReactionFlow(
+                precomp,
+                Y_local,
+                bare_rates[precomp.reaction_index],
+                screeningFactors[precomp.reaction_index],
+                rho
+            ));
         }
 
         // --- Assemble molar abundance derivatives ---
-        StepDerivatives<double> result;
-        result.dydt.assign(m_networkSpecies.size(), 0.0); // Initialize derivatives to zero
+        std::vector<double> dydt_local(m_networkSpecies.size(), 0.0); // Initialize derivatives to zero
         for (size_t j = 0; j < m_precomputedReactions.size(); ++j) {
             const auto& precomp = m_precomputedReactions[j];
             const double R_j = molarReactionFlows[j];
@@ -284,10 +275,16 @@ namespace gridfire {
                 const int stoichiometricCoefficient = precomp.stoichiometric_coefficients[i];
 
                 // Update the derivative for this species
-                result.dydt[speciesIndex] += static_cast<double>(stoichiometricCoefficient) * R_j / rho;
+                dydt_local[speciesIndex] += static_cast<double>(stoichiometricCoefficient) * R_j / rho;
             }
         }
 
+        StepDerivatives<double> result;
+        result.dydt.resize(m_networkSpecies.size());
+        for (size_t k = 0; k < m_localSpeciesOrder.size(); ++k) {
+            result.dydt[m_localSpeciesOrder[k]] = dydt_local[k];
+        }
+
         // --- Calculate the nuclear energy generation rate ---
         double massProductionRate = 0.0; // [mol][s^-1]
         for (size_t i = 0; i < m_networkSpecies.size(); ++i) {
@@ -299,6 +296,178 @@ namespace gridfire {
 
     }
 
+    double GraphEngine::calculatePrecomputedMolarReactionFlow(
+        const PrecomputedReaction &precomp,
+        const std::vector<double> &Y_in,
+        const double bare_rate,
+        const double screeningFactor,
+        const double rho
+    ) const {
+        double abundanceProduct = 1.0;
+        for (size_t i = 0; i < precomp.unique_reactant_indices.size(); ++i) {
+            const size_t reactantIndex = precomp.unique_reactant_indices[i];
+            const int power = precomp.reactant_powers[i];
+            const double abundance = Y_in[reactantIndex];
+            if (abundance < MIN_ABUNDANCE_THRESHOLD) {
+                return 0.0; // Skip this reaction if any reactant is below the abundance threshold
+            }
+
+            abundanceProduct *= std::pow(abundance, power);
+        }
+
+        const size_t numReactants = m_reactions[precomp.reaction_index].reactants().size();
+
+        return m_rateMultipliers[precomp.reaction_index] *
+               screeningFactor *
+               bare_rate *
+               precomp.symmetry_factor *
+               abundanceProduct *
+               std::pow(rho, numReactants);
+    }
+
+    std::vector<double> GraphEngine::calculateRHSSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const double T9,
+        const double rho
+    ) const {
+        if (!m_usePrecomputation) {
+            return DynamicEngine::calculateRHSSubset(Y, speciesIndices, T9, rho);
+        }
+
+        const std::vector<double> screeningFactors = m_screeningModel->calculateScreeningFactors(
+            m_reactions,
+            m_networkSpecies,
+            Y,
+            T9,
+            rho
+        );
+
+        // --- Each reaction flow is evaluated at most once, even if it changes several requested species ---
+        const std::vector<double> Y_local = toLocalSpeciesOrder(Y);
+        std::vector<double> molarReactionFlows(m_precomputedReactions.size(), 0.0);
+        std::vector<uint8_t> flowEvaluated(m_precomputedReactions.size(), 0);
+
+        std::vector<double> subset(speciesIndices.size(), 0.0);
+        for (size_t s = 0; s < speciesIndices.size(); ++s) {
+            const size_t speciesIndex = m_publicToLocalSpecies[speciesIndices[s]];
+            for (size_t k = m_speciesReactionOffsets[speciesIndex]; k < m_speciesReactionOffsets[speciesIndex + 1]; ++k) {
+                const size_t j = m_speciesReactionIndices[k];
+                if (!flowEvaluated[j]) {
+                    const auto& precomp = m_precomputedReactions[j];
+                    molarReactionFlows[j] = calculatePrecomputedMolarReactionFlow(
+                        precomp,
+                        Y_local,
+                        m_reactions[precomp.reaction_index].calculate_rate(T9),
+                        screeningFactors[precomp.reaction_index],
+                        rho
+                    );
+                    flowEvaluated[j] = 1;
+                }
+                subset[s] += static_cast<double>(m_speciesReactionCoefficients[k]) * molarReactionFlows[j] / rho;
+            }
+        }
+        return subset;
+    }
+
+    void GraphEngine::calculateRHSAndEnergyBatch(
+        const std::vector<double> &Y,
+        const std::vector<double> &T9,
+        const std::vector<double> &rho,
+        const std::vector<uint8_t> &activeZones,
+        BatchStepDerivatives &derivatives
+    ) const {
+        if (!m_usePrecomputation) {
+            DynamicEngine::calculateRHSAndEnergyBatch(Y, T9, rho, activeZones, derivatives);
+            return;
+        }
+
+        const size_t numZones = T9.size();
+        const size_t numSpecies = m_networkSpecies.size();
+        const size_t numReactions = m_reactions.size();
+
+        // --- Bare rates and screening factors, stored reaction-major (j * numZones + z) ---
+        std::vector<double> bareRates(numReactions * numZones, 0.0);
+        std::vector<double> screeningFactors(numReactions * numZones, 0.0);
+        std::vector<double> zoneY(numSpecies);
+        for (size_t z = 0; z < numZones; ++z) {
+            if (!activeZones[z]) {
+                continue;
+            }
+            for (size_t i = 0; i < numSpecies; ++i) {
+                zoneY[i] = Y[i * numZones + z];
+            }
+            const std::vector<double> zoneScreening = m_screeningModel->calculateScreeningFactors(
+                m_reactions,
+                m_networkSpecies,
+                zoneY,
+                T9[z],
+                rho[z]
+            );
+            for (size_t j = 0; j < numReactions; ++j) {
+                bareRates[j * numZones + z] = m_reactions[j].calculate_rate(T9[z]);
+                screeningFactors[j * numZones + z] = zoneScreening[j];
+            }
+        }
+
+        derivatives.dydt.assign(numSpecies * numZones, 0.0);
+        derivatives.nuclearEnergyGenerationRate.assign(numZones, 0.0);
+
+        std::vector<double> inverseRho(numZones);
+        for (size_t z = 0; z < numZones; ++z) {
+            inverseRho[z] = 1.0 / rho[z];
+        }
+
+        // --- Reaction outer loop, zone inner loop ---
+        std::vector<double> flow(numZones);
+        for (const auto& precomp : m_precomputedReactions) {
+            const size_t numReactants = m_reactions[precomp.reaction_index].reactants().size();
+            const double* rate = &bareRates[precomp.reaction_index * numZones];
+            const double* screening = &screeningFactors[precomp.reaction_index * numZones];
+            const double multiplier = m_rateMultipliers[precomp.reaction_index];
+
+            for (size_t z = 0; z < numZones; ++z) {
+                double rhoPower = 1.0;
+                for (size_t n = 0; n < numReactants; ++n) {
+                    rhoPower *= rho[z];
+                }
+                flow[z] = multiplier * screening[z] * rate[z] * precomp.symmetry_factor * rhoPower;
+            }
+
+            for (size_t r = 0; r < precomp.unique_reactant_indices.size(); ++r) {
+                const double* reactantY = &Y[m_localSpeciesOrder[precomp.unique_reactant_indices[r]] * numZones];
+                const int power = precomp.reactant_powers[r];
+                for (size_t z = 0; z < numZones; ++z) {
+                    const double abundance = reactantY[z];
+                    double abundancePower = abundance;
+                    for (int p = 1; p < power; ++p) {
+                        abundancePower *= abundance;
+                    }
+                    // Reactions with any reactant below the abundance threshold do not proceed
+                    flow[z] *= abundance < MIN_ABUNDANCE_THRESHOLD ? 0.0 : abundancePower;
+                }
+            }
+
+            for (size_t a = 0; a < precomp.affected_species_indices.size(); ++a) {
+                double* speciesDydt = &derivatives.dydt[m_localSpeciesOrder[precomp.affected_species_indices[a]] * numZones];
+                const auto stoichiometricCoefficient = static_cast<double>(precomp.stoichiometric_coefficients[a]);
+                for (size_t z = 0; z < numZones; ++z) {
+                    speciesDydt[z] += stoichiometricCoefficient * flow[z] * inverseRho[z];
+                }
+            }
+        }
+
+        // --- Nuclear energy generation rate ---
+        const double massToEnergy = m_constants.u * m_constants.Na * m_constants.c * m_constants.c;
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const double speciesEnergy = m_networkSpecies[i].mass() * massToEnergy;
+            const double* speciesDydt = &derivatives.dydt[i * numZones];
+            for (size_t z = 0; z < numZones; ++z) {
+                derivatives.nuclearEnergyGenerationRate[z] -= speciesDydt[z] * speciesEnergy; // [erg][s^-1][g^-1]
+            }
+        }
+    }
+
     // --- Generate Stoichiometry Matrix ---
     void GraphEngine::generateStoichiometryMatrix() {
         LOG_TRACE_L1(m_logger, "Generating stoichiometry matrix...");
@@ -346,7 +515,7 @@ namespace gridfire {
         const double T9,
         const double rho
     ) const {
-        return calculateAllDerivatives<double>(Y_in, T9, rho);
+        return calculateAllDerivatives<double>(Y_in, T9, rho, m_rateMultipliers);
     }
 
     StepDerivatives<ADDouble> GraphEngine::calculateAllDerivatives(
@@ -354,7 +523,8 @@ namespace gridfire {
         const ADDouble &T9,
         const ADDouble &rho
     ) const {
-        return calculateAllDerivatives<ADDouble>(Y_in, T9, rho);
+        const std::vector<ADDouble> rateMultipliers(m_rateMultipliers.begin(), m_rateMultipliers.end());
+        return calculateAllDerivatives<ADDouble>(Y_in, T9, rho, rateMultipliers);
     }
 
     void GraphEngine::setScreeningModel(const screening::ScreeningType model) {
@@ -374,13 +544,65 @@ namespace gridfire {
         return m_usePrecomputation;
     }
 
+    void GraphEngine::setSpeciesReordering(const bool reorder) {
+        if (reorder == m_reorderSpecies) {
+            return;
+        }
+        m_reorderSpecies = reorder;
+        precomputeNetwork();
+    }
+
+    bool GraphEngine::isSpeciesReorderingEnabled() const {
+        return m_reorderSpecies;
+    }
+
+    void GraphEngine::setRateMultipliers(const std::vector<double> &multipliers) {
+        if (multipliers.size() != m_reactions.size()) {
+            LOG_ERROR(m_logger, "Expected {} rate multipliers (one per reaction), got {}.", m_reactions.size(), multipliers.size());
+            m_logger->flush_log();
+            throw std::runtime_error("Number of rate multipliers does not match the number of reactions.");
+        }
+        m_rateMultipliers = multipliers;
+        m_rhsADFun.new_dynamic(m_rateMultipliers); // Replaces the tape's dynamic parameters; the tape itself is unchanged
+        ++m_rateMultiplierGeneration;
+    }
+
+    std::vector<double> GraphEngine::getRateMultipliers() const {
+        return m_rateMultipliers;
+    }
+
     double GraphEngine::calculateMolarReactionFlow(
         const reaction::Reaction &reaction,
         const std::vector<double> &Y,
         const double T9,
         const double rho
     ) const {
-        return calculateMolarReactionFlow<double>(reaction, Y, T9, rho);
+        const auto it = m_reactionIndexMap.find(reaction.id());
+        const double multiplier = it != m_reactionIndexMap.end() ? m_rateMultipliers[it->second] : 1.0;
+        return multiplier * calculateMolarReactionFlow<double>(reaction, Y, T9, rho);
+    }
+
+    std::vector<double> GraphEngine::calculateAllMolarReactionFlows(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        if (!m_usePrecomputation) {
+            return DynamicEngine::calculateAllMolarReactionFlows(Y, T9, rho);
+        }
+
+        const std::vector<double> Y_local = toLocalSpeciesOrder(Y);
+        std::vector<double> flows(m_reactions.size(), 0.0);
+        for (const auto& precomp : m_precomputedReactions) {
+            flows[precomp.reaction_index] = calculatePrecomputedMolarReactionFlow(
+                precomp,
+                Y_local,
+                m_reactions[precomp.reaction_index].calculate_rate(T9),
+                1.0, // calculateMolarReactionFlow() reports unscreened flows
+                rho
+            );
+        }
+        return flows;
     }
 
     void GraphEngine::generateJacobianMatrix(
@@ -416,8 +638,95 @@ namespace gridfire {
         LOG_TRACE_L1(m_logger, "Jacobian matrix generated with dimensions: {} rows x {} columns.", m_jacobianMatrix.size1(), m_jacobianMatrix.size2());
     }
 
-    double GraphEngine::getJacobianMatrixEntry(const int i, const int j) const {
-        return m_jacobianMatrix(i, j);
+    std::vector<double> GraphEngine::calculateJacobianSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const utils::SparsityPattern &pattern,
+        const double T9,
+        const double rho
+    ) {
+        using SizeVector = std::vector<size_t>;
+        const size_t numSpecies = m_networkSpecies.size();
+        const size_t numADInputs = numSpecies + 2;
+
+        std::vector<double> adInput(numADInputs, 0.0);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            adInput[i] = Y[i];
+        }
+        adInput[numSpecies]     = T9;
+        adInput[numSpecies + 1] = rho;
+
+        // --- Sparsity of the tape, which (unlike the structural pattern) includes the screening couplings ---
+        if (m_rhsTapePattern.rowOffsets.empty()) {
+            CppAD::sparse_rc<SizeVector> identity(numADInputs, numADInputs, numADInputs);
+            for (size_t k = 0; k < numADInputs; ++k) {
+                identity.set(k, k, k);
+            }
+            m_rhsADFun.for_jac_sparsity(identity, false, false, false, m_rhsADSparsity);
+
+            std::vector<std::pair<size_t, size_t>> tapeEntries;
+            tapeEntries.reserve(m_rhsADSparsity.nnz());
+            for (size_t k = 0; k < m_rhsADSparsity.nnz(); ++k) {
+                tapeEntries.emplace_back(m_rhsADSparsity.row()[k], m_rhsADSparsity.col()[k]);
+            }
+            m_rhsTapePattern = utils::buildSparsityPattern(numSpecies, numADInputs, std::move(tapeEntries));
+        }
+
+        // --- Requested entries which the tape can make nonzero; the others are exactly zero ---
+        struct RequestedEntry {
+            size_t index; ///< Position in `pattern`.
+            size_t row; ///< Species index of the row.
+            size_t column; ///< Species index of the column.
+        };
+        std::vector<RequestedEntry> requested;
+        requested.reserve(pattern.nonZeros());
+        for (size_t a = 0; a < pattern.numRows; ++a) {
+            for (size_t k = pattern.rowOffsets[a]; k < pattern.rowOffsets[a + 1]; ++k) {
+                const size_t row = speciesIndices[a];
+                const size_t column = speciesIndices[pattern.columnIndices[k]];
+                if (m_rhsTapePattern.contains(row, column)) {
+                    requested.push_back({k, row, column});
+                }
+            }
+        }
+        std::vector<double> values(pattern.nonZeros(), 0.0);
+        if (requested.empty()) {
+            return values;
+        }
+
+        CppAD::sparse_rc<SizeVector> subsetPattern(numSpecies, numADInputs, requested.size());
+        for (size_t e = 0; e < requested.size(); ++e) {
+            subsetPattern.set(e, requested[e].row, requested[e].column);
+        }
+        CppAD::sparse_rcv<SizeVector, std::vector<double>> subset(subsetPattern);
+
+        if (speciesIndices != m_jacobianSubsetSpecies) {
+            m_jacobianSubsetWork.clear();
+            m_jacobianSubsetSpecies = speciesIndices;
+        }
+        const size_t numSweeps = m_rhsADFun.sparse_jac_rev(adInput, subset, m_rhsADSparsity, "cppad", m_jacobianSubsetWork);
+        LOG_TRACE_L2(m_logger, "Jacobian subset of {} species ({} entries) computed in {} reverse sweeps.", speciesIndices.size(), requested.size(), numSweeps);
+
+        for (size_t e = 0; e < requested.size(); ++e) {
+            values[requested[e].index] = subset.val()[e];
+        }
+        return values;
+    }
+
+    utils::SparsityPattern GraphEngine::getJacobianSparsityPattern() const {
+        return m_jacobianSparsityPattern;
+    }
+
+    utils::SparsityPattern GraphEngine::getStoichiometrySparsityPattern() const {
+        return m_stoichiometrySparsityPattern;
+    }
+
+    const utils::NetworkHypergraph& GraphEngine::getNetworkHypergraph() const {
+        return m_hypergraph;
+    }
+
+    utils::BlockOrdering GraphEngine::getJacobianBlockOrdering() const {
+        return m_jacobianBlockOrdering;
     }
 
     std::unordered_map<fourdst::atomic::Species, int> GraphEngine::getNetReactionStoichiometry(
@@ -457,21 +766,32 @@ namespace gridfire {
 
         // 2. Define all reactions as intermediate nodes and connect them
         dotFile << "    // --- Reaction Edges ---\n";
-        for (const auto& reaction : m_reactions) {
+        for (size_t j = 0; j < m_reactions.size(); ++j) {
+            const auto& reaction = m_reactions[j];
             // Create a unique ID for the reaction node
             std::string reactionNodeId = "reaction_" + std::string(reaction.id());
 
             // Define the reaction node (small, black dot)
             dotFile << "    \"" << reactionNodeId << "\" [shape=point, fillcolor=black, width=0.1, height=0.1, label=\"\"];\n";
 
-            // Draw edges from reactants to the reaction node
-            for (const auto& reactant : reaction.reactants()) {
-                dotFile << "    \"" << reactant.name() << "\" -> \"" << reactionNodeId << "\";\n";
+            // Draw edges from reactants to the reaction node, one per participating nucleus
+            const auto reactants = m_hypergraph.reactants(j);
+            const auto reactantCounts = m_hypergraph.reactantCounts(j);
+            for (size_t k = 0; k < reactants.size(); ++k) {
+                const auto& reactant = m_networkSpecies[reactants[k]];
+                for (int n = 0; n < reactantCounts[k]; ++n) {
+                    dotFile << "    \"" << reactant.name() << "\" -> \"" << reactionNodeId << "\";\n";
+                }
             }
 
             // Draw edges from the reaction node to products
-            for (const auto& product : reaction.products()) {
-                dotFile << "    \"" << reactionNodeId << "\" -> \"" << product.name() << "\" [label=\"" << reaction.qValue() << " MeV\"];\n";
+            const auto products = m_hypergraph.products(j);
+            const auto productCounts = m_hypergraph.productCounts(j);
+            for (size_t k = 0; k < products.size(); ++k) {
+                const auto& product = m_networkSpecies[products[k]];
+                for (int n = 0; n < productCounts[k]; ++n) {
+                    dotFile << "    \"" << reactionNodeId << "\" -> \"" << product.name() << "\" [label=\"" << reaction.qValue() << " MeV\"];\n";
+                }
             }
             dotFile << "\n";
         }
@@ -537,7 +857,7 @@ namespace gridfire {
 
     std::unordered_map<fourdst::atomic::Species, double> GraphEngine::getSpeciesTimescales(const std::vector<double> &Y, const double T9,
         const double rho) const {
-        auto [dydt, _] = calculateAllDerivatives<double>(Y, T9, rho);
+        auto [dydt, _] = calculateAllDerivatives<double>(Y, T9, rho, m_rateMultipliers);
         std::unordered_map<fourdst::atomic::Species, double> speciesTimescales;
         speciesTimescales.reserve(m_networkSpecies.size());
         for (size_t i = 0; i < m_networkSpecies.size(); ++i) {
@@ -558,6 +878,12 @@ namespace gridfire {
     void GraphEngine::recordADTape() {
         LOG_TRACE_L1(m_logger, "Recording AD tape for the RHS calculation...");
 
+        // --- The tape sparsity and the subset coloring describe the old tape ---
+        m_rhsADSparsity = CppAD::sparse_rc<std::vector<size_t>>();
+        m_rhsTapePattern = utils::SparsityPattern();
+        m_jacobianSubsetWork.clear();
+        m_jacobianSubsetSpecies.clear();
+
         // Task 1: Set dimensions and initialize the matrix
         const size_t numSpecies = m_networkSpecies.size();
         if (numSpecies == 0) {
@@ -578,9 +904,13 @@ namespace gridfire {
         adInput[numSpecies]     = 1.0; // Dummy T9
         adInput[numSpecies + 1] = 1.0; // Dummy rho
 
+        // 2. Declare the rate multipliers as dynamic parameters: they enter the tape symbolically, so
+        //    setRateMultipliers() only has to swap their values in with new_dynamic().
+        std::vector<CppAD::AD<double>> adRateMultipliers(m_rateMultipliers.begin(), m_rateMultipliers.end());
+
         // 3. Declare independent variables (what CppAD will differentiate wrt.)
         //    This also beings the tape recording process.
-        CppAD::Independent(adInput);
+        CppAD::Independent(adInput, adRateMultipliers);
 
         std::vector<CppAD::AD<double>> adY(numSpecies);
         for(size_t i = 0; i < numSpecies; ++i) {
@@ -592,7 +922,7 @@ namespace gridfire {
 
         // 5. Call the actual templated function
         // We let T9 and rho be constant, so we pass them as fixed values.
-        auto [dydt, nuclearEnergyGenerationRate] = calculateAllDerivatives<CppAD::AD<double>>(adY, adT9, adRho);
+        auto [dydt, nuclearEnergyGenerationRate] = calculateAllDerivatives<CppAD::AD<double>>(adY, adT9, adRho, adRateMultipliers);
 
         m_rhsADFun.Dependent(adInput, dydt);
 
@@ -647,5 +977,114 @@ namespace gridfire {
 
             m_precomputedReactions.push_back(std::move(precomp));
         }
+
+        // --- Structural Jacobian and stoichiometry patterns, in public indices: d(dY_i/dt)/dY_j != 0 if j reacts into i ---
+        const size_t numSpecies = m_networkSpecies.size();
+        std::vector<std::pair<size_t, size_t>> jacobianPattern;
+        std::vector<std::pair<size_t, size_t>> stoichiometryPattern;
+        for (size_t i = 0; i < numSpecies; ++i) {
+            jacobianPattern.emplace_back(i, i);
+        }
+        for (const auto& precomp : m_precomputedReactions) {
+            for (size_t a = 0; a < precomp.affected_species_indices.size(); ++a) {
+                const size_t i = precomp.affected_species_indices[a];
+                if (precomp.stoichiometric_coefficients[a] != 0) {
+                    stoichiometryPattern.emplace_back(i, precomp.reaction_index);
+                }
+                for (const size_t j : precomp.unique_reactant_indices) {
+                    jacobianPattern.emplace_back(i, j);
+                }
+            }
+        }
+        m_jacobianSparsityPattern = utils::buildSparsityPattern(numSpecies, numSpecies, jacobianPattern);
+        m_stoichiometrySparsityPattern = utils::buildSparsityPattern(numSpecies, m_reactions.size(), std::move(stoichiometryPattern));
+
+        // --- Block triangular ordering of the structural Jacobian ---
+        m_jacobianBlockOrdering = utils::blockTriangularOrdering(
+            numSpecies,
+            m_jacobianSparsityPattern.rowOffsets,
+            m_jacobianSparsityPattern.columnIndices
+        );
+        LOG_DEBUG(m_logger, "Jacobian has {} diagonal blocks over {} species (largest block: {} species).",
+            m_jacobianBlockOrdering.numBlocks(), numSpecies, m_jacobianBlockOrdering.largestBlock());
+
+        // --- Local species order: reverse Cuthill-McKee on the symmetrized pattern ---
+        if (m_reorderSpecies) {
+            std::vector<std::pair<size_t, size_t>> symmetricPattern;
+            symmetricPattern.reserve(2 * jacobianPattern.size());
+            for (const auto& [i, j] : jacobianPattern) {
+                if (i != j) {
+                    symmetricPattern.emplace_back(i, j);
+                    symmetricPattern.emplace_back(j, i);
+                }
+            }
+            std::ranges::sort(symmetricPattern);
+            const auto duplicates = std::ranges::unique(symmetricPattern);
+            symmetricPattern.erase(duplicates.begin(), duplicates.end());
+
+            std::vector<size_t> symmetricOffsets, symmetricColumns;
+            utils::buildAdjacency(numSpecies, symmetricPattern, symmetricOffsets, symmetricColumns);
+            m_localSpeciesOrder = utils::reverseCuthillMcKee(numSpecies, symmetricOffsets, symmetricColumns);
+        } else {
+            m_localSpeciesOrder.resize(numSpecies);
+            for (size_t i = 0; i < numSpecies; ++i) {
+                m_localSpeciesOrder[i] = i;
+            }
+        }
+        m_publicToLocalSpecies.assign(numSpecies, 0);
+        for (size_t k = 0; k < numSpecies; ++k) {
+            m_publicToLocalSpecies[m_localSpeciesOrder[k]] = k;
+        }
+
+        // --- Switch the precomputed reactions to local indices and group them by the species they touch ---
+        std::vector<std::pair<size_t, size_t>> speciesSpan(m_reactions.size()); // (first, last) local species touched, by reaction index
+        for (auto& precomp : m_precomputedReactions) {
+            size_t first = numSpecies, last = 0;
+            for (auto& index : precomp.unique_reactant_indices) {
+                index = m_publicToLocalSpecies[index];
+                first = std::min(first, index);
+                last = std::max(last, index);
+            }
+            for (auto& index : precomp.affected_species_indices) {
+                index = m_publicToLocalSpecies[index];
+                first = std::min(first, index);
+                last = std::max(last, index);
+            }
+            speciesSpan[precomp.reaction_index] = {first, last};
+        }
+        std::ranges::stable_sort(m_precomputedReactions, [&speciesSpan](const PrecomputedReaction& a, const PrecomputedReaction& b) {
+            return speciesSpan[a.reaction_index] < speciesSpan[b.reaction_index];
+        });
+
+        // --- Species-to-reaction adjacency (CSR), the transpose of the affected species lists ---
+        m_speciesReactionOffsets.assign(numSpecies + 1, 0);
+        for (const auto& precomp : m_precomputedReactions) {
+            for (const size_t speciesIndex : precomp.affected_species_indices) {
+                ++m_speciesReactionOffsets[speciesIndex + 1];
+            }
+        }
+        for (size_t i = 0; i < numSpecies; ++i) {
+            m_speciesReactionOffsets[i + 1] += m_speciesReactionOffsets[i];
+        }
+
+        m_speciesReactionIndices.resize(m_speciesReactionOffsets.back());
+        m_speciesReactionCoefficients.resize(m_speciesReactionOffsets.back());
+        std::vector<size_t> fill(m_speciesReactionOffsets.begin(), m_speciesReactionOffsets.end() - 1);
+        for (size_t j = 0; j < m_precomputedReactions.size(); ++j) {
+            const auto& precomp = m_precomputedReactions[j];
+            for (size_t i = 0; i < precomp.affected_species_indices.size(); ++i) {
+                const size_t slot = fill[precomp.affected_species_indices[i]]++;
+                m_speciesReactionIndices[slot] = j;
+                m_speciesReactionCoefficients[slot] = precomp.stoichiometric_coefficients[i];
+            }
+        }
+    }
+
+    std::vector<double> GraphEngine::toLocalSpeciesOrder(const std::vector<double> &Y) const {
+        std::vector<double> Y_local(m_localSpeciesOrder.size());
+        for (size_t k = 0; k < m_localSpeciesOrder.size(); ++k) {
+            Y_local[k] = Y[m_localSpeciesOrder[k]];
+        }
+        return Y_local;
     }
 }
@@ -1,7 +1,9 @@
 #include "../../../include/gridfire/engine/views/engine_adaptive.h"
 
 #include <ranges>
-#include <queue>
+#include <algorithm>
+#include <memory>
+#include <iterator>
 
 #include "gridfire/network.h"
 
@@ -17,28 +19,21 @@ namespace gridfire {
     m_activeSpecies(baseEngine.getNetworkSpecies()),
     m_activeReactions(baseEngine.getNetworkReactions()),
     m_speciesIndexMap(constructSpeciesIndexMap()),
-    m_reactionIndexMap(constructReactionIndexMap())
+    m_reactionIndexMap(constructReactionIndexMap()),
+    m_hypergraph(m_activeSpecies, m_activeReactions)
     {
     }
 
     std::vector<size_t> AdaptiveEngineView::constructSpeciesIndexMap() const {
         LOG_TRACE_L1(m_logger, "Constructing species index map for adaptive engine view...");
-        std::unordered_map<Species, size_t> fullSpeciesReverseMap;
-        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
-
-        fullSpeciesReverseMap.reserve(fullSpeciesList.size());
-
-        for (size_t i = 0; i < fullSpeciesList.size(); ++i) {
-            fullSpeciesReverseMap[fullSpeciesList[i]] = i;
-        }
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
 
         std::vector<size_t> speciesIndexMap;
         speciesIndexMap.reserve(m_activeSpecies.size());
 
         for (const auto& active_species : m_activeSpecies) {
-            auto it = fullSpeciesReverseMap.find(active_species);
-            if (it != fullSpeciesReverseMap.end()) {
-                speciesIndexMap.push_back(it->second);
+            if (fullHypergraph.containsSpecies(active_species)) {
+                speciesIndexMap.push_back(fullHypergraph.speciesIndex(active_species));
             } else {
                 LOG_ERROR(m_logger, "Species '{}' not found in full species map.", active_species.name());
                 m_logger -> flush_log();
@@ -97,16 +92,42 @@ namespace gridfire {
         }
         LOG_DEBUG(m_logger, "Maximum reaction flow rate in adaptive engine view: {:0.3E} [mol/s]", maxFlow);
 
-        const std::unordered_set<Species> reachableSpecies = findReachableSpecies(netIn);
-        LOG_DEBUG(m_logger, "Found {} reachable species in adaptive engine view.", reachableSpecies.size());
-
-        const std::vector<const reaction::LogicalReaction*> finalReactions = cullReactionsByFlow(allFlows, reachableSpecies, Y_Full, maxFlow);
+        const std::vector<bool> reachableSpecies = findReachableSpecies(netIn);
+        LOG_DEBUG(m_logger, "Found {} reachable species in adaptive engine view.", std::ranges::count(reachableSpecies, true));
 
-        finalizeActiveSet(finalReactions);
+        const std::vector<size_t> finalReactionIndices = cullReactionsByFlow(allFlows, reachableSpecies, Y_Full, maxFlow);
 
+        if (m_isStale) {
+            finalizeActiveSet(finalReactionIndices);
+        } else {
+            // --- Diff against the current active set; a stable network needs no rebuild ---
+            std::vector<size_t> currentReactionIndices = m_reactionIndexMap;
+            std::ranges::sort(currentReactionIndices);
+            std::vector<size_t> added;
+            std::vector<size_t> dropped;
+            std::ranges::set_difference(finalReactionIndices, currentReactionIndices, std::back_inserter(added));
+            std::ranges::set_difference(currentReactionIndices, finalReactionIndices, std::back_inserter(dropped));
+            if (added.empty() && dropped.empty()) {
+                LOG_DEBUG(m_logger, "Active reaction set of adaptive engine view is unchanged ({} reactions); skipping rebuild.", m_reactionIndexMap.size());
+                return;
+            }
+            LOG_DEBUG(m_logger, "Adaptive engine view active set changed: {} reactions added, {} dropped.", added.size(), dropped.size());
+            applyActiveSetDelta(added, dropped);
+        }
+        m_hypergraph = utils::NetworkHypergraph(m_activeSpecies, m_activeReactions);
 
-        m_speciesIndexMap = constructSpeciesIndexMap();
-        m_reactionIndexMap = constructReactionIndexMap();
+        if (m_materializeCompactEngine && m_activeReactions.size() > 0) {
+            if (m_compactEngine && !m_isStale) {
+                updateCompactEngine();
+            } else {
+                materializeCompactEngine();
+            }
+        } else {
+            m_compactEngine.reset();
+            m_compactSpeciesIndexMap.clear();
+            m_compactReactionIndexMap.clear();
+        }
+        ++m_indexMapGeneration;
 
         m_isStale = false;
 
@@ -124,6 +145,11 @@ namespace gridfire {
     ) const {
         validateState();
 
+        if (m_compactEngine) {
+            const auto [dydt, nuclearEnergyGenerationRate] = compactEngine().calculateRHSAndEnergy(mapCulledToCompact(Y_culled), T9, rho);
+            return {mapCompactToCulled(dydt), nuclearEnergyGenerationRate};
+        }
+
         const auto Y_full = mapCulledToFull(Y_culled);
 
         const auto [dydt, nuclearEnergyGenerationRate] = m_baseEngine.calculateRHSAndEnergy(Y_full, T9, rho);
@@ -135,12 +161,73 @@ namespace gridfire {
         return culledResults;
     }
 
+    std::vector<double> AdaptiveEngineView::calculateRHSSubset(
+        const std::vector<double> &Y_culled,
+        const std::vector<size_t> &speciesIndices,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+
+        if (m_compactEngine) {
+            std::vector<size_t> speciesIndices_compact;
+            speciesIndices_compact.reserve(speciesIndices.size());
+            for (const size_t i_culled : speciesIndices) {
+                speciesIndices_compact.push_back(m_compactSpeciesIndexMap.at(i_culled));
+            }
+            return compactEngine().calculateRHSSubset(mapCulledToCompact(Y_culled), speciesIndices_compact, T9, rho);
+        }
+
+        const auto Y_full = mapCulledToFull(Y_culled);
+
+        std::vector<size_t> speciesIndices_full;
+        speciesIndices_full.reserve(speciesIndices.size());
+        for (const size_t i_culled : speciesIndices) {
+            speciesIndices_full.push_back(mapCulledToFullSpeciesIndex(i_culled));
+        }
+
+        return m_baseEngine.calculateRHSSubset(Y_full, speciesIndices_full, T9, rho);
+    }
+
+    std::vector<double> AdaptiveEngineView::calculateJacobianSubset(
+        const std::vector<double> &Y_culled,
+        const std::vector<size_t> &speciesIndices,
+        const utils::SparsityPattern &pattern,
+        const double T9,
+        const double rho
+    ) {
+        validateState();
+
+        if (m_compactEngine) {
+            std::vector<size_t> speciesIndices_compact;
+            speciesIndices_compact.reserve(speciesIndices.size());
+            for (const size_t i_culled : speciesIndices) {
+                speciesIndices_compact.push_back(m_compactSpeciesIndexMap.at(i_culled));
+            }
+            return compactEngine().calculateJacobianSubset(mapCulledToCompact(Y_culled), speciesIndices_compact, pattern, T9, rho);
+        }
+
+        const auto Y_full = mapCulledToFull(Y_culled);
+
+        std::vector<size_t> speciesIndices_full;
+        speciesIndices_full.reserve(speciesIndices.size());
+        for (const size_t i_culled : speciesIndices) {
+            speciesIndices_full.push_back(mapCulledToFullSpeciesIndex(i_culled));
+        }
+
+        return m_baseEngine.calculateJacobianSubset(Y_full, speciesIndices_full, pattern, T9, rho);
+    }
+
     void AdaptiveEngineView::generateJacobianMatrix(
         const std::vector<double> &Y_culled,
         const double T9,
         const double rho
     ) {
         validateState();
+        if (m_compactEngine) {
+            compactEngine().generateJacobianMatrix(mapCulledToCompact(Y_culled), T9, rho);
+            return;
+        }
         const auto Y_full = mapCulledToFull(Y_culled);
 
         m_baseEngine.generateJacobianMatrix(Y_full, T9, rho);
@@ -151,14 +238,52 @@ namespace gridfire {
         const int j_culled
     ) const {
         validateState();
+        if (m_compactEngine) {
+            return compactEngine().getJacobianMatrixEntry(
+                static_cast<int>(m_compactSpeciesIndexMap.at(i_culled)),
+                static_cast<int>(m_compactSpeciesIndexMap.at(j_culled))
+            );
+        }
         const size_t i_full = mapCulledToFullSpeciesIndex(i_culled);
         const size_t j_full = mapCulledToFullSpeciesIndex(j_culled);
 
         return m_baseEngine.getJacobianMatrixEntry(i_full, j_full);
     }
 
+    utils::BlockOrdering AdaptiveEngineView::getJacobianBlockOrdering() const {
+        validateState();
+        if (m_compactEngine) {
+            return utils::restrictBlockOrdering(compactEngine().getJacobianBlockOrdering(), m_compactSpeciesIndexMap);
+        }
+        return utils::restrictBlockOrdering(m_baseEngine.getJacobianBlockOrdering(), m_speciesIndexMap);
+    }
+
+    utils::SparsityPattern AdaptiveEngineView::getJacobianSparsityPattern() const {
+        validateState();
+        if (m_compactEngine) {
+            return utils::restrictSparsityPattern(compactEngine().getJacobianSparsityPattern(), m_compactSpeciesIndexMap, m_compactSpeciesIndexMap);
+        }
+        return utils::restrictSparsityPattern(m_baseEngine.getJacobianSparsityPattern(), m_speciesIndexMap, m_speciesIndexMap);
+    }
+
+    const utils::NetworkHypergraph& AdaptiveEngineView::getNetworkHypergraph() const {
+        return m_hypergraph;
+    }
+
+    utils::SparsityPattern AdaptiveEngineView::getStoichiometrySparsityPattern() const {
+        validateState();
+        if (m_compactEngine) {
+            return utils::restrictSparsityPattern(compactEngine().getStoichiometrySparsityPattern(), m_compactSpeciesIndexMap, m_compactReactionIndexMap);
+        }
+        return utils::restrictSparsityPattern(m_baseEngine.getStoichiometrySparsityPattern(), m_speciesIndexMap, m_reactionIndexMap);
+    }
+
     void AdaptiveEngineView::generateStoichiometryMatrix() {
         validateState();
+        if (m_compactEngine) {
+            compactEngine().generateStoichiometryMatrix();
+            return;
+        }
         m_baseEngine.generateStoichiometryMatrix();
     }
 
@@ -167,6 +292,12 @@ namespace gridfire {
         const int reactionIndex_culled
     ) const {
         validateState();
+        if (m_compactEngine) {
+            return compactEngine().getStoichiometryMatrixEntry(
+                static_cast<int>(m_compactSpeciesIndexMap.at(speciesIndex_culled)),
+                static_cast<int>(m_compactReactionIndexMap.at(reactionIndex_culled))
+            );
+        }
         const size_t speciesIndex_full = mapCulledToFullSpeciesIndex(speciesIndex_culled);
         const size_t reactionIndex_full = mapCulledToFullReactionIndex(reactionIndex_culled);
         return m_baseEngine.getStoichiometryMatrixEntry(speciesIndex_full, reactionIndex_full);
@@ -184,11 +315,34 @@ namespace gridfire {
             m_logger -> flush_log();
             throw std::runtime_error("Reaction not found in active reactions: " + std::string(reaction.id()));
         }
+        if (m_compactEngine) {
+            return compactEngine().calculateMolarReactionFlow(reaction, mapCulledToCompact(Y_culled), T9, rho);
+        }
         const auto Y = mapCulledToFull(Y_culled);
 
         return m_baseEngine.calculateMolarReactionFlow(reaction, Y, T9, rho);
     }
 
+    std::vector<double> AdaptiveEngineView::calculateAllMolarReactionFlows(
+        const std::vector<double> &Y_culled,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        const bool compact = m_compactEngine != nullptr;
+        const auto mappedFlows = compact ?
+            compactEngine().calculateAllMolarReactionFlows(mapCulledToCompact(Y_culled), T9, rho) :
+            m_baseEngine.calculateAllMolarReactionFlows(mapCulledToFull(Y_culled), T9, rho);
+        const auto& reactionIndexMap = compact ? m_compactReactionIndexMap : m_reactionIndexMap;
+
+        std::vector<double> flows;
+        flows.reserve(reactionIndexMap.size());
+        for (const size_t j_mapped : reactionIndexMap) {
+            flows.push_back(mappedFlows[j_mapped]);
+        }
+        return flows;
+    }
+
     const reaction::LogicalReactionSet & AdaptiveEngineView::getNetworkReactions() const {
         return m_activeReactions;
     }
@@ -199,8 +353,10 @@ namespace gridfire {
         const double rho
     ) const {
         validateState();
-        const auto Y_full = mapCulledToFull(Y_culled);
-        const auto fullTimescales = m_baseEngine.getSpeciesTimescales(Y_full, T9, rho);
+        // The compact engine may hold masked species outside the active set, so both paths are filtered
+        const auto fullTimescales = m_compactEngine ?
+            compactEngine().getSpeciesTimescales(mapCulledToCompact(Y_culled), T9, rho) :
+            m_baseEngine.getSpeciesTimescales(mapCulledToFull(Y_culled), T9, rho);
 
         std::unordered_map<Species, double> culledTimescales;
         culledTimescales.reserve(m_activeSpecies.size());
@@ -215,12 +371,36 @@ namespace gridfire {
 
     void AdaptiveEngineView::setScreeningModel(const screening::ScreeningType model) {
         m_baseEngine.setScreeningModel(model);
+        if (m_compactEngine) {
+            m_compactEngine->setScreeningModel(model);
+        }
     }
 
     screening::ScreeningType AdaptiveEngineView::getScreeningModel() const {
         return m_baseEngine.getScreeningModel();
     }
 
+    uint64_t AdaptiveEngineView::getRateMultiplierGeneration() const {
+        return m_baseEngine.getRateMultiplierGeneration();
+    }
+
+    std::vector<double> AdaptiveEngineView::getRateMultipliers() const {
+        validateState();
+
+        const auto fullMultipliers = m_baseEngine.getRateMultipliers();
+        std::vector<double> multipliers;
+        multipliers.reserve(m_reactionIndexMap.size());
+        for (const size_t i_full : m_reactionIndexMap) {
+            multipliers.push_back(fullMultipliers[i_full]);
+        }
+        return multipliers;
+    }
+
+    void AdaptiveEngineView::setCompactEngineMaterialization(const bool materialize) {
+        m_materializeCompactEngine = materialize;
+        m_isStale = true;
+    }
+
     std::vector<double> AdaptiveEngineView::mapCulledToFull(const std::vector<double>& culled) const {
         std::vector<double> full(m_baseEngine.getNetworkSpecies().size(), 0.0);
         for (size_t i_culled = 0; i_culled < culled.size(); ++i_culled) {
@@ -239,6 +419,123 @@ namespace gridfire {
         return culled;
     }
 
+    void AdaptiveEngineView::materializeCompactEngine() {
+        LOG_TRACE_L1(m_logger, "Materializing compact engine over {} active reactions...", m_activeReactions.size());
+        m_compactEngine = std::make_unique<GraphEngine>(m_activeReactions);
+        m_compactEngine->setScreeningModel(m_baseEngine.getScreeningModel());
+
+        // --- Compact index of each base engine species and reaction ---
+        const utils::NetworkHypergraph& compactHypergraph = m_compactEngine->getNetworkHypergraph();
+        m_compactSpeciesOfBase.assign(m_baseEngine.getNetworkSpecies().size(), NOT_IN_COMPACT_ENGINE);
+        for (size_t i_culled = 0; i_culled < m_activeSpecies.size(); ++i_culled) {
+            const auto& active_species = m_activeSpecies[i_culled];
+            if (!compactHypergraph.containsSpecies(active_species)) {
+                LOG_ERROR(m_logger, "Active species '{}' not found in the compact engine.", active_species.name());
+                m_logger->flush_log();
+                throw std::runtime_error("Active species not found in the compact engine: " + std::string(active_species.name()));
+            }
+            m_compactSpeciesOfBase[m_speciesIndexMap[i_culled]] = compactHypergraph.speciesIndex(active_species);
+        }
+        // The compact engine is built from m_activeReactions, so the reaction orders agree
+        m_compactReactionOfBase.assign(m_baseEngine.getNetworkReactions().size(), NOT_IN_COMPACT_ENGINE);
+        for (size_t j_culled = 0; j_culled < m_reactionIndexMap.size(); ++j_culled) {
+            m_compactReactionOfBase[m_reactionIndexMap[j_culled]] = j_culled;
+        }
+
+        mapActiveSetToCompactEngine();
+        LOG_DEBUG(m_logger, "Compact engine materialized with {} species and {} reactions.", m_compactEngine->getNetworkSpecies().size(), m_activeReactions.size());
+    }
+
+    void AdaptiveEngineView::updateCompactEngine() {
+        const auto maxMaskedFraction = m_config.get<double>("gridfire:AdaptiveEngineView:MaxMaskedReactionFraction", 0.5);
+
+        const size_t numCompactReactions = m_compactEngine->getNetworkReactions().size();
+        const double maskedFraction = 1.0 - static_cast<double>(m_activeReactions.size()) / static_cast<double>(numCompactReactions);
+        if (maskedFraction <= maxMaskedFraction && mapActiveSetToCompactEngine()) {
+            LOG_DEBUG(m_logger, "Compact engine patched in place; {} of its {} reactions are masked.",
+                numCompactReactions - m_activeReactions.size(), numCompactReactions);
+            return;
+        }
+
+        LOG_DEBUG(m_logger, "Active set no longer fits the compact engine (masked fraction {:0.2f}); re-materializing it.", maskedFraction);
+        materializeCompactEngine();
+    }
+
+    bool AdaptiveEngineView::mapActiveSetToCompactEngine() {
+        m_compactSpeciesIndexMap.clear();
+        m_compactSpeciesIndexMap.reserve(m_speciesIndexMap.size());
+        for (const size_t i_full : m_speciesIndexMap) {
+            const size_t i_compact = m_compactSpeciesOfBase[i_full];
+            if (i_compact == NOT_IN_COMPACT_ENGINE) {
+                return false;
+            }
+            m_compactSpeciesIndexMap.push_back(i_compact);
+        }
+
+        m_compactReactionIndexMap.clear();
+        m_compactReactionIndexMap.reserve(m_reactionIndexMap.size());
+        for (const size_t j_full : m_reactionIndexMap) {
+            const size_t j_compact = m_compactReactionOfBase[j_full];
+            if (j_compact == NOT_IN_COMPACT_ENGINE) {
+                return false;
+            }
+            m_compactReactionIndexMap.push_back(j_compact);
+        }
+
+        applyCompactRateMultipliers();
+        return true;
+    }
+
+    void AdaptiveEngineView::applyCompactRateMultipliers() const {
+        // --- Carry the base engine's rate multipliers over; m_reactionIndexMap was matched by reaction id ---
+        m_compactMultiplierGeneration = m_baseEngine.getRateMultiplierGeneration();
+        const auto fullMultipliers = m_baseEngine.getRateMultipliers();
+        std::vector<double> compactMultipliers(m_compactEngine->getNetworkReactions().size(), 0.0); // Inactive reactions are masked out
+        for (size_t j_culled = 0; j_culled < m_reactionIndexMap.size(); ++j_culled) {
+            compactMultipliers[m_compactReactionIndexMap[j_culled]] = fullMultipliers[m_reactionIndexMap[j_culled]];
+        }
+        m_compactEngine->setRateMultipliers(compactMultipliers);
+    }
+
+    GraphEngine& AdaptiveEngineView::compactEngine() const {
+        if (m_compactMultiplierGeneration != m_baseEngine.getRateMultiplierGeneration()) {
+            LOG_TRACE_L1(m_logger, "Rate multipliers of the base engine changed; re-applying them to the compact engine.");
+            applyCompactRateMultipliers();
+        }
+        return *m_compactEngine;
+    }
+
+    DynamicEngine& AdaptiveEngineView::getMappedEngine() const {
+        if (m_compactEngine) {
+            return compactEngine();
+        }
+        return m_baseEngine;
+    }
+
+    const std::vector<size_t>& AdaptiveEngineView::getSpeciesIndexMap() const {
+        return m_compactEngine ? m_compactSpeciesIndexMap : m_speciesIndexMap;
+    }
+
+    const std::vector<size_t>& AdaptiveEngineView::getReactionIndexMap() const {
+        return m_compactEngine ? m_compactReactionIndexMap : m_reactionIndexMap;
+    }
+
+    std::vector<double> AdaptiveEngineView::mapCulledToCompact(const std::vector<double>& culled) const {
+        std::vector<double> compact(m_compactEngine->getNetworkSpecies().size(), 0.0);
+        for (size_t i_culled = 0; i_culled < culled.size(); ++i_culled) {
+            compact[m_compactSpeciesIndexMap[i_culled]] = culled[i_culled];
+        }
+        return compact;
+    }
+
+    std::vector<double> AdaptiveEngineView::mapCompactToCulled(const std::vector<double>& compact) const {
+        std::vector<double> culled(m_activeSpecies.size(), 0.0);
+        for (size_t i_culled = 0; i_culled < m_activeSpecies.size(); ++i_culled) {
+            culled[i_culled] = compact[m_compactSpeciesIndexMap[i_culled]];
+        }
+        return culled;
+    }
+
     size_t AdaptiveEngineView::mapCulledToFullSpeciesIndex(size_t culledSpeciesIndex) const {
         if (culledSpeciesIndex < 0 || culledSpeciesIndex >= static_cast<int>(m_speciesIndexMap.size())) {
             LOG_ERROR(m_logger, "Culled index {} is out of bounds for species index map of size {}.", culledSpeciesIndex, m_speciesIndexMap.size());
@@ -285,84 +582,78 @@ namespace gridfire {
         const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
         const double rho = netIn.density; // Density in g/cm^3
 
+        const std::vector<double> flows = m_baseEngine.calculateAllMolarReactionFlows(out_Y_Full, T9, rho);
+
         std::vector<ReactionFlow> reactionFlows;
         const auto& fullReactionSet = m_baseEngine.getNetworkReactions();
         reactionFlows.reserve(fullReactionSet.size());
-        for (const auto& reaction : fullReactionSet) {
-            const double flow = m_baseEngine.calculateMolarReactionFlow(reaction, out_Y_Full, T9, rho);
+        for (size_t j = 0; j < fullReactionSet.size(); ++j) {
+            const auto& reaction = fullReactionSet[j];
+            const double flow = flows[j];
             reactionFlows.push_back({&reaction, flow});
             LOG_TRACE_L2(m_logger, "Reaction '{}' has flow rate: {:0.3E} [mol/s]", reaction.id(), flow);
         }
         return reactionFlows;
     }
 
-    std::unordered_set<Species> AdaptiveEngineView::findReachableSpecies(
+    std::vector<bool> AdaptiveEngineView::findReachableSpecies(
         const NetIn &netIn
     ) const {
-        std::unordered_set<Species> reachable;
-        std::queue<Species> to_vist;
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
+        std::vector<size_t> fuel;
 
         constexpr double ABUNDANCE_FLOOR = 1e-12; // Abundance floor for a species to be considered part of the initial fuel
-        for (const auto& species: m_baseEngine.getNetworkSpecies()) {
+        for (size_t i = 0; i < fullSpeciesList.size(); ++i) {
+            const auto& species = fullSpeciesList[i];
             if (netIn.composition.contains(species) && netIn.composition.getMassFraction(std::string(species.name())) > ABUNDANCE_FLOOR) {
-                if (!reachable.contains(species)) {
-                    to_vist.push(species);
-                    reachable.insert(species);
-                    LOG_TRACE_L2(m_logger, "Network Connectivity Analysis: Species '{}' is part of the initial fuel.", species.name());
-                }
+                fuel.push_back(i);
+                LOG_TRACE_L2(m_logger, "Network Connectivity Analysis: Species '{}' is part of the initial fuel.", species.name());
             }
         }
 
-        bool new_species_found_in_pass = true;
-        while (new_species_found_in_pass) {
-            new_species_found_in_pass = false;
-            for (const auto& reaction: m_baseEngine.getNetworkReactions()) {
-                bool all_reactants_reachable = true;
-                for (const auto& reactant: reaction.reactants()) {
-                    if (!reachable.contains(reactant)) {
-                        all_reactants_reachable = false;
-                        break;
-                    }
-                }
-                if (all_reactants_reachable) {
-                    for (const auto& product: reaction.products()) {
-                        if (!reachable.contains(product)) {
-                            reachable.insert(product);
-                            new_species_found_in_pass = true;
-                            LOG_TRACE_L2(m_logger, "Network Connectivity Analysis: Species '{}' is reachable via reaction '{}'.", product.name(), reaction.id());
-                        }
-                    }
-                }
-            }
-        }
-
-        return reachable;
+        return fullHypergraph.reachableFrom(fuel);
     }
 
-    std::vector<const reaction::LogicalReaction *> AdaptiveEngineView::cullReactionsByFlow(
+    std::vector<size_t> AdaptiveEngineView::cullReactionsByFlow(
         const std::vector<ReactionFlow> &allFlows,
-        const std::unordered_set<fourdst::atomic::Species> &reachableSpecies,
+        const std::vector<bool> &reachableSpecies,
         const std::vector<double> &Y_full,
         const double maxFlow
     ) const {
         LOG_TRACE_L1(m_logger, "Culling reactions based on flow rates...");
         const auto relative_culling_threshold = m_config.get<double>("gridfire:AdaptiveEngineView:RelativeCullingThreshold", 1e-75);
+        const auto relative_drop_threshold = m_config.get<double>("gridfire:AdaptiveEngineView:RelativeDropThreshold", 1e-2 * relative_culling_threshold);
         double absoluteCullingThreshold = relative_culling_threshold * maxFlow;
-        LOG_DEBUG(m_logger, "Relative culling threshold: {:0.3E} ({})", relative_culling_threshold, absoluteCullingThreshold);
-        std::vector<const reaction::LogicalReaction*> culledReactions;
-        for (const auto& [reactionPtr, flowRate]: allFlows) {
+        double absoluteDropThreshold = relative_drop_threshold * maxFlow;
+        LOG_DEBUG(m_logger, "Relative culling threshold: {:0.3E} ({}), relative drop threshold: {:0.3E} ({})", relative_culling_threshold, absoluteCullingThreshold, relative_drop_threshold, absoluteDropThreshold);
+
+        // Reactions already active are only dropped once their flow falls below the lower drop
+        // threshold, so reactions hovering around the culling threshold do not flap in and out.
+        std::vector<bool> currentlyActive(allFlows.size(), false);
+        if (!m_isStale) {
+            for (const size_t j : m_reactionIndexMap) {
+                currentlyActive[j] = true;
+            }
+        }
+
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+        std::vector<size_t> culledReactions;
+        for (size_t j = 0; j < allFlows.size(); ++j) {
+            const auto& [reactionPtr, flowRate] = allFlows[j];
             bool keepReaction = false;
             if (flowRate > absoluteCullingThreshold) {
                 LOG_TRACE_L2(m_logger, "Maintaining reaction '{}' with relative (abs) flow rate: {:0.3E} ({:0.3E} [mol/s])", reactionPtr->id(), flowRate/maxFlow, flowRate);
                 keepReaction = true;
+            } else if (currentlyActive[j] && flowRate > absoluteDropThreshold) {
+                LOG_TRACE_L2(m_logger, "Maintaining active reaction '{}' above the drop threshold with relative (abs) flow rate: {:0.3E} ({:0.3E} [mol/s])", reactionPtr->id(), flowRate/maxFlow, flowRate);
+                keepReaction = true;
             } else {
                 bool zero_flow_due_to_reachable_reactants = false;
                 if (flowRate < 1e-99) {
-                    for (const auto& reactant: reactionPtr->reactants()) {
-                        const auto it = std::ranges::find(m_baseEngine.getNetworkSpecies(), reactant);
-                        const size_t index = std::distance(m_baseEngine.getNetworkSpecies().begin(), it);
-                        if (Y_full[index] < 1e-99 && reachableSpecies.contains(reactant)) {
-                            LOG_TRACE_L2(m_logger, "Maintaining reaction '{}' with zero flow due to reachable reactant '{}'.", reactionPtr->id(), reactant.name());
+                    for (const size_t index : fullHypergraph.reactants(j)) {
+                        if (Y_full[index] < 1e-99 && reachableSpecies[index]) {
+                            LOG_TRACE_L2(m_logger, "Maintaining reaction '{}' with zero flow due to reachable reactant '{}'.", reactionPtr->id(), m_baseEngine.getNetworkSpecies()[index].name());
                             zero_flow_due_to_reachable_reactants = true;
                             break;
                         }
@@ -373,7 +664,7 @@ namespace gridfire {
                 }
             }
             if (keepReaction) {
-                culledReactions.push_back(reactionPtr);
+                culledReactions.push_back(j);
             } else {
                 LOG_TRACE_L1(m_logger, "Culling reaction '{}' due to low flow rate or lack of connectivity.", reactionPtr->id());
             }
@@ -383,24 +674,115 @@ namespace gridfire {
     }
 
     void AdaptiveEngineView::finalizeActiveSet(
-        const std::vector<const reaction::LogicalReaction *> &finalReactions
+        const std::vector<size_t> &finalReactionIndices
     ) {
-        std::unordered_set<Species>finalSpeciesSet;
+        const auto& fullReactionSet = m_baseEngine.getNetworkReactions();
+        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+
+        // Index maps follow directly from the base engine indices; no species or reaction lookups by name
+        m_speciesReactionCount.assign(fullSpeciesList.size(), 0);
         m_activeReactions.clear();
-        for (const auto* reactionPtr: finalReactions) {
-            m_activeReactions.add_reaction(*reactionPtr);
-            for (const auto& reactant : reactionPtr->reactants()) {
-                finalSpeciesSet.insert(reactant);
+        for (const size_t j : finalReactionIndices) {
+            m_activeReactions.add_reaction(fullReactionSet[j]);
+            for (const size_t i : fullHypergraph.reactants(j)) {
+                ++m_speciesReactionCount[i];
             }
-            for (const auto& product : reactionPtr->products()) {
-                finalSpeciesSet.insert(product);
+            for (const size_t i : fullHypergraph.products(j)) {
+                ++m_speciesReactionCount[i];
             }
         }
-        m_activeSpecies.assign(finalSpeciesSet.begin(), finalSpeciesSet.end());
-        std::ranges::sort(
-            m_activeSpecies,
-            [](const Species &a, const Species &b) { return a.mass() < b.mass(); }
-        );
+        m_reactionIndexMap = finalReactionIndices;
+
+        m_speciesIndexMap.clear();
+        for (size_t i = 0; i < fullSpeciesList.size(); ++i) {
+            if (m_speciesReactionCount[i] > 0) {
+                m_speciesIndexMap.push_back(i);
+            }
+        }
+        std::ranges::sort(m_speciesIndexMap, [this](const size_t a, const size_t b) { return activeSpeciesBefore(a, b); });
+        m_activeSpecies.clear();
+        m_activeSpecies.reserve(m_speciesIndexMap.size());
+        for (const size_t i : m_speciesIndexMap) {
+            m_activeSpecies.push_back(fullSpeciesList[i]);
+        }
     }
-}
 
+    void AdaptiveEngineView::applyActiveSetDelta(
+        const std::vector<size_t> &added,
+        const std::vector<size_t> &dropped
+    ) {
+        const auto& fullReactionSet = m_baseEngine.getNetworkReactions();
+        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+
+        // --- Species of the changed reactions, the only ones which can enter or leave ---
+        std::vector<size_t> touchedSpecies;
+        for (const auto& reactions : {added, dropped}) {
+            for (const size_t j : reactions) {
+                std::ranges::copy(fullHypergraph.reactants(j), std::back_inserter(touchedSpecies));
+                std::ranges::copy(fullHypergraph.products(j), std::back_inserter(touchedSpecies));
+            }
+        }
+        std::ranges::sort(touchedSpecies);
+        const auto duplicates = std::ranges::unique(touchedSpecies);
+        touchedSpecies.erase(duplicates.begin(), duplicates.end());
+        std::vector<bool> wasActive(touchedSpecies.size());
+        for (size_t k = 0; k < touchedSpecies.size(); ++k) {
+            wasActive[k] = m_speciesReactionCount[touchedSpecies[k]] > 0;
+        }
+
+        // --- Reactions: dropped ones are erased in place, added ones appended ---
+        for (const size_t j : dropped) {
+            m_activeReactions.remove_reaction(fullReactionSet[j]);
+            for (const size_t i : fullHypergraph.reactants(j)) {
+                --m_speciesReactionCount[i];
+            }
+            for (const size_t i : fullHypergraph.products(j)) {
+                --m_speciesReactionCount[i];
+            }
+        }
+        std::erase_if(m_reactionIndexMap, [&dropped](const size_t j) { return std::ranges::binary_search(dropped, j); });
+        for (const size_t j : added) {
+            m_activeReactions.add_reaction(fullReactionSet[j]);
+            m_reactionIndexMap.push_back(j);
+            for (const size_t i : fullHypergraph.reactants(j)) {
+                ++m_speciesReactionCount[i];
+            }
+            for (const size_t i : fullHypergraph.products(j)) {
+                ++m_speciesReactionCount[i];
+            }
+        }
+
+        // --- Species: erase those no longer in any active reaction, insert new ones in mass order ---
+        size_t kept = 0;
+        for (size_t k = 0; k < m_speciesIndexMap.size(); ++k) {
+            if (m_speciesReactionCount[m_speciesIndexMap[k]] > 0) {
+                m_speciesIndexMap[kept] = m_speciesIndexMap[k];
+                m_activeSpecies[kept] = m_activeSpecies[k];
+                ++kept;
+            }
+        }
+        m_speciesIndexMap.resize(kept);
+        m_activeSpecies.erase(m_activeSpecies.begin() + static_cast<std::ptrdiff_t>(kept), m_activeSpecies.end());
+
+        for (size_t k = 0; k < touchedSpecies.size(); ++k) {
+            const size_t i = touchedSpecies[k];
+            if (m_speciesReactionCount[i] > 0 && !wasActive[k]) {
+                const auto position = std::ranges::upper_bound(
+                    m_speciesIndexMap, i, [this](const size_t a, const size_t b) { return activeSpeciesBefore(a, b); }
+                );
+                const auto offset = std::distance(m_speciesIndexMap.begin(), position);
+                m_speciesIndexMap.insert(position, i);
+                m_activeSpecies.insert(m_activeSpecies.begin() + offset, fullSpeciesList[i]);
+            }
+        }
+    }
+
+    bool AdaptiveEngineView::activeSpeciesBefore(const size_t a, const size_t b) const {
+        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
+        const double massA = fullSpeciesList[a].mass();
+        const double massB = fullSpeciesList[b].mass();
+        return massA != massB ? massA < massB : a < b;
+    }
+}
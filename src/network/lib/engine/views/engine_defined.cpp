@@ -2,6 +2,14 @@
 
 #include "quill/LogMacros.h"
 
+#include <algorithm>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 namespace gridfire {
     using fourdst::atomic::Species;
 
@@ -22,6 +30,20 @@ namespace gridfire {
         return m_baseEngine;
     }
 
+    DynamicEngine & FileDefinedEngineView::getMappedEngine() const {
+        return m_baseEngine;
+    }
+
+    const std::vector<size_t> & FileDefinedEngineView::getSpeciesIndexMap() const {
+        validateNetworkState();
+        return m_speciesIndexMap;
+    }
+
+    const std::vector<size_t> & FileDefinedEngineView::getReactionIndexMap() const {
+        validateNetworkState();
+        return m_reactionIndexMap;
+    }
+
     const std::vector<Species> & FileDefinedEngineView::getNetworkSpecies() const {
         return m_activeSpecies;
     }
@@ -42,6 +64,45 @@ namespace gridfire {
         return definedResults;
     }
 
+    std::vector<double> FileDefinedEngineView::calculateRHSSubset(
+        const std::vector<double> &Y_defined,
+        const std::vector<size_t> &speciesIndices,
+        const double T9,
+        const double rho
+    ) const {
+        validateNetworkState();
+
+        const auto Y_full = mapViewToFull(Y_defined);
+
+        std::vector<size_t> speciesIndices_full;
+        speciesIndices_full.reserve(speciesIndices.size());
+        for (const size_t i_defined : speciesIndices) {
+            speciesIndices_full.push_back(mapViewToFullSpeciesIndex(i_defined));
+        }
+
+        return m_baseEngine.calculateRHSSubset(Y_full, speciesIndices_full, T9, rho);
+    }
+
+    std::vector<double> FileDefinedEngineView::calculateJacobianSubset(
+        const std::vector<double> &Y_defined,
+        const std::vector<size_t> &speciesIndices,
+        const utils::SparsityPattern &pattern,
+        const double T9,
+        const double rho
+    ) {
+        validateNetworkState();
+
+        const auto Y_full = mapViewToFull(Y_defined);
+
+        std::vector<size_t> speciesIndices_full;
+        speciesIndices_full.reserve(speciesIndices.size());
+        for (const size_t i_defined : speciesIndices) {
+            speciesIndices_full.push_back(mapViewToFullSpeciesIndex(i_defined));
+        }
+
+        return m_baseEngine.calculateJacobianSubset(Y_full, speciesIndices_full, pattern, T9, rho);
+    }
+
     void FileDefinedEngineView::generateJacobianMatrix(
         const std::vector<double> &Y_defined,
         const double T9,
@@ -65,6 +126,26 @@ namespace gridfire {
         return m_baseEngine.getJacobianMatrixEntry(i_full, j_full);
     }
 
+    utils::BlockOrdering FileDefinedEngineView::getJacobianBlockOrdering() const {
+        validateNetworkState();
+        return utils::restrictBlockOrdering(m_baseEngine.getJacobianBlockOrdering(), m_speciesIndexMap);
+    }
+
+    utils::SparsityPattern FileDefinedEngineView::getJacobianSparsityPattern() const {
+        validateNetworkState();
+        return utils::restrictSparsityPattern(m_baseEngine.getJacobianSparsityPattern(), m_speciesIndexMap, m_speciesIndexMap);
+    }
+
+    const utils::NetworkHypergraph& FileDefinedEngineView::getNetworkHypergraph() const {
+        validateNetworkState();
+        return m_hypergraph;
+    }
+
+    utils::SparsityPattern FileDefinedEngineView::getStoichiometrySparsityPattern() const {
+        validateNetworkState();
+        return utils::restrictSparsityPattern(m_baseEngine.getStoichiometrySparsityPattern(), m_speciesIndexMap, m_reactionIndexMap);
+    }
+
     void FileDefinedEngineView::generateStoichiometryMatrix() {
         validateNetworkState();
 
@@ -99,6 +180,22 @@ namespace gridfire {
         return m_baseEngine.calculateMolarReactionFlow(reaction, Y_full, T9, rho);
     }
 
+    std::vector<double> FileDefinedEngineView::calculateAllMolarReactionFlows(
+        const std::vector<double> &Y_defined,
+        const double T9,
+        const double rho
+    ) const {
+        validateNetworkState();
+        const auto fullFlows = m_baseEngine.calculateAllMolarReactionFlows(mapViewToFull(Y_defined), T9, rho);
+
+        std::vector<double> flows;
+        flows.reserve(m_reactionIndexMap.size());
+        for (const size_t j_full : m_reactionIndexMap) {
+            flows.push_back(fullFlows[j_full]);
+        }
+        return flows;
+    }
+
     const reaction::LogicalReactionSet & FileDefinedEngineView::getNetworkReactions() const {
         validateNetworkState();
 
@@ -144,6 +241,22 @@ namespace gridfire {
         return m_baseEngine.getScreeningModel();
     }
 
+    std::vector<double> FileDefinedEngineView::getRateMultipliers() const {
+        validateNetworkState();
+
+        const auto fullMultipliers = m_baseEngine.getRateMultipliers();
+        std::vector<double> multipliers;
+        multipliers.reserve(m_reactionIndexMap.size());
+        for (const size_t j_full : m_reactionIndexMap) {
+            multipliers.push_back(fullMultipliers[j_full]);
+        }
+        return multipliers;
+    }
+
+    uint64_t FileDefinedEngineView::getRateMultiplierGeneration() const {
+        return m_baseEngine.getRateMultiplierGeneration();
+    }
+
     std::vector<size_t> FileDefinedEngineView::constructSpeciesIndexMap() const {
         LOG_TRACE_L1(m_logger, "Constructing species index map for file defined engine view...");
         std::unordered_map<Species, size_t> fullSpeciesReverseMap;
@@ -207,7 +320,12 @@ namespace gridfire {
 
     void FileDefinedEngineView::buildFromFile(const std::string &fileName) {
         LOG_TRACE_L1(m_logger, "Building file defined engine view from {}...", fileName);
-        auto [reactionPENames] = m_parser.parse(fileName);
+        const io::ParsedNetworkData parsed = m_parser.parseCached(fileName);
+        if (m_indexMapGeneration > 0 && parsed.contentHash == m_contentHash) {
+            LOG_DEBUG(m_logger, "Network file '{}' has the content the view was built from; keeping the active network.", fileName);
+            m_isStale = false;
+            return;
+        }
 
         m_activeReactions.clear();
         m_activeSpecies.clear();
@@ -215,13 +333,8 @@ namespace gridfire {
         std::unordered_set<Species> seenSpecies;
 
         const auto& fullNetworkReactionSet = m_baseEngine.getNetworkReactions();
-        for (const auto& peName : reactionPENames) {
-            if (!fullNetworkReactionSet.contains(peName)) {
-                LOG_ERROR(m_logger, "Reaction with name '{}' not found in the base engine's network reactions. Aborting...", peName);
-                m_logger->flush_log();
-                throw std::runtime_error("Reaction with name '" + std::string(peName) + "' not found in the base engine's network reactions.");
-            }
-            auto reaction = fullNetworkReactionSet[peName];
+        for (const size_t j_full : selectReactions(parsed)) {
+            const auto& reaction = fullNetworkReactionSet[j_full];
             for (const auto& reactant : reaction.reactants()) {
                 if (!seenSpecies.contains(reactant)) {
                     seenSpecies.insert(reactant);
@@ -261,9 +374,102 @@ namespace gridfire {
         }());
         m_speciesIndexMap = constructSpeciesIndexMap();
         m_reactionIndexMap = constructReactionIndexMap();
+        m_hypergraph = utils::NetworkHypergraph(m_activeSpecies, m_activeReactions);
+        m_contentHash = parsed.contentHash;
+        ++m_indexMapGeneration;
         m_isStale = false;
     }
 
+    std::vector<size_t> FileDefinedEngineView::selectReactions(const io::ParsedNetworkData &parsed) const {
+        const auto& fullNetworkReactionSet = m_baseEngine.getNetworkReactions();
+        std::vector<size_t> selected;
+        std::vector<bool> included(fullNetworkReactionSet.size(), false);
+        const auto include = [&](const size_t j_full) {
+            if (!included[j_full]) {
+                included[j_full] = true;
+                selected.push_back(j_full);
+            }
+        };
+
+        // --- Reactions named in PEN-style ---
+        if (!parsed.reactionPENames.empty()) {
+            std::unordered_map<std::string_view, size_t> fullReactionReverseMap;
+            fullReactionReverseMap.reserve(fullNetworkReactionSet.size());
+            for (size_t j_full = 0; j_full < fullNetworkReactionSet.size(); ++j_full) {
+                fullReactionReverseMap.emplace(fullNetworkReactionSet[j_full].id(), j_full);
+            }
+            for (const auto& peName : parsed.reactionPENames) {
+                const auto it = fullReactionReverseMap.find(peName);
+                if (it == fullReactionReverseMap.end()) {
+                    LOG_ERROR(m_logger, "Reaction with name '{}' not found in the base engine's network reactions. Aborting...", peName);
+                    m_logger->flush_log();
+                    throw std::runtime_error("Reaction with name '" + std::string(peName) + "' not found in the base engine's network reactions.");
+                }
+                include(it->second);
+            }
+        }
+
+        // --- Reactions given by their participants ---
+        if (!parsed.reactionSpecifications.empty()) {
+            const auto participantKey = [](const std::vector<Species>& reactants, const std::vector<Species>& products) {
+                const auto sortedNames = [](const std::vector<Species>& species) {
+                    std::vector<std::string_view> names;
+                    names.reserve(species.size());
+                    for (const auto& s : species) {
+                        names.push_back(s.name());
+                    }
+                    std::ranges::sort(names);
+                    std::string joined;
+                    for (const auto& name : names) {
+                        joined.append(name);
+                        joined.push_back(' ');
+                    }
+                    return joined;
+                };
+                return sortedNames(reactants) + "-> " + sortedNames(products);
+            };
+
+            std::unordered_map<std::string, std::vector<size_t>> fullReactionsByParticipants;
+            fullReactionsByParticipants.reserve(fullNetworkReactionSet.size());
+            for (size_t j_full = 0; j_full < fullNetworkReactionSet.size(); ++j_full) {
+                const auto& reaction = fullNetworkReactionSet[j_full];
+                fullReactionsByParticipants[participantKey(reaction.reactants(), reaction.products())].push_back(j_full);
+            }
+            for (const auto& [label, reactants, products] : parsed.reactionSpecifications) {
+                const std::string key = participantKey(reactants, products);
+                const auto it = fullReactionsByParticipants.find(key);
+                if (it == fullReactionsByParticipants.end()) {
+                    LOG_ERROR(m_logger, "Reaction '{}' ({}) not found in the base engine's network reactions. Aborting...", label, key);
+                    m_logger->flush_log();
+                    throw std::runtime_error("Reaction '" + label + "' not found in the base engine's network reactions.");
+                }
+                for (const size_t j_full : it->second) {
+                    include(j_full);
+                }
+            }
+        }
+
+        // --- Every reaction among the declared isotopes ---
+        if (parsed.includeIsotopeReactions) {
+            const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+            std::vector<bool> declared(fullHypergraph.numSpecies(), false);
+            for (const auto& isotope : parsed.isotopes) {
+                if (fullHypergraph.containsSpecies(isotope)) {
+                    declared[fullHypergraph.speciesIndex(isotope)] = true;
+                }
+            }
+            const auto allDeclared = [&declared](const std::span<const size_t> species) {
+                return std::ranges::all_of(species, [&declared](const size_t i) { return declared[i]; });
+            };
+            for (size_t j_full = 0; j_full < fullNetworkReactionSet.size(); ++j_full) {
+                if (allDeclared(fullHypergraph.reactants(j_full)) && allDeclared(fullHypergraph.products(j_full))) {
+                    include(j_full);
+                }
+            }
+        }
+        return selected;
+    }
+
     std::vector<double> FileDefinedEngineView::mapViewToFull(const std::vector<double>& culled) const {
         std::vector<double> full(m_baseEngine.getNetworkSpecies().size(), 0.0);
         for (size_t i_culled = 0; i_culled < culled.size(); ++i_culled) {
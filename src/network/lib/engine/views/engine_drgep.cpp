@@ -0,0 +1,563 @@
+#include "gridfire/engine/views/engine_drgep.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/utils/hypergraph.h"
+
+#include "quill/LogMacros.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace gridfire {
+    using fourdst::atomic::Species;
+
+    DRGEPEngineView::DRGEPEngineView(
+        DynamicEngine &baseEngine,
+        std::vector<Species> targets
+    ) :
+    m_baseEngine(baseEngine) {
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+        for (const auto& target : targets) {
+            if (!fullHypergraph.containsSpecies(target)) {
+                LOG_ERROR(m_logger, "DRGEP target species '{}' is not part of the base engine's network.", target.name());
+                m_logger->flush_log();
+                throw std::runtime_error("DRGEP target species not found in base engine: " + std::string(target.name()));
+            }
+            m_targetIndices.push_back(fullHypergraph.speciesIndex(target));
+        }
+
+        // Until the first update() the view maps onto the full base engine; no copy of it is built or taped
+        std::vector<size_t> allReactions(m_baseEngine.getNetworkReactions().size());
+        std::iota(allReactions.begin(), allReactions.end(), 0);
+        buildSkeleton(allReactions);
+    }
+
+    const std::vector<Species> & DRGEPEngineView::getNetworkSpecies() const {
+        return getMappedEngine().getNetworkSpecies();
+    }
+
+    StepDerivatives<double> DRGEPEngineView::calculateRHSAndEnergy(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        return getMappedEngine().calculateRHSAndEnergy(Y, T9, rho);
+    }
+
+    std::vector<double> DRGEPEngineView::calculateRHSSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        return getMappedEngine().calculateRHSSubset(Y, speciesIndices, T9, rho);
+    }
+
+    std::vector<double> DRGEPEngineView::calculateJacobianSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const utils::SparsityPattern &pattern,
+        const double T9,
+        const double rho
+    ) {
+        validateState();
+        return getMappedEngine().calculateJacobianSubset(Y, speciesIndices, pattern, T9, rho);
+    }
+
+    void DRGEPEngineView::generateJacobianMatrix(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) {
+        validateState();
+        getMappedEngine().generateJacobianMatrix(Y, T9, rho);
+    }
+
+    double DRGEPEngineView::getJacobianMatrixEntry(const int i, const int j) const {
+        validateState();
+        return getMappedEngine().getJacobianMatrixEntry(i, j);
+    }
+
+    utils::SparsityPattern DRGEPEngineView::getJacobianSparsityPattern() const {
+        validateState();
+        return getMappedEngine().getJacobianSparsityPattern();
+    }
+
+    utils::SparsityPattern DRGEPEngineView::getStoichiometrySparsityPattern() const {
+        validateState();
+        return getMappedEngine().getStoichiometrySparsityPattern();
+    }
+
+    const utils::NetworkHypergraph & DRGEPEngineView::getNetworkHypergraph() const {
+        return getMappedEngine().getNetworkHypergraph();
+    }
+
+    utils::BlockOrdering DRGEPEngineView::getJacobianBlockOrdering() const {
+        validateState();
+        return getMappedEngine().getJacobianBlockOrdering();
+    }
+
+    void DRGEPEngineView::generateStoichiometryMatrix() {
+        validateState();
+        getMappedEngine().generateStoichiometryMatrix();
+    }
+
+    int DRGEPEngineView::getStoichiometryMatrixEntry(const int speciesIndex, const int reactionIndex) const {
+        validateState();
+        return getMappedEngine().getStoichiometryMatrixEntry(speciesIndex, reactionIndex);
+    }
+
+    double DRGEPEngineView::calculateMolarReactionFlow(
+        const reaction::Reaction &reaction,
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        if (!getMappedEngine().getNetworkReactions().contains(reaction)) {
+            LOG_ERROR(m_logger, "Reaction '{}' is not part of the skeletal network of the DRGEP engine view.", reaction.id());
+            m_logger->flush_log();
+            throw std::runtime_error("Reaction not found in skeletal network: " + std::string(reaction.id()));
+        }
+        return getMappedEngine().calculateMolarReactionFlow(reaction, Y, T9, rho);
+    }
+
+    std::vector<double> DRGEPEngineView::calculateAllMolarReactionFlows(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        return getMappedEngine().calculateAllMolarReactionFlows(Y, T9, rho);
+    }
+
+    const reaction::LogicalReactionSet & DRGEPEngineView::getNetworkReactions() const {
+        return getMappedEngine().getNetworkReactions();
+    }
+
+    std::unordered_map<Species, double> DRGEPEngineView::getSpeciesTimescales(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        validateState();
+        return getMappedEngine().getSpeciesTimescales(Y, T9, rho);
+    }
+
+    void DRGEPEngineView::update(const NetIn &netIn) {
+        LOG_TRACE_L1(m_logger, "Updating DRGEPEngineView with new network input...");
+        const auto relativeTolerance = m_config.get<double>("gridfire:DRGEPEngineView:RelativeTolerance", 0.01);
+        const auto energyTarget = m_config.get<bool>("gridfire:DRGEPEngineView:TargetEnergyGeneration", true);
+
+        // --- Flows of the full network at the current conditions ---
+        const auto& fullSpeciesList = m_baseEngine.getNetworkSpecies();
+        std::vector<double> Y_full;
+        Y_full.reserve(fullSpeciesList.size());
+        for (const auto& species : fullSpeciesList) {
+            Y_full.push_back(netIn.composition.contains(species) ? netIn.composition.getMolarAbundance(std::string(species.name())) : 0.0);
+        }
+        const std::vector<double> flows = m_baseEngine.calculateAllMolarReactionFlows(Y_full, netIn.temperature / 1e9, netIn.density);
+
+        std::vector<size_t> offsets;
+        std::vector<Participant> participants;
+        collectParticipants(offsets, participants);
+
+        m_importance = computeImportance(offsets, participants, flows, energyTarget);
+
+        // --- Candidate thresholds: the distinct importance values, largest first ---
+        std::vector<double> thresholds;
+        for (const double importance : m_importance) {
+            if (importance > 0.0) {
+                thresholds.push_back(importance);
+            }
+        }
+        std::ranges::sort(thresholds, std::greater<>());
+        const auto [first, last] = std::ranges::unique(thresholds);
+        thresholds.erase(first, last);
+
+        const size_t numReactions = flows.size();
+        const auto keptReactionsAt = [&](const double threshold) {
+            std::vector<bool> kept(numReactions, true);
+            for (size_t j = 0; j < numReactions; ++j) {
+                for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                    if (m_importance[participants[k].species] < threshold) {
+                        kept[j] = false;
+                        break;
+                    }
+                }
+            }
+            return kept;
+        };
+
+        // --- Bisect for the largest threshold (smallest skeleton) within the tolerance ---
+        // The skeletons are nested, so the error shrinks (up to cancellation) as the threshold drops.
+        // If even the smallest threshold misses the tolerance, its skeleton is the best available.
+        size_t lo = 0;
+        size_t hi = thresholds.empty() ? 0 : thresholds.size() - 1;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (reductionError(offsets, participants, flows, keptReactionsAt(thresholds[mid]), energyTarget) <= relativeTolerance) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        std::vector<bool> keptReactions(numReactions, true);
+        if (!thresholds.empty()) {
+            keptReactions = keptReactionsAt(thresholds[lo]);
+        }
+        const double error = reductionError(offsets, participants, flows, keptReactions, energyTarget);
+
+        std::vector<size_t> reactionIndices;
+        for (size_t j = 0; j < numReactions; ++j) {
+            if (keptReactions[j]) {
+                reactionIndices.push_back(j);
+            }
+        }
+        LOG_DEBUG(
+            m_logger,
+            "DRGEP selected {} of {} reactions (threshold {:0.3E}, relative error {:0.3E}, tolerance {:0.3E}).",
+            reactionIndices.size(),
+            numReactions,
+            thresholds.empty() ? 0.0 : thresholds[lo],
+            error,
+            relativeTolerance
+        );
+
+        if (reactionIndices.empty()) {
+            LOG_WARNING(m_logger, "DRGEP reduction selected no reactions; keeping the current skeleton of {} reactions.", m_reactionIndexMap.size());
+        } else if (m_isStale || reactionIndices != m_reactionIndexMap) {
+            buildSkeleton(reactionIndices);
+            m_reductionError = error;
+        } else {
+            LOG_DEBUG(m_logger, "DRGEP skeleton is unchanged; skipping rebuild.");
+            m_reductionError = error;
+        }
+        m_isStale = false;
+
+        LOG_INFO(m_logger, "DRGEPEngineView updated with {} skeletal species and {} skeletal reactions.", getNetworkSpecies().size(), getNetworkReactions().size());
+    }
+
+    void DRGEPEngineView::setScreeningModel(const screening::ScreeningType model) {
+        m_baseEngine.setScreeningModel(model);
+        if (m_skeletalEngine) {
+            m_skeletalEngine->setScreeningModel(model);
+        }
+    }
+
+    screening::ScreeningType DRGEPEngineView::getScreeningModel() const {
+        return m_baseEngine.getScreeningModel();
+    }
+
+    uint64_t DRGEPEngineView::getRateMultiplierGeneration() const {
+        return m_baseEngine.getRateMultiplierGeneration();
+    }
+
+    DynamicEngine& DRGEPEngineView::getMappedEngine() const {
+        if (!m_skeletalEngine) {
+            return m_baseEngine;
+        }
+        if (m_skeletalMultiplierGeneration != m_baseEngine.getRateMultiplierGeneration()) {
+            LOG_TRACE_L1(m_logger, "Rate multipliers of the base engine changed; re-applying them to the DRGEP skeletal engine.");
+            applySkeletalRateMultipliers();
+        }
+        return *m_skeletalEngine;
+    }
+
+    std::vector<double> DRGEPEngineView::getRateMultipliers() const {
+        const auto fullMultipliers = m_baseEngine.getRateMultipliers();
+        std::vector<double> multipliers;
+        multipliers.reserve(m_reactionIndexMap.size());
+        for (const size_t j_full : m_reactionIndexMap) {
+            multipliers.push_back(fullMultipliers[j_full]);
+        }
+        return multipliers;
+    }
+
+    void DRGEPEngineView::collectParticipants(
+        std::vector<size_t> &offsets,
+        std::vector<Participant> &participants
+    ) const {
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+        const size_t numReactions = fullHypergraph.numReactions();
+
+        offsets.assign(1, 0);
+        offsets.reserve(numReactions + 1);
+        participants.clear();
+        for (size_t j = 0; j < numReactions; ++j) {
+            const auto reactants = fullHypergraph.reactants(j);
+            const auto reactantCounts = fullHypergraph.reactantCounts(j);
+            const auto products = fullHypergraph.products(j);
+            const auto productCounts = fullHypergraph.productCounts(j);
+
+            // Both lists are sorted, so merge them into one coefficient per species
+            size_t r = 0;
+            size_t p = 0;
+            while (r < reactants.size() || p < products.size()) {
+                if (p == products.size() || (r < reactants.size() && reactants[r] < products[p])) {
+                    participants.push_back({reactants[r], -reactantCounts[r]});
+                    ++r;
+                } else if (r == reactants.size() || products[p] < reactants[r]) {
+                    participants.push_back({products[p], productCounts[p]});
+                    ++p;
+                } else {
+                    participants.push_back({reactants[r], productCounts[p] - reactantCounts[r]});
+                    ++r;
+                    ++p;
+                }
+            }
+            offsets.push_back(participants.size());
+        }
+    }
+
+    std::vector<double> DRGEPEngineView::computeImportance(
+        const std::vector<size_t> &offsets,
+        const std::vector<Participant> &participants,
+        const std::vector<double> &flows,
+        const bool energyTarget
+    ) const {
+        const size_t numSpecies = m_baseEngine.getNetworkSpecies().size();
+        const size_t numReactions = flows.size();
+        const auto& reactions = m_baseEngine.getNetworkReactions();
+
+        // --- Gross production and consumption of every species ---
+        std::vector<double> production(numSpecies, 0.0);
+        std::vector<double> consumption(numSpecies, 0.0);
+        for (size_t j = 0; j < numReactions; ++j) {
+            for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                const auto& [species, coefficient] = participants[k];
+                if (coefficient > 0) {
+                    production[species] += coefficient * flows[j];
+                } else {
+                    consumption[species] -= coefficient * flows[j];
+                }
+            }
+        }
+
+        // --- Reactions of each species, to accumulate the direct interaction coefficients ---
+        std::vector<size_t> speciesOffsets(numSpecies + 1, 0);
+        for (const auto& participant : participants) {
+            ++speciesOffsets[participant.species + 1];
+        }
+        std::partial_sum(speciesOffsets.begin(), speciesOffsets.end(), speciesOffsets.begin());
+        std::vector<size_t> speciesEntries(participants.size());
+        std::vector<size_t> cursor(speciesOffsets.begin(), speciesOffsets.end() - 1);
+        for (size_t j = 0; j < numReactions; ++j) {
+            for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                speciesEntries[cursor[participants[k].species]++] = k;
+            }
+        }
+        std::vector<size_t> reactionOfEntry(participants.size());
+        for (size_t j = 0; j < numReactions; ++j) {
+            for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                reactionOfEntry[k] = j;
+            }
+        }
+
+        // --- Direct interaction coefficients r_AB, as a CSR graph A -> B ---
+        std::vector<size_t> edgeOffsets(1, 0);
+        std::vector<size_t> edgeTargets;
+        std::vector<double> edgeWeights;
+        std::vector<double> numerator(numSpecies, 0.0);
+        std::vector<uint8_t> touched(numSpecies, 0);
+        std::vector<size_t> touchedList;
+        for (size_t a = 0; a < numSpecies; ++a) {
+            const double denominator = std::max(production[a], consumption[a]);
+            if (denominator > 0.0) {
+                for (size_t e = speciesOffsets[a]; e < speciesOffsets[a + 1]; ++e) {
+                    const size_t entry = speciesEntries[e];
+                    const size_t j = reactionOfEntry[entry];
+                    const double contribution = participants[entry].coefficient * flows[j];
+                    if (contribution == 0.0) {
+                        continue;
+                    }
+                    for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                        const size_t b = participants[k].species;
+                        if (b == a) {
+                            continue;
+                        }
+                        if (!touched[b]) {
+                            touched[b] = 1;
+                            touchedList.push_back(b);
+                        }
+                        numerator[b] += contribution;
+                    }
+                }
+                for (const size_t b : touchedList) {
+                    const double r = std::abs(numerator[b]) / denominator;
+                    if (r > 0.0) {
+                        edgeTargets.push_back(b);
+                        edgeWeights.push_back(std::min(r, 1.0));
+                    }
+                }
+            }
+            for (const size_t b : touchedList) {
+                touched[b] = 0;
+                numerator[b] = 0.0;
+            }
+            touchedList.clear();
+            edgeOffsets.push_back(edgeTargets.size());
+        }
+
+        // --- Max-product Dijkstra search from the targets ---
+        std::vector<double> importance(numSpecies, 0.0);
+        std::priority_queue<std::pair<double, size_t>> queue;
+        for (const size_t target : m_targetIndices) {
+            importance[target] = 1.0;
+            queue.emplace(1.0, target);
+        }
+        if (energyTarget) {
+            // The energy generation rate depends on species B through every reaction B takes part in
+            std::vector<double> energyNumerator(numSpecies, 0.0);
+            double energyProduction = 0.0;
+            double energyConsumption = 0.0;
+            for (size_t j = 0; j < numReactions; ++j) {
+                const double energyRate = reactions[j].qValue() * flows[j];
+                (energyRate > 0.0 ? energyProduction : energyConsumption) += std::abs(energyRate);
+                for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                    energyNumerator[participants[k].species] += energyRate;
+                }
+            }
+            const double energyDenominator = std::max(energyProduction, energyConsumption);
+            if (energyDenominator > 0.0) {
+                for (size_t b = 0; b < numSpecies; ++b) {
+                    const double r = std::min(std::abs(energyNumerator[b]) / energyDenominator, 1.0);
+                    if (r > importance[b]) {
+                        importance[b] = r;
+                        queue.emplace(r, b);
+                    }
+                }
+            }
+        }
+        while (!queue.empty()) {
+            const auto [value, a] = queue.top();
+            queue.pop();
+            if (value < importance[a]) {
+                continue;
+            }
+            for (size_t e = edgeOffsets[a]; e < edgeOffsets[a + 1]; ++e) {
+                const size_t b = edgeTargets[e];
+                const double candidate = value * edgeWeights[e];
+                if (candidate > importance[b]) {
+                    importance[b] = candidate;
+                    queue.emplace(candidate, b);
+                }
+            }
+        }
+        return importance;
+    }
+
+    double DRGEPEngineView::reductionError(
+        const std::vector<size_t> &offsets,
+        const std::vector<Participant> &participants,
+        const std::vector<double> &flows,
+        const std::vector<bool> &keptReactions,
+        const bool energyTarget
+    ) const {
+        const auto& reactions = m_baseEngine.getNetworkReactions();
+        const size_t numSpecies = m_baseEngine.getNetworkSpecies().size();
+
+        std::vector<double> removedRate(numSpecies, 0.0);
+        std::vector<double> production(numSpecies, 0.0);
+        std::vector<double> consumption(numSpecies, 0.0);
+        double removedEnergy = 0.0;
+        double energyProduction = 0.0;
+        double energyConsumption = 0.0;
+        for (size_t j = 0; j < flows.size(); ++j) {
+            for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                const auto& [species, coefficient] = participants[k];
+                const double rate = coefficient * flows[j];
+                (rate > 0.0 ? production[species] : consumption[species]) += std::abs(rate);
+                if (!keptReactions[j]) {
+                    removedRate[species] += rate;
+                }
+            }
+            if (energyTarget) {
+                const double energyRate = reactions[j].qValue() * flows[j];
+                (energyRate > 0.0 ? energyProduction : energyConsumption) += std::abs(energyRate);
+                if (!keptReactions[j]) {
+                    removedEnergy += energyRate;
+                }
+            }
+        }
+
+        double error = 0.0;
+        for (const size_t target : m_targetIndices) {
+            const double turnover = std::max(production[target], consumption[target]);
+            if (turnover > 0.0) {
+                error = std::max(error, std::abs(removedRate[target]) / turnover);
+            }
+        }
+        if (energyTarget) {
+            const double turnover = std::max(energyProduction, energyConsumption);
+            if (turnover > 0.0) {
+                error = std::max(error, std::abs(removedEnergy) / turnover);
+            }
+        }
+        return error;
+    }
+
+    void DRGEPEngineView::buildSkeleton(const std::vector<size_t> &reactionIndices) {
+        const auto& fullReactionSet = m_baseEngine.getNetworkReactions();
+        m_reactionIndexMap = reactionIndices;
+        ++m_indexMapGeneration;
+
+        // --- Nothing removed: map straight onto the base engine rather than copying it ---
+        if (reactionIndices.size() == fullReactionSet.size()) {
+            LOG_TRACE_L1(m_logger, "DRGEP skeleton is the full network; delegating to the base engine.");
+            m_skeletalEngine.reset();
+            m_speciesIndexMap.resize(m_baseEngine.getNetworkSpecies().size());
+            std::iota(m_speciesIndexMap.begin(), m_speciesIndexMap.end(), 0);
+            m_identitySpeciesMap = m_speciesIndexMap;
+            m_identityReactionMap = m_reactionIndexMap;
+            return;
+        }
+
+        std::vector<reaction::LogicalReaction> selected;
+        selected.reserve(reactionIndices.size());
+        for (const size_t j : reactionIndices) {
+            selected.push_back(fullReactionSet[j]);
+        }
+        const reaction::LogicalReactionSet skeletalReactions(std::move(selected));
+
+        LOG_TRACE_L1(m_logger, "Building DRGEP skeletal engine over {} reactions...", skeletalReactions.size());
+        m_skeletalEngine = std::make_unique<GraphEngine>(skeletalReactions);
+        m_skeletalEngine->setScreeningModel(m_baseEngine.getScreeningModel());
+        applySkeletalRateMultipliers();
+
+        const utils::NetworkHypergraph& fullHypergraph = m_baseEngine.getNetworkHypergraph();
+        const auto& skeletalSpecies = m_skeletalEngine->getNetworkSpecies();
+        m_speciesIndexMap.clear();
+        m_speciesIndexMap.reserve(skeletalSpecies.size());
+        for (const auto& species : skeletalSpecies) {
+            m_speciesIndexMap.push_back(fullHypergraph.speciesIndex(species));
+        }
+
+        m_identitySpeciesMap.resize(skeletalSpecies.size());
+        std::iota(m_identitySpeciesMap.begin(), m_identitySpeciesMap.end(), 0);
+        m_identityReactionMap.resize(reactionIndices.size());
+        std::iota(m_identityReactionMap.begin(), m_identityReactionMap.end(), 0);
+    }
+
+    void DRGEPEngineView::applySkeletalRateMultipliers() const {
+        m_skeletalMultiplierGeneration = m_baseEngine.getRateMultiplierGeneration();
+        m_skeletalEngine->setRateMultipliers(getRateMultipliers()); // The skeleton keeps the order of m_reactionIndexMap
+    }
+
+    void DRGEPEngineView::validateState() const {
+        if (m_isStale) {
+            LOG_ERROR(m_logger, "DRGEPEngineView is stale. Please call update() before using it.");
+            m_logger->flush_log();
+            throw std::runtime_error("DRGEPEngineView is stale. Please call update() before using it.");
+        }
+    }
+}
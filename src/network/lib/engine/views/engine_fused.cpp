@@ -0,0 +1,261 @@
+#include "gridfire/engine/views/engine_fused.h"
+
+#include "quill/LogMacros.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace gridfire {
+    using fourdst::atomic::Species;
+
+    FusedEngineView::FusedEngineView(DynamicEngine &topEngine) :
+    m_topEngine(topEngine) {
+        fuse();
+    }
+
+    const std::vector<Species> & FusedEngineView::getNetworkSpecies() const {
+        return m_topEngine.getNetworkSpecies();
+    }
+
+    StepDerivatives<double> FusedEngineView::calculateRHSAndEnergy(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        DynamicEngine& root = rootEngine();
+
+        const auto [dydt, nuclearEnergyGenerationRate] = root.calculateRHSAndEnergy(mapTopToRoot(Y, root), T9, rho);
+        return {mapRootToTop(dydt), nuclearEnergyGenerationRate};
+    }
+
+    std::vector<double> FusedEngineView::calculateRHSSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const double T9,
+        const double rho
+    ) const {
+        DynamicEngine& root = rootEngine();
+
+        std::vector<size_t> rootIndices;
+        rootIndices.reserve(speciesIndices.size());
+        for (const size_t i : speciesIndices) {
+            rootIndices.push_back(m_speciesIndexMap[i]);
+        }
+        return root.calculateRHSSubset(mapTopToRoot(Y, root), rootIndices, T9, rho);
+    }
+
+    std::vector<double> FusedEngineView::calculateJacobianSubset(
+        const std::vector<double> &Y,
+        const std::vector<size_t> &speciesIndices,
+        const utils::SparsityPattern &pattern,
+        const double T9,
+        const double rho
+    ) {
+        DynamicEngine& root = rootEngine();
+
+        std::vector<size_t> rootIndices;
+        rootIndices.reserve(speciesIndices.size());
+        for (const size_t i : speciesIndices) {
+            rootIndices.push_back(m_speciesIndexMap[i]);
+        }
+        return root.calculateJacobianSubset(mapTopToRoot(Y, root), rootIndices, pattern, T9, rho);
+    }
+
+    void FusedEngineView::generateJacobianMatrix(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) {
+        DynamicEngine& root = rootEngine();
+        root.generateJacobianMatrix(mapTopToRoot(Y, root), T9, rho);
+    }
+
+    double FusedEngineView::getJacobianMatrixEntry(const int i, const int j) const {
+        const DynamicEngine& root = rootEngine();
+        return root.getJacobianMatrixEntry(
+            static_cast<int>(m_speciesIndexMap[i]),
+            static_cast<int>(m_speciesIndexMap[j])
+        );
+    }
+
+    utils::SparsityPattern FusedEngineView::getJacobianSparsityPattern() const {
+        DynamicEngine& root = rootEngine();
+        return utils::restrictSparsityPattern(root.getJacobianSparsityPattern(), m_speciesIndexMap, m_speciesIndexMap);
+    }
+
+    utils::SparsityPattern FusedEngineView::getStoichiometrySparsityPattern() const {
+        DynamicEngine& root = rootEngine();
+        return utils::restrictSparsityPattern(root.getStoichiometrySparsityPattern(), m_speciesIndexMap, m_reactionIndexMap);
+    }
+
+    const utils::NetworkHypergraph & FusedEngineView::getNetworkHypergraph() const {
+        return m_topEngine.getNetworkHypergraph();
+    }
+
+    utils::BlockOrdering FusedEngineView::getJacobianBlockOrdering() const {
+        DynamicEngine& root = rootEngine();
+        return utils::restrictBlockOrdering(root.getJacobianBlockOrdering(), m_speciesIndexMap);
+    }
+
+    void FusedEngineView::generateStoichiometryMatrix() {
+        DynamicEngine& root = rootEngine();
+        root.generateStoichiometryMatrix();
+    }
+
+    int FusedEngineView::getStoichiometryMatrixEntry(const int speciesIndex, const int reactionIndex) const {
+        const DynamicEngine& root = rootEngine();
+        return root.getStoichiometryMatrixEntry(
+            static_cast<int>(m_speciesIndexMap[speciesIndex]),
+            static_cast<int>(m_reactionIndexMap[reactionIndex])
+        );
+    }
+
+    double FusedEngineView::calculateMolarReactionFlow(
+        const reaction::Reaction &reaction,
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        DynamicEngine& root = rootEngine();
+
+        if (!m_topEngine.getNetworkReactions().contains(reaction)) {
+            LOG_ERROR(m_logger, "Reaction '{}' is not part of the network of the fused engine view.", reaction.id());
+            m_logger->flush_log();
+            throw std::runtime_error("Reaction not found in fused engine view: " + std::string(reaction.id()));
+        }
+        return root.calculateMolarReactionFlow(reaction, mapTopToRoot(Y, root), T9, rho);
+    }
+
+    std::vector<double> FusedEngineView::calculateAllMolarReactionFlows(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        DynamicEngine& root = rootEngine();
+        const auto rootFlows = root.calculateAllMolarReactionFlows(mapTopToRoot(Y, root), T9, rho);
+
+        std::vector<double> flows;
+        flows.reserve(m_reactionIndexMap.size());
+        for (const size_t j_root : m_reactionIndexMap) {
+            flows.push_back(rootFlows[j_root]);
+        }
+        return flows;
+    }
+
+    const reaction::LogicalReactionSet & FusedEngineView::getNetworkReactions() const {
+        return m_topEngine.getNetworkReactions();
+    }
+
+    std::unordered_map<Species, double> FusedEngineView::getSpeciesTimescales(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        DynamicEngine& root = rootEngine();
+        const auto rootTimescales = root.getSpeciesTimescales(mapTopToRoot(Y, root), T9, rho);
+
+        std::unordered_map<Species, double> timescales;
+        for (const auto& species : m_topEngine.getNetworkSpecies()) {
+            if (rootTimescales.contains(species)) {
+                timescales[species] = rootTimescales.at(species);
+            }
+        }
+        return timescales;
+    }
+
+    void FusedEngineView::update(const NetIn &netIn) {
+        m_topEngine.update(netIn);
+        if (!isCurrent()) {
+            fuse();
+        }
+    }
+
+    void FusedEngineView::setScreeningModel(const screening::ScreeningType model) {
+        m_topEngine.setScreeningModel(model);
+    }
+
+    screening::ScreeningType FusedEngineView::getScreeningModel() const {
+        return rootEngine().getScreeningModel();
+    }
+
+    std::vector<double> FusedEngineView::getRateMultipliers() const {
+        return m_topEngine.getRateMultipliers();
+    }
+
+    uint64_t FusedEngineView::getRateMultiplierGeneration() const {
+        return m_topEngine.getRateMultiplierGeneration();
+    }
+
+    void FusedEngineView::fuse() {
+        m_layers.clear();
+        DynamicEngine* root = &m_topEngine;
+
+        m_speciesIndexMap.resize(m_topEngine.getNetworkSpecies().size());
+        m_reactionIndexMap.resize(m_topEngine.getNetworkReactions().size());
+        std::iota(m_speciesIndexMap.begin(), m_speciesIndexMap.end(), 0);
+        std::iota(m_reactionIndexMap.begin(), m_reactionIndexMap.end(), 0);
+
+        // --- Compose the maps layer by layer: index i of the top maps to layerMap[composed[i]] ---
+        while (const auto* view = dynamic_cast<const IndexMappedEngineView*>(root)) {
+            const auto& speciesMap = view->getSpeciesIndexMap();
+            const auto& reactionMap = view->getReactionIndexMap();
+            for (auto& index : m_speciesIndexMap) {
+                index = speciesMap[index];
+            }
+            for (auto& index : m_reactionIndexMap) {
+                index = reactionMap[index];
+            }
+            m_layers.push_back({view, view->getIndexMapGeneration()});
+            root = &view->getMappedEngine();
+        }
+
+        LOG_DEBUG(
+            m_logger,
+            "Fused {} engine view layers into a single map of {} species and {} reactions onto a root engine of {} species.",
+            m_layers.size(),
+            m_speciesIndexMap.size(),
+            m_reactionIndexMap.size(),
+            root->getNetworkSpecies().size()
+        );
+    }
+
+    bool FusedEngineView::isCurrent() const {
+        for (const auto& [view, generation] : m_layers) {
+            if (view->getIndexMapGeneration() != generation) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void FusedEngineView::validateState() const {
+        if (!isCurrent()) {
+            LOG_ERROR(m_logger, "FusedEngineView is stale: a fused view changed its index maps. Please call update() on the fused view.");
+            m_logger->flush_log();
+            throw std::runtime_error("FusedEngineView is stale. Please call update() on the fused view.");
+        }
+    }
+
+    DynamicEngine& FusedEngineView::rootEngine() const {
+        validateState();
+        // A view may have replaced the engine it maps into (e.g. a rebuilt compact engine), so the root is never cached
+        return m_layers.empty() ? m_topEngine : m_layers.back().view->getMappedEngine();
+    }
+
+    std::vector<double> FusedEngineView::mapTopToRoot(const std::vector<double> &Y, const DynamicEngine &root) const {
+        std::vector<double> Y_root(root.getNetworkSpecies().size(), 0.0);
+        for (size_t i = 0; i < Y.size(); ++i) {
+            Y_root[m_speciesIndexMap[i]] = Y[i];
+        }
+        return Y_root;
+    }
+
+    std::vector<double> FusedEngineView::mapRootToTop(const std::vector<double> &root) const {
+        std::vector<double> top(m_speciesIndexMap.size(), 0.0);
+        for (size_t i = 0; i < m_speciesIndexMap.size(); ++i) {
+            top[i] = root[m_speciesIndexMap[i]];
+        }
+        return top;
+    }
+}
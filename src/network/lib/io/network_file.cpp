@@ -1,77 +1,547 @@
 #include "gridfire/io/network_file.h"
 
-#include <string>
-#include <vector>
+#include "fourdst/composition/species.h"
+
 #include <algorithm>
-#include <fstream>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "quill/LogMacros.h"
+#include "xxhash64.h"
 
 namespace gridfire::io {
     namespace {
-        inline void ltrim(std::string &s) {
-           s.erase(
-               s.begin(),
-               std::ranges::find_if(s,
-                                    [](const unsigned char ch) {
-                                        return !std::isspace(ch);
-                                    })
-            );
+        /**
+         * @brief Read-only memory mapping of a whole file, unmapped on destruction.
+         */
+        class MappedFile {
+        public:
+            MappedFile(const std::string& filename, quill::Logger* logger) {
+                const auto fail = [&](const std::string& message) {
+                    if (m_fd >= 0) {
+                        ::close(m_fd);
+                    }
+                    LOG_ERROR(logger, "{}: {}", message, filename);
+                    logger->flush_log();
+                    throw std::runtime_error(message + ": " + filename);
+                };
+                m_fd = ::open(filename.c_str(), O_RDONLY);
+                if (m_fd < 0) {
+                    fail("Could not open file");
+                }
+                struct stat fileStat{};
+                if (::fstat(m_fd, &fileStat) != 0) {
+                    fail("Could not stat file");
+                }
+                m_size = static_cast<size_t>(fileStat.st_size);
+                if (m_size > 0) {
+                    m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+                    if (m_data == MAP_FAILED) {
+                        m_data = nullptr;
+                        fail("Could not memory-map file");
+                    }
+                }
+            }
+
+            ~MappedFile() {
+                if (m_data != nullptr) {
+                    ::munmap(m_data, m_size);
+                }
+                ::close(m_fd);
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            [[nodiscard]] std::string_view view() const {
+                return m_data != nullptr ? std::string_view(static_cast<const char*>(m_data), m_size) : std::string_view{};
+            }
+
+            [[nodiscard]] uint64_t hash() const {
+                return XXHash64::hash(m_data, m_size, 0);
+            }
+
+        private:
+            int m_fd = -1;
+            void* m_data = nullptr;
+            size_t m_size = 0;
+        };
+
+        inline std::string_view trim(std::string_view s) {
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+                s.remove_prefix(1);
+            }
+            while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+                s.remove_suffix(1);
+            }
+            return s;
+        }
+
+        inline bool iequals(const std::string_view a, const std::string_view b) {
+            return std::ranges::equal(a, b, [](const unsigned char x, const unsigned char y) {
+                return std::tolower(x) == std::tolower(y);
+            });
+        }
+
+        inline bool isDigits(const std::string_view s) {
+            return !s.empty() && std::ranges::all_of(s, [](const unsigned char ch) { return std::isdigit(ch); });
         }
 
-        inline void rtrim(std::string &s) {
-            s.erase(
-                std::find_if(
-                    s.rbegin(),
-                    s.rend(),
-                    [](const unsigned char ch) {
-                        return !std::isspace(ch);
-                    }).base(),
-                    s.end()
-                );
+        inline bool isLetters(const std::string_view s) {
+            return !s.empty() && std::ranges::all_of(s, [](const unsigned char ch) { return std::isalpha(ch); });
         }
 
-        inline void trim(std::string &s) {
-            ltrim(s);
-            rtrim(s);
+        /**
+         * @brief A token of a MESA network file, viewing the mapped content.
+         */
+        struct MESAToken {
+            std::string_view text; ///< Token text; `(` and `)` are tokens of their own.
+            size_t line; ///< Line the token starts on, from 1.
+        };
+
+        /**
+         * @brief Splits MESA network file content into tokens, dropping `!` comments.
+         *
+         * Whitespace, commas, and quotes separate tokens.
+         */
+        std::vector<MESAToken> tokenizeMESA(const std::string_view content) {
+            std::vector<MESAToken> tokens;
+            size_t line = 1;
+            size_t pos = 0;
+            const auto isSeparator = [](const char ch) {
+                return std::isspace(static_cast<unsigned char>(ch)) || ch == ',' || ch == '\'' || ch == '"';
+            };
+            while (pos < content.size()) {
+                const char ch = content[pos];
+                if (ch == '\n') {
+                    ++line;
+                    ++pos;
+                } else if (isSeparator(ch)) {
+                    ++pos;
+                } else if (ch == '!') {
+                    while (pos < content.size() && content[pos] != '\n') {
+                        ++pos;
+                    }
+                } else if (ch == '(' || ch == ')') {
+                    tokens.push_back({content.substr(pos, 1), line});
+                    ++pos;
+                } else {
+                    const size_t start = pos;
+                    while (pos < content.size() && !isSeparator(content[pos]) &&
+                           content[pos] != '!' && content[pos] != '(' && content[pos] != ')') {
+                        ++pos;
+                    }
+                    tokens.push_back({content.substr(start, pos - start), line});
+                }
+            }
+            return tokens;
         }
 
+        /**
+         * @brief Whether parseContent() is forwarding to parse() on this thread, to catch parsers overriding neither.
+         */
+        thread_local bool t_forwardingToParse = false;
 
+        /**
+         * @brief Splits the isomeric state off a MESA isotope name: `al26-2` is state 2 of `al26`.
+         *
+         * @return The isotope name and its state, which is empty if the name has no state suffix.
+         */
+        std::pair<std::string_view, std::optional<int>> splitMESAIsomer(const std::string_view name) {
+            const size_t dash = name.rfind('-');
+            if (dash == std::string_view::npos || dash == 0 || !isDigits(name.substr(dash + 1))) {
+                return {name, std::nullopt};
+            }
+            return {name.substr(0, dash), std::stoi(std::string(name.substr(dash + 1)))};
+        }
+
+        /**
+         * @brief Looks up an isotope by its MESA name (`c12`, `neut`, `prot`), or nullptr if unknown.
+         */
+        const fourdst::atomic::Species* findMESAIsotope(const std::string_view name) {
+            std::string key;
+            if (iequals(name, "neut")) {
+                key = "n-1";
+            } else if (iequals(name, "prot")) {
+                key = "H-1";
+            } else {
+                const auto digits = std::ranges::find_if(name, [](const unsigned char ch) { return std::isdigit(ch); });
+                const std::string_view symbol = name.substr(0, digits - name.begin());
+                const std::string_view massNumber = name.substr(digits - name.begin());
+                if (!isLetters(symbol) || !isDigits(massNumber)) {
+                    return nullptr;
+                }
+                key.reserve(name.size() + 1);
+                key.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(symbol.front()))));
+                for (const char ch : symbol.substr(1)) {
+                    key.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(ch))));
+                }
+                key.push_back('-');
+                key.append(massNumber);
+            }
+            const auto it = fourdst::atomic::species.find(key);
+            return it != fourdst::atomic::species.end() ? &it->second : nullptr;
+        }
+
+        /**
+         * @brief The isotope carried by one letter of a MESA `_xy_` reaction code, or nullptr for a photon.
+         */
+        const fourdst::atomic::Species* lightParticle(const char code) {
+            switch (code) {
+                case 'n': return findMESAIsotope("neut");
+                case 'p': return findMESAIsotope("prot");
+                case 'a': return findMESAIsotope("he4");
+                default: return nullptr;
+            }
+        }
+
+        inline bool isMESAReactionCode(const std::string_view part) {
+            if (iequals(part, "wk") || iequals(part, "ec")) {
+                return true;
+            }
+            constexpr std::string_view particles = "npag";
+            return part.size() == 2 &&
+                   particles.find(static_cast<char>(std::tolower(static_cast<unsigned char>(part[0])))) != std::string_view::npos &&
+                   particles.find(static_cast<char>(std::tolower(static_cast<unsigned char>(part[1])))) != std::string_view::npos;
+        }
     }
-    SimpleReactionListFileParser::SimpleReactionListFileParser() {}
 
-    ParsedNetworkData SimpleReactionListFileParser::parse(const std::string& filename) const {
-        LOG_TRACE_L1(m_logger, "Parsing simple reaction list file: {}", filename);
+    NetworkFileParseCache::NetworkFileParseCache(const size_t capacity) :
+    m_capacity(std::max<size_t>(capacity, 1)) {}
+
+    std::pair<bool, uint64_t> NetworkFileParseCache::findContentHash(
+        const std::string &filename,
+        const uint64_t size,
+        const int64_t modificationTime
+    ) const {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_fileStamps.find(filename);
+        if (it == m_fileStamps.end() || it->second.size != size || it->second.modificationTime != modificationTime) {
+            return {false, 0};
+        }
+        return {true, it->second.contentHash};
+    }
+
+    void NetworkFileParseCache::rememberContentHash(const std::string &filename, const FileStamp &stamp) {
+        std::lock_guard lock(m_mutex);
+        if (m_fileStamps.size() >= m_capacity && !m_fileStamps.contains(filename)) {
+            m_fileStamps.erase(m_fileStamps.begin()); // Forgetting a stamp only costs one read of that file
+        }
+        m_fileStamps[filename] = stamp;
+    }
+
+    std::pair<bool, ParsedNetworkData> NetworkFileParseCache::find(const std::type_index parser, const uint64_t contentHash) {
+        std::lock_guard lock(m_mutex);
+        const auto it = m_index.find(Key{parser, contentHash});
+        if (it == m_index.end()) {
+            return {false, ParsedNetworkData{}};
+        }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return {true, it->second->second};
+    }
+
+    void NetworkFileParseCache::insert(const std::type_index parser, const ParsedNetworkData &parsed) {
+        std::lock_guard lock(m_mutex);
+        const Key key{parser, parsed.contentHash};
+        if (const auto it = m_index.find(key); it != m_index.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            it->second->second = parsed;
+            return;
+        }
+        if (m_entries.size() >= m_capacity) {
+            m_index.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        m_entries.emplace_front(key, parsed);
+        m_index.emplace(key, m_entries.begin());
+    }
+
+    size_t NetworkFileParseCache::size() const {
+        std::lock_guard lock(m_mutex);
+        return m_entries.size();
+    }
+
+    NetworkFileParser::NetworkFileParser() :
+    m_cache(std::make_shared<NetworkFileParseCache>()) {}
+
+    void NetworkFileParser::setCache(std::shared_ptr<NetworkFileParseCache> cache) {
+        if (!cache) {
+            quill::Logger* logger = fourdst::logging::LogManager::getInstance().getLogger("log");
+            LOG_ERROR(logger, "Cannot set a null parse cache on a network file parser.");
+            logger->flush_log();
+            throw std::runtime_error("Cannot set a null parse cache on a network file parser.");
+        }
+        m_cache = std::move(cache);
+    }
 
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            LOG_ERROR(m_logger, "Failed to open file: {}", filename);
-            m_logger -> flush_log();
-            throw std::runtime_error("Could not open file: " + filename);
+    ParsedNetworkData NetworkFileParser::parseContent(
+        const std::string_view,
+        const std::string &filename
+    ) const {
+        if (t_forwardingToParse) {
+            quill::Logger* logger = fourdst::logging::LogManager::getInstance().getLogger("log");
+            LOG_ERROR(logger, "Network file parser {} overrides neither parse() nor parseContent().", typeid(*this).name());
+            logger->flush_log();
+            throw std::runtime_error("Network file parser overrides neither parse() nor parseContent().");
         }
+        // --- Parsers written against the filename interface read the file themselves ---
+        t_forwardingToParse = true;
+        try {
+            ParsedNetworkData parsed = parse(filename);
+            t_forwardingToParse = false;
+            return parsed;
+        } catch (...) {
+            t_forwardingToParse = false;
+            throw;
+        }
+    }
+
+    ParsedNetworkData NetworkFileParser::parse(const std::string &filename) const {
+        const MappedFile file(filename, fourdst::logging::LogManager::getInstance().getLogger("log"));
+        ParsedNetworkData parsed = parseContent(file.view(), filename);
+        parsed.contentHash = file.hash();
+        return parsed;
+    }
+
+    ParsedNetworkData NetworkFileParser::parseCached(const std::string &filename) const {
+        quill::Logger* logger = fourdst::logging::LogManager::getInstance().getLogger("log");
+        const std::type_index parserType(typeid(*this)); // Parsers of different formats never share entries
+
+        std::error_code sizeError, timeError;
+        const auto size = std::filesystem::file_size(filename, sizeError);
+        const auto modificationTime = std::filesystem::last_write_time(filename, timeError);
+        const bool stamped = !sizeError && !timeError;
+        const NetworkFileParseCache::FileStamp stamp{
+            stamped ? static_cast<uint64_t>(size) : 0,
+            stamped ? static_cast<int64_t>(modificationTime.time_since_epoch().count()) : 0,
+            0
+        };
+
+        // --- Unchanged file: reuse the remembered content hash without reading the file ---
+        if (stamped) {
+            if (const auto [known, contentHash] = m_cache->findContentHash(filename, stamp.size, stamp.modificationTime); known) {
+                if (auto [hit, cached] = m_cache->find(parserType, contentHash); hit) {
+                    LOG_TRACE_L1(logger, "Network file {} is unchanged; reusing its parse.", filename);
+                    return std::move(cached);
+                }
+            }
+        }
+
+        const MappedFile file(filename, logger);
+        const uint64_t contentHash = file.hash();
+        if (stamped) {
+            m_cache->rememberContentHash(filename, {stamp.size, stamp.modificationTime, contentHash});
+        }
+
+        // --- Changed or new path, but content seen before (e.g. a copy or a touched file) ---
+        if (auto [hit, cached] = m_cache->find(parserType, contentHash); hit) {
+            LOG_TRACE_L1(logger, "Content of network file {} was parsed before; reusing its parse.", filename);
+            return std::move(cached);
+        }
+
+        ParsedNetworkData parsed = parseContent(file.view(), filename);
+        parsed.contentHash = contentHash;
+        m_cache->insert(parserType, parsed);
+        return parsed;
+    }
+
+    SimpleReactionListFileParser::SimpleReactionListFileParser() {}
+
+    ParsedNetworkData SimpleReactionListFileParser::parseContent(
+        const std::string_view content,
+        const std::string& filename
+    ) const {
+        LOG_TRACE_L1(m_logger, "Parsing simple reaction list file: {}", filename);
 
         ParsedNetworkData parsed;
-        std::string line;
         int line_number = 0;
-        while (std::getline(file, line)) {
+        size_t lineStart = 0;
+        while (lineStart < content.size()) {
+            size_t lineEnd = content.find('\n', lineStart);
+            if (lineEnd == std::string_view::npos) {
+                lineEnd = content.size();
+            }
+            std::string_view line = content.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
             line_number++;
             LOG_TRACE_L3(m_logger, "Parsing reaction list file {}, line {}: {}", filename, line_number, line);
 
             const size_t comment_pos = line.find('#');
-            if (comment_pos != std::string::npos) {
+            if (comment_pos != std::string_view::npos) {
                 line = line.substr(0, comment_pos);
             }
 
-            trim(line);
+            line = trim(line);
 
             if (line.empty()) {
                 continue; // Skip empty lines
             }
-            parsed.reactionPENames.push_back(line);
+            parsed.reactionPENames.emplace_back(line);
         }
         LOG_TRACE_L1(m_logger, "Parsed {} reactions from file: {}", parsed.reactionPENames.size(), filename);
         return parsed;
     }
 
-}
\ No newline at end of file
+    MESANetworkFileParser::MESANetworkFileParser(const std::string &filename) :
+    m_filename(filename) {}
+
+    ParsedNetworkData MESANetworkFileParser::parseContent(
+        const std::string_view content,
+        const std::string& filename
+    ) const {
+        LOG_TRACE_L1(m_logger, "Parsing MESA network file: {}", filename);
+
+        const auto fail = [&](const size_t line, const std::string& message) {
+            LOG_ERROR(m_logger, "MESA network file {}, line {}: {}", filename, line, message);
+            m_logger->flush_log();
+            throw std::runtime_error(filename + ":" + std::to_string(line) + ": " + message);
+        };
+
+        const auto isotope = [&](const std::string_view name, const size_t line) -> const fourdst::atomic::Species& {
+            // --- Isomers: the ground state (`al26-1`) is the plain isotope; excited states are not in the base networks ---
+            const auto [isotopeName, isomerState] = splitMESAIsomer(name);
+            if (isomerState && *isomerState != 1) {
+                fail(line, "Isomeric state '" + std::string(name) + "' is not supported; the base networks only hold the ground state '" +
+                           std::string(isotopeName) + "-1'.");
+            }
+            const fourdst::atomic::Species* species = findMESAIsotope(isotopeName);
+            if (species == nullptr) {
+                fail(line, "Unknown isotope '" + std::string(name) + "'.");
+            }
+            return *species;
+        };
+
+        ParsedNetworkData parsed;
+        std::unordered_set<fourdst::atomic::Species> declared;
+        const auto declare = [&](const fourdst::atomic::Species& species) {
+            if (declared.insert(species).second) {
+                parsed.isotopes.push_back(species);
+            }
+        };
+
+        const std::vector<MESAToken> tokens = tokenizeMESA(content);
+        size_t t = 0;
+        while (t < tokens.size()) {
+            const auto& [command, commandLine] = tokens[t];
+            if (t + 1 >= tokens.size() || tokens[t + 1].text != "(") {
+                fail(commandLine, "Expected '(' after '" + std::string(command) + "'.");
+            }
+            size_t close = t + 2;
+            while (close < tokens.size() && tokens[close].text != ")") {
+                if (tokens[close].text == "(") {
+                    fail(tokens[close].line, "Unexpected '(' inside '" + std::string(command) + "'.");
+                }
+                ++close;
+            }
+            if (close == tokens.size()) {
+                fail(commandLine, "Unterminated '" + std::string(command) + "' block.");
+            }
+
+            if (iequals(command, "add_isos") || iequals(command, "add_isos_and_reactions")) {
+                parsed.includeIsotopeReactions |= iequals(command, "add_isos_and_reactions");
+                // --- Isotopes: `c12`, `neut`, `prot`, or an element with a mass number or range (`fe 52 58`) ---
+                for (size_t k = t + 2; k < close; ++k) {
+                    const auto& [text, line] = tokens[k];
+                    if (!isLetters(text) || iequals(text, "neut") || iequals(text, "prot")) {
+                        declare(isotope(text, line));
+                        continue;
+                    }
+                    if (k + 1 >= close || !isDigits(tokens[k + 1].text)) {
+                        fail(line, "Element '" + std::string(text) + "' is not followed by a mass number.");
+                    }
+                    const int first = std::stoi(std::string(tokens[k + 1].text));
+                    int last = first;
+                    ++k;
+                    if (k + 1 < close && isDigits(tokens[k + 1].text)) {
+                        last = std::stoi(std::string(tokens[k + 1].text));
+                        ++k;
+                    }
+                    if (last < first) {
+                        fail(line, "Empty mass number range for element '" + std::string(text) + "'.");
+                    }
+                    for (int a = first; a <= last; ++a) {
+                        declare(isotope(std::string(text) + std::to_string(a), line));
+                    }
+                }
+            } else if (iequals(command, "add_reactions")) {
+                // --- Reactions: r_<reactants>_<xy>_<products> or r_<reactants>_to_<products> ---
+                for (size_t k = t + 2; k < close; ++k) {
+                    const auto& [name, line] = tokens[k];
+                    if (name.size() < 3 || !iequals(name.substr(0, 2), "r_")) {
+                        fail(line, "Reaction '" + std::string(name) + "' is not of the form r_<reactants>_<xy>_<products>; "
+                                   "MESA's compound approximate rates are not supported.");
+                    }
+
+                    std::vector<std::string_view> parts;
+                    for (size_t start = 2; start <= name.size(); ) {
+                        size_t end = name.find('_', start);
+                        if (end == std::string_view::npos) {
+                            end = name.size();
+                        }
+                        parts.push_back(name.substr(start, end - start));
+                        start = end + 1;
+                    }
+
+                    ReactionSpecification specification;
+                    specification.label = std::string(name);
+                    const auto split = std::ranges::find_if(parts, [](const std::string_view part) {
+                        return iequals(part, "to") || isMESAReactionCode(part);
+                    });
+                    if (split == parts.end() ||
+                        std::find_if(split + 1, parts.end(), [](const std::string_view part) {
+                            return iequals(part, "to") || isMESAReactionCode(part);
+                        }) != parts.end()) {
+                        fail(line, "Reaction '" + std::string(name) + "' does not have exactly one reaction code (e.g. 'ag') or 'to'.");
+                    }
+                    for (auto it = parts.begin(); it != split; ++it) {
+                        specification.reactants.push_back(isotope(*it, line));
+                    }
+                    for (auto it = split + 1; it != parts.end(); ++it) {
+                        specification.products.push_back(isotope(*it, line));
+                    }
+                    if (isMESAReactionCode(*split) && !iequals(*split, "wk") && !iequals(*split, "ec")) {
+                        const auto lower = [](const char ch) { return static_cast<char>(std::tolower(static_cast<unsigned char>(ch))); };
+                        if (const auto* projectile = lightParticle(lower((*split)[0]))) {
+                            specification.reactants.push_back(*projectile);
+                        }
+                        if (const auto* ejectile = lightParticle(lower((*split)[1]))) {
+                            specification.products.push_back(*ejectile);
+                        }
+                    }
+                    if (specification.reactants.empty() || specification.products.empty()) {
+                        fail(line, "Reaction '" + std::string(name) + "' has no reactants or no products.");
+                    }
+                    parsed.reactionSpecifications.push_back(std::move(specification));
+                }
+            } else {
+                fail(commandLine, "Unsupported command '" + std::string(command) + "'.");
+            }
+            t = close + 1;
+        }
+
+        LOG_TRACE_L1(
+            m_logger,
+            "Parsed {} isotopes and {} reactions from MESA network file {} (isotope reactions {}).",
+            parsed.isotopes.size(),
+            parsed.reactionSpecifications.size(),
+            filename,
+            parsed.includeIsotopeReactions ? "included" : "not included"
+        );
+        return parsed;
+    }
+}
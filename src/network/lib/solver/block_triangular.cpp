@@ -0,0 +1,124 @@
+#include "gridfire/solver/block_triangular.h"
+#include "gridfire/utils/graph.h"
+
+#include "Eigen/Dense"
+#include "Eigen/SparseCore"
+#include "Eigen/SparseLU"
+
+#include <vector>
+#include <memory>
+#include <utility>
+
+namespace gridfire::solver {
+
+    void BlockTriangularLU::setOrdering(utils::BlockOrdering ordering) {
+        m_ordering = std::move(ordering);
+        const size_t n = m_ordering.ordering.size();
+
+        m_permutedIndex.assign(n, 0);
+        m_blockOf.assign(n, 0);
+        for (size_t k = 0; k < n; ++k) {
+            m_permutedIndex[m_ordering.ordering[k]] = k;
+        }
+
+        m_blocks.clear();
+        m_blocks.resize(m_ordering.numBlocks());
+        for (size_t b = 0; b < m_ordering.numBlocks(); ++b) {
+            m_blocks[b].begin = m_ordering.blockOffsets[b];
+            m_blocks[b].size = m_ordering.blockOffsets[b + 1] - m_ordering.blockOffsets[b];
+            for (size_t k = m_ordering.blockOffsets[b]; k < m_ordering.blockOffsets[b + 1]; ++k) {
+                m_blockOf[k] = b;
+            }
+        }
+        m_coupling.resize(0, 0);
+    }
+
+    bool BlockTriangularLU::factorize(const Eigen::SparseMatrix<double> &A) {
+        const auto n = static_cast<Eigen::Index>(m_ordering.ordering.size());
+
+        // --- Sort the entries into diagonal blocks and couplings ---
+        std::vector<std::vector<Eigen::Triplet<double>>> blockTriplets(m_blocks.size());
+        std::vector<Eigen::Triplet<double>> couplingTriplets;
+        m_droppedEntries = 0;
+        for (Eigen::Index col = 0; col < A.outerSize(); ++col) {
+            for (Eigen::SparseMatrix<double>::InnerIterator it(A, col); it; ++it) {
+                const size_t row = m_permutedIndex[it.row()];
+                const size_t column = m_permutedIndex[it.col()];
+                const size_t rowBlock = m_blockOf[row];
+                const size_t columnBlock = m_blockOf[column];
+                if (rowBlock == columnBlock) {
+                    const size_t begin = m_blocks[rowBlock].begin;
+                    blockTriplets[rowBlock].emplace_back(static_cast<int>(row - begin), static_cast<int>(column - begin), it.value());
+                } else if (columnBlock < rowBlock) {
+                    couplingTriplets.emplace_back(static_cast<int>(row), static_cast<int>(column), it.value());
+                } else if (it.value() != 0.0) {
+                    ++m_droppedEntries;
+                }
+            }
+        }
+        m_coupling.resize(n, n);
+        m_coupling.setFromTriplets(couplingTriplets.begin(), couplingTriplets.end());
+        m_coupling.makeCompressed();
+
+        // --- Factorize each diagonal block ---
+        for (size_t b = 0; b < m_blocks.size(); ++b) {
+            auto& block = m_blocks[b];
+            const auto size = static_cast<Eigen::Index>(block.size);
+            if (block.size <= DENSE_BLOCK_LIMIT) {
+                Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(size, size);
+                for (const auto& triplet : blockTriplets[b]) {
+                    dense(triplet.row(), triplet.col()) += triplet.value();
+                }
+                block.denseLU.compute(dense);
+                const auto pivots = block.denseLU.matrixLU().diagonal();
+                if (!pivots.allFinite() || (pivots.array() == 0.0).any()) {
+                    return false;
+                }
+            } else {
+                Eigen::SparseMatrix<double> sparse(size, size);
+                sparse.setFromTriplets(blockTriplets[b].begin(), blockTriplets[b].end());
+                sparse.makeCompressed();
+                if (!block.sparseLU) {
+                    block.sparseLU = std::make_unique<Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>>>();
+                }
+                block.sparseLU->compute(sparse);
+                if (block.sparseLU->info() != Eigen::Success) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    Eigen::VectorXd BlockTriangularLU::solve(const Eigen::VectorXd &b) const {
+        const auto n = static_cast<Eigen::Index>(m_ordering.ordering.size());
+
+        Eigen::VectorXd permuted(n);
+        for (Eigen::Index k = 0; k < n; ++k) {
+            permuted(k) = b(static_cast<Eigen::Index>(m_ordering.ordering[k]));
+        }
+
+        // --- Forward substitution over the blocks; permuted holds b on entry and x on exit ---
+        for (const auto& block : m_blocks) {
+            const auto begin = static_cast<Eigen::Index>(block.begin);
+            const auto size = static_cast<Eigen::Index>(block.size);
+            for (Eigen::Index row = begin; row < begin + size; ++row) {
+                for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(m_coupling, row); it; ++it) {
+                    permuted(row) -= it.value() * permuted(it.col());
+                }
+            }
+            const Eigen::VectorXd rhs = permuted.segment(begin, size);
+            if (block.size <= DENSE_BLOCK_LIMIT) {
+                permuted.segment(begin, size) = block.denseLU.solve(rhs);
+            } else {
+                permuted.segment(begin, size) = block.sparseLU->solve(rhs);
+            }
+        }
+
+        Eigen::VectorXd x(n);
+        for (Eigen::Index k = 0; k < n; ++k) {
+            x(static_cast<Eigen::Index>(m_ordering.ordering[k])) = permuted(k);
+        }
+        return x;
+    }
+}
@@ -1,15 +1,25 @@
 #include "gridfire/solver/solver.h"
+#include "gridfire/solver/solver.inl"
+#include "gridfire/solver/solver_imex.h"
+#include "gridfire/solver/solver_nse.h"
+#include "gridfire/solver/rosenbrock_controller.h"
 #include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_adaptive.h"
+#include "gridfire/engine/views/engine_defined.h"
+#include "gridfire/engine/views/engine_fused.h"
+#include "gridfire/engine/views/engine_drgep.h"
 #include "gridfire/network.h"
 
 #include "gridfire/utils/logging.h"
+#include "gridfire/utils/graph.h"
 
 #include "fourdst/composition/atomicSpecies.h"
 #include "fourdst/composition/composition.h"
 #include "fourdst/config/config.h"
 
 #include "Eigen/Dense"
-#include "unsupported/Eigen/NonLinearOptimization"
+#include "Eigen/Sparse"
+#include "Eigen/SparseLU"
 
 #include <boost/numeric/odeint.hpp>
 
@@ -18,14 +28,208 @@
 #include <string>
 #include <stdexcept>
 #include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <memory>
+
+#include "xxhash64.h"
 
 #include "quill/LogMacros.h"
 
+namespace {
+    constexpr double NEWTON_ARMIJO_FRACTION = 1.0e-4; ///< Fraction of the predicted merit decrease a QSE Newton step must achieve.
+    constexpr double NEWTON_MIN_DAMPING = 1.0e-4; ///< Smallest line search damping tried before a QSE Newton step is rejected.
+
+    uint64_t hashSpeciesNames(const gridfire::Engine& engine) {
+        uint64_t hash = 0;
+        for (const auto& species : engine.getNetworkSpecies()) {
+            const std::string_view name = species.name();
+            hash = XXHash64::hash(name.data(), name.size(), hash);
+        }
+        return hash;
+    }
+
+    /**
+     * @brief Indices of the light particles which parametrize the QSE clusters, if they are in the network.
+     */
+    struct LightParticles {
+        std::optional<size_t> proton;
+        std::optional<size_t> neutron;
+        std::optional<size_t> alpha;
+
+        explicit LightParticles(const std::vector<fourdst::atomic::Species>& species) {
+            for (size_t i = 0; i < species.size(); ++i) {
+                const int Z = species[i].z();
+                const int A = species[i].a();
+                if (Z == 1 && A == 1) {
+                    proton = i;
+                } else if (Z == 0 && A == 1) {
+                    neutron = i;
+                } else if (Z == 2 && A == 4) {
+                    alpha = i;
+                }
+            }
+        }
+
+        [[nodiscard]] bool contains(const size_t i) const {
+            return proton == i || neutron == i || alpha == i;
+        }
+    };
+
+    /**
+     * @brief Finds exponents w_k with sum_k w_k (Z_k, N_k) = (dZ, dN) over the light particles in the network.
+     * @return False if the difference cannot be made up from the light particles that are present.
+     */
+    bool lightParticleExponents(
+        const int dZ,
+        const int dN,
+        const LightParticles& light,
+        std::vector<std::pair<size_t, double>>& exponents
+    ) {
+        exponents.clear();
+        auto add = [&exponents](const size_t k, const double w) {
+            if (w != 0.0) {
+                exponents.emplace_back(k, w);
+            }
+        };
+        if (light.proton && light.neutron) {
+            add(*light.proton, dZ);
+            add(*light.neutron, dN);
+        } else if (light.proton && light.alpha) {
+            add(*light.alpha, 0.5 * dN);
+            add(*light.proton, dZ - dN);
+        } else if (light.neutron && light.alpha) {
+            add(*light.alpha, 0.5 * dZ);
+            add(*light.neutron, dN - dZ);
+        } else if (light.alpha && dZ == dN) {
+            add(*light.alpha, 0.5 * dZ);
+        } else if (light.proton && dN == 0) {
+            add(*light.proton, dZ);
+        } else if (light.neutron && dZ == 0) {
+            add(*light.neutron, dN);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replaces each cluster entry of a full vector by the sum over the cluster, held in the anchor slot.
+     *
+     * Applied to abundances this gives the cluster totals; applied to derivatives, their rates of change.
+     */
+    void collectClusterTotals(std::vector<double>& values, const std::vector<gridfire::solver::QSECluster>& clusters) {
+        for (const auto& cluster : clusters) {
+            for (const auto& member : cluster.members) {
+                values[cluster.anchorIndex] += values[member.speciesIndex];
+            }
+        }
+    }
+
+    /**
+     * @brief Splits the total abundance held in the anchor slot of each cluster over its members by their Saha ratios.
+     */
+    void distributeClusterAbundances(std::vector<double>& Y, const std::vector<gridfire::solver::QSECluster>& clusters) {
+        std::vector<double> lnRatios;
+        for (const auto& cluster : clusters) {
+            // Ratios to the anchor, shifted by the largest so that the sums cannot overflow
+            lnRatios.resize(cluster.members.size());
+            double shift = 0.0;
+            for (size_t m = 0; m < cluster.members.size(); ++m) {
+                const auto& member = cluster.members[m];
+                lnRatios[m] = member.lnRatio;
+                for (const auto& [k, w] : member.lightExponents) {
+                    lnRatios[m] += w * std::log(std::max(Y[k], std::numeric_limits<double>::min()));
+                }
+                shift = std::max(shift, lnRatios[m]);
+            }
+            double norm = std::exp(-shift);
+            for (const double lnRatio : lnRatios) {
+                norm += std::exp(lnRatio - shift);
+            }
+
+            const double total = Y[cluster.anchorIndex];
+            Y[cluster.anchorIndex] = total * std::exp(-shift) / norm;
+            for (size_t m = 0; m < cluster.members.size(); ++m) {
+                Y[cluster.members[m].speciesIndex] = total * std::exp(lnRatios[m] - shift) / norm;
+            }
+        }
+    }
+
+    /**
+     * @brief Gathers the dynamic state from full abundances, with the cluster totals in the anchor slots.
+     */
+    void gatherDynamicState(
+        const std::vector<double>& Y,
+        const gridfire::solver::dynamicQSESpeciesIndices& indices,
+        boost::numeric::ublas::vector<double>& YDynamic
+    ) {
+        std::vector<double> totals = Y;
+        collectClusterTotals(totals, indices.QSEClusters);
+        for (size_t i = 0; i < indices.dynamicSpeciesIndices.size(); ++i) {
+            YDynamic(i) = totals[indices.dynamicSpeciesIndices[i]];
+        }
+    }
+
+    /**
+     * @brief Scatters the dynamic state and the QSE abundances into full abundances and fills in the cluster members.
+     */
+    void scatterDynamicState(
+        const boost::numeric::ublas::vector<double>& YDynamic,
+        const Eigen::VectorXd& Y_QSE,
+        const gridfire::solver::dynamicQSESpeciesIndices& indices,
+        std::vector<double>& Y
+    ) {
+        for (size_t i = 0; i < indices.dynamicSpeciesIndices.size(); ++i) {
+            Y[indices.dynamicSpeciesIndices[i]] = YDynamic(i);
+        }
+        for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
+            Y[indices.QSESpeciesIndices[i]] = Y_QSE(i);
+        }
+        distributeClusterAbundances(Y, indices.QSEClusters);
+    }
+}
+
 namespace gridfire::solver {
 
+    SolverState::SolverState() = default;
+    SolverState::~SolverState() = default;
+    SolverState::SolverState(SolverState&&) noexcept = default;
+    SolverState& SolverState::operator=(SolverState&&) noexcept = default;
+
+    bool SolverState::isCompatibleWith(const Engine &engine) const {
+        return numSpecies == engine.getNetworkSpecies().size() && speciesHash == hashSpeciesNames(engine);
+    }
+
+    void SolverState::bind(const Engine &engine) {
+        numSpecies = engine.getNetworkSpecies().size();
+        speciesHash = hashSpeciesNames(engine);
+        T9 = 0.0;
+        rho = 0.0;
+        lastStepSize = 0.0;
+        rosenbrockController.reset();
+        QSEPartition.reset();
+        Y_QSE.resize(0);
+        IMEXPartition = {};
+        implicitSystem.reset();
+        stepsSinceJacobian = 0;
+        stiff.reset();
+        dominantEigenvector.clear();
+        NSELogNucleonAbundances.reset();
+        inNSE.reset();
+    }
+
     NetOut QSENetworkSolver::evaluate(const NetIn &netIn) {
+        SolverState state;
+        return evaluate(netIn, state);
+    }
+
+    NetOut QSENetworkSolver::evaluate(const NetIn &netIn, SolverState &state) {
         // --- Use the policy to decide whether to update the view ---
-        if (shouldUpdateView(netIn)) {
+        const bool viewUpdated = shouldUpdateView(netIn);
+        if (viewUpdated) {
             LOG_DEBUG(m_logger, "Solver update policy triggered, network view updating...");
             m_engine.update(netIn);
             LOG_DEBUG(m_logger, "Network view updated!");
@@ -33,11 +237,20 @@ namespace gridfire::solver {
             m_lastSeenConditions = netIn;
             m_isViewInitialized = true;
         }
-        m_engine.generateJacobianMatrix(netIn.MolarAbundance(), netIn.temperature / 1e9, netIn.density);
+        if (!state.isCompatibleWith(m_engine)) {
+            LOG_DEBUG(m_logger, "Solver state does not match the current network, resetting it.");
+            state.bind(m_engine);
+        }
         using state_type = boost::numeric::ublas::vector<double>;
         using namespace boost::numeric::odeint;
 
         NetOut postIgnition = initializeNetworkWithShortIgnition(netIn);
+        if (!state.isCompatibleWith(m_engine)) {
+            LOG_DEBUG(m_logger, "Network changed during the ignition pre-burn, resetting the solver state.");
+            state.bind(m_engine);
+        }
+        // After the pre-burn, which leaves the Jacobian of the engine at the ignition conditions
+        m_engine.generateJacobianMatrix(netIn.MolarAbundance(), netIn.temperature / 1e9, netIn.density);
 
         constexpr double abundance_floor = 1.0e-30;
         std::vector<double>Y_sanitized_initial;
@@ -58,11 +271,27 @@ namespace gridfire::solver {
         const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
         const double rho = netIn.density; // Density in g/cm^3
 
-        const auto indices = packSpeciesTypeIndexVectors(Y_sanitized_initial, T9, rho);
+        // --- Repartition with hysteresis against the previous partition; warm start the QSE solve if it is unchanged ---
+        const dynamicQSESpeciesIndices indices = packSpeciesTypeIndexVectors(Y_sanitized_initial, T9, rho, state.QSEPartition);
+        // Cluster members start at their Saha ratios to the anchor, keeping the initial total of each cluster
+        collectClusterTotals(Y_sanitized_initial, indices.QSEClusters);
+        distributeClusterAbundances(Y_sanitized_initial, indices.QSEClusters);
+        const bool reusePartition = state.QSEPartition.has_value() &&
+            state.QSEPartition->QSESpeciesIndices == indices.QSESpeciesIndices &&
+            state.QSEPartition->dynamicSpeciesIndices == indices.dynamicSpeciesIndices;
+
+        std::vector<double> Y_guess = Y_sanitized_initial;
+        if (reusePartition && static_cast<size_t>(state.Y_QSE.size()) == indices.QSESpeciesIndices.size()) {
+            LOG_DEBUG(m_logger, "Reusing QSE partition and warm starting the QSE solve from the previous evaluation.");
+            for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
+                Y_guess[indices.QSESpeciesIndices[i]] = state.Y_QSE(i);
+            }
+        }
+
         Eigen::VectorXd Y_QSE;
         try {
-            Y_QSE = calculateSteadyStateAbundances(Y_sanitized_initial, T9, rho, indices);
-            LOG_DEBUG(m_logger, "QSE Abundances: {}", [*this](const dynamicQSESpeciesIndices& indices, const Eigen::VectorXd& Y_QSE) -> std::string {
+            Y_QSE = calculateSteadyStateAbundances(Y_guess, T9, rho, indices);
+            LOG_TRACE_L1(m_logger, "QSE Abundances: {}", [*this](const dynamicQSESpeciesIndices& indices, const Eigen::VectorXd& Y_QSE) -> std::string {
                 std::stringstream ss;
                 ss << std::scientific << std::setprecision(5);
                 for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
@@ -84,30 +313,98 @@ namespace gridfire::solver {
         }
 
         state_type YDynamic_ublas(indices.dynamicSpeciesIndices.size() + 1);
-        for (size_t i = 0; i < indices.dynamicSpeciesIndices.size(); ++i) {
-            YDynamic_ublas(i) = Y_sanitized_initial[indices.dynamicSpeciesIndices[i]];
-        }
+        gatherDynamicState(Y_sanitized_initial, indices, YDynamic_ublas);
         YDynamic_ublas(indices.dynamicSpeciesIndices.size()) = 0.0; // Placeholder for specific energy rate
 
-        const RHSFunctor rhs_functor(m_engine, indices.dynamicSpeciesIndices, indices.QSESpeciesIndices, Y_QSE, T9, rho);
-        const auto stepper = make_controlled<runge_kutta_dopri5<state_type>>(1.0e-8, 1.0e-8);
+        const RHSFunctor rhs_functor(m_engine, indices.dynamicSpeciesIndices, indices.QSESpeciesIndices, indices.QSEClusters, Y_QSE, T9, rho);
+        auto stepper = make_controlled<runge_kutta_dopri5<state_type>>(1.0e-8, 1.0e-8);
+
+        const size_t numDynamic = indices.dynamicSpeciesIndices.size();
+
+        // --- Re-project the QSE species onto their algebraic constraint after accepted steps ---
+        const auto reequilibrationInterval = m_config.get<size_t>("gridfire:solver:QSE:reequilibrationInterval", 1);
+        size_t stepsSinceReequilibration = 0;
+        size_t reequilibrations = 0;
+        auto reequilibrate = [&](const state_type& YDynamic) -> bool {
+            if (reequilibrationInterval == 0 || indices.QSESpeciesIndices.empty() ||
+                ++stepsSinceReequilibration < reequilibrationInterval) {
+                return false;
+            }
+            stepsSinceReequilibration = 0;
+
+            // Warm start from the current QSE abundances
+            std::vector<double> YCurrent = Y_sanitized_initial;
+            scatterDynamicState(YDynamic, Y_QSE, indices, YCurrent);
+            try {
+                Y_QSE = calculateSteadyStateAbundances(YCurrent, T9, rho, indices);
+            } catch (const std::runtime_error& e) {
+                LOG_WARNING(m_logger, "QSE re-equilibration failed ({}), keeping the previous QSE abundances.", e.what());
+                return false;
+            }
+            ++reequilibrations;
+            return true;
+        };
+
+        // --- Event monitoring; the QSE species are slaved to the dynamic ones, so their derivatives are not integrated ---
+        EventMonitor eventMonitor(m_events, m_engine, T9, rho);
+        std::optional<EventLocation> event;
+        auto makeEventEndpoint = [&](const double t, const state_type& YDynamic) -> EventStepEndpoint {
+            std::vector<double> YFull = Y_sanitized_initial;
+            scatterDynamicState(YDynamic, Y_QSE, indices, YFull);
+            EventStepEndpoint endpoint = eventMonitor.makeEndpoint(t, std::move(YFull), YDynamic(numDynamic));
+            for (const size_t i : indices.QSESpeciesIndices) {
+                endpoint.dydt[i] = 0.0;
+            }
+            for (const auto& cluster : indices.QSEClusters) {
+                for (const auto& member : cluster.members) {
+                    endpoint.dydt[member.speciesIndex] = 0.0;
+                }
+            }
+            return endpoint;
+        };
+        if (!eventMonitor.empty()) {
+            eventMonitor.initialize(makeEventEndpoint(0.0, YDynamic_ublas));
+        }
 
-        size_t stepCount = integrate_adaptive(
+        double dt = state.lastStepSize > 0.0 ? state.lastStepSize : netIn.dt0;
+        const size_t stepCount = detail::integrateControlled(
             stepper,
             rhs_functor,
             YDynamic_ublas,
-            0.0, // Start time
+            0.0,
             netIn.tMax,
-            netIn.dt0
+            dt,
+            m_logger,
+            [&](const double t, const state_type& YDynamic) -> bool {
+                if (reequilibrate(YDynamic)) {
+                    // The right-hand side changed discontinuously, so the FSAL derivative is stale
+                    stepper.reset();
+                }
+                if (eventMonitor.empty()) {
+                    return false;
+                }
+                event = eventMonitor.checkStep(makeEventEndpoint(t, YDynamic));
+                return event.has_value();
+            }
         );
+        LOG_DEBUG(m_logger, "QSE species re-equilibrated {} times over {} accepted steps.", reequilibrations, stepCount);
+        if (event.has_value()) {
+            LOG_INFO(m_logger, "Event '{}' triggered at t = {:0.3E} s.", event->name, event->t);
+            gatherDynamicState(event->Y, indices, YDynamic_ublas);
+            for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
+                Y_QSE(i) = event->Y[indices.QSESpeciesIndices[i]];
+            }
+            YDynamic_ublas(numDynamic) = event->energy;
+        }
+
+        state.lastStepSize = dt;
+        state.QSEPartition = indices;
+        state.Y_QSE = Y_QSE;
+        state.T9 = T9;
+        state.rho = rho;
 
         std::vector<double> YFinal = Y_sanitized_initial;
-        for (size_t i = 0; i <indices.dynamicSpeciesIndices.size(); ++i) {
-            YFinal[indices.dynamicSpeciesIndices[i]] = YDynamic_ublas(i);
-        }
-        for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
-            YFinal[indices.QSESpeciesIndices[i]] = Y_QSE(i);
-        }
+        scatterDynamicState(YDynamic_ublas, Y_QSE, indices, YFinal);
 
         const double finalSpecificEnergyRate = YDynamic_ublas(indices.dynamicSpeciesIndices.size());
 
@@ -131,28 +428,45 @@ namespace gridfire::solver {
         netOut.composition = outputComposition;
         netOut.energy = finalSpecificEnergyRate; // Specific energy rate
         netOut.num_steps = stepCount;
+        netOut.time = event.has_value() ? event->t : netIn.tMax;
+        netOut.triggeredEvent = event.has_value() ? event->name : "";
         return netOut;
     }
 
     dynamicQSESpeciesIndices QSENetworkSolver::packSpeciesTypeIndexVectors(
         const std::vector<double>& Y,
         const double T9,
-        const double rho
+        const double rho,
+        const std::optional<dynamicQSESpeciesIndices>& previous
     ) const {
         constexpr double timescaleCutoff = 1.0e-5;
         constexpr double abundanceCutoff = 1.0e-15;
+        const auto hysteresis = m_config.get<double>("gridfire:solver:QSE:partition:hysteresis", 10.0);
+
+        LOG_DEBUG(m_logger, "Partitioning species using T9={:0.2f} and ρ={:0.2e}", T9, rho);
+        LOG_DEBUG(m_logger, "Timescale Cutoff: {:.1e} s, Abundance Cutoff: {:.1e}", timescaleCutoff, abundanceCutoff);
 
-        LOG_INFO(m_logger, "Partitioning species using T9={:0.2f} and ρ={:0.2e}", T9, rho);
-        LOG_INFO(m_logger, "Timescale Cutoff: {:.1e} s, Abundance Cutoff: {:.1e}", timescaleCutoff, abundanceCutoff);
+        const size_t numSpecies = m_engine.getNetworkSpecies().size();
+
+        // --- Side of each species in the previous partition, if any ---
+        std::vector<uint8_t> previouslyQSE;
+        if (previous.has_value()) {
+            previouslyQSE.assign(numSpecies, 0);
+            for (const size_t i : previous->QSESpeciesIndices) {
+                previouslyQSE[i] = 1;
+            }
+        }
 
         std::vector<size_t>dynamicSpeciesIndices; // Slow species that are not in QSE
         std::vector<size_t>QSESpeciesIndices;  // Fast species that are in QSE
 
-        std::unordered_map<fourdst::atomic::Species, double> speciesTimescale = m_engine.getSpeciesTimescales(Y, T9, rho);
+        const auto [dydt, nuclearEnergyGenerationRate] = m_engine.calculateRHSAndEnergy(Y, T9, rho);
 
-        for (size_t i = 0; i < m_engine.getNetworkSpecies().size(); ++i) {
+        for (size_t i = 0; i < numSpecies; ++i) {
             const auto& species = m_engine.getNetworkSpecies()[i];
-            const double network_timescale = speciesTimescale.at(species);
+            const double network_timescale = std::abs(dydt[i]) > 0.0 ?
+                std::abs(Y[i] / dydt[i]) :
+                std::numeric_limits<double>::infinity();
             const double abundance = Y[i];
 
             double decay_timescale = std::numeric_limits<double>::infinity();
@@ -164,14 +478,82 @@ namespace gridfire::solver {
 
             const double final_timescale = std::min(network_timescale, decay_timescale);
 
-            if (std::isinf(final_timescale) || abundance < abundanceCutoff || final_timescale <= timescaleCutoff) {
+            // Without a previous partition the cutoffs are used as is; otherwise they are widened away from the previous side.
+            double timescaleThreshold = timescaleCutoff;
+            double abundanceThreshold = abundanceCutoff;
+            if (!previouslyQSE.empty()) {
+                const double factor = previouslyQSE[i] ? hysteresis : 1.0 / hysteresis;
+                timescaleThreshold *= factor;
+                abundanceThreshold *= factor;
+            }
+
+            if (std::isinf(final_timescale) || abundance < abundanceThreshold || final_timescale <= timescaleThreshold) {
                 QSESpeciesIndices.push_back(i);
             } else {
                 dynamicSpeciesIndices.push_back(i);
             }
         }
-        LOG_INFO(m_logger, "Partitioning complete. Dynamical species: {}, QSE species: {}.", dynamicSpeciesIndices.size(), QSESpeciesIndices.size());
-        LOG_INFO(m_logger, "Dynamic species: {}", [dynamicSpeciesIndices](const DynamicEngine& engine_wrapper) -> std::string {
+        std::vector<QSECluster> clusters;
+        if (m_config.get<bool>("gridfire:solver:QSE:clusters:enabled", false)) {
+            const auto& networkSpecies = m_engine.getNetworkSpecies();
+            const LightParticles light(networkSpecies);
+            auto sahaLogOffset = [&networkSpecies, T9, rho](const size_t i) {
+                const auto& species = networkSpecies[i];
+                return NSENetworkSolver::sahaLogOffset(species, T9, rho, NSENetworkSolver::groundStatePartitionFunction(species, T9));
+            };
+
+            // --- Parametrize each cluster by its anchor and the light particles; 0 dynamic, 1 QSE, 2 cluster member ---
+            std::vector<uint8_t> side(numSpecies, 0);
+            for (const size_t i : QSESpeciesIndices) {
+                side[i] = 1;
+            }
+            for (const auto& component : detectQSEClusters(Y, T9, rho)) {
+                const size_t anchor = component.front();
+                const auto& anchorSpecies = networkSpecies[anchor];
+                const double anchorOffset = sahaLogOffset(anchor);
+
+                QSECluster cluster{anchor, {}};
+                for (size_t m = 1; m < component.size(); ++m) {
+                    const auto& species = networkSpecies[component[m]];
+                    const int dZ = species.z() - anchorSpecies.z();
+                    const int dN = (species.a() - species.z()) - (anchorSpecies.a() - anchorSpecies.z());
+                    QSECluster::Member member{component[m], sahaLogOffset(component[m]) - anchorOffset, {}};
+                    if (!lightParticleExponents(dZ, dN, light, member.lightExponents)) {
+                        side[component[m]] = 1; // Left to the flat QSE solve
+                        continue;
+                    }
+                    for (const auto& [k, w] : member.lightExponents) {
+                        member.lnRatio -= w * sahaLogOffset(k);
+                    }
+                    cluster.members.push_back(std::move(member));
+                }
+                if (cluster.members.empty()) {
+                    continue;
+                }
+
+                side[anchor] = 0;
+                for (const auto& member : cluster.members) {
+                    side[member.speciesIndex] = 2;
+                    for (const auto& [k, w] : member.lightExponents) {
+                        side[k] = 0;
+                    }
+                }
+                clusters.push_back(std::move(cluster));
+            }
+            dynamicSpeciesIndices.clear();
+            QSESpeciesIndices.clear();
+            for (size_t i = 0; i < numSpecies; ++i) {
+                if (side[i] == 0) {
+                    dynamicSpeciesIndices.push_back(i);
+                } else if (side[i] == 1) {
+                    QSESpeciesIndices.push_back(i);
+                }
+            }
+            LOG_DEBUG(m_logger, "Found {} QSE clusters.", clusters.size());
+        }
+
+        LOG_DEBUG(m_logger, "Partitioning complete. Dynamical species: {}, QSE species: {}.", dynamicSpeciesIndices.size(), QSESpeciesIndices.size());
+        LOG_TRACE_L1(m_logger, "Dynamic species: {}", [dynamicSpeciesIndices](const DynamicEngine& engine_wrapper) -> std::string {
             std::string result;
             int count = 0;
             for (const auto& i : dynamicSpeciesIndices) {
@@ -185,7 +567,7 @@ namespace gridfire::solver {
             }
             return result;
         }(m_engine));
-        LOG_INFO(m_logger, "QSE species: {}", [QSESpeciesIndices](const DynamicEngine& engine_wrapper) -> std::string {
+        LOG_TRACE_L1(m_logger, "QSE species: {}", [QSESpeciesIndices](const DynamicEngine& engine_wrapper) -> std::string {
             std::string result;
             int count = 0;
             for (const auto& i : QSESpeciesIndices) {
@@ -199,7 +581,65 @@ namespace gridfire::solver {
             }
             return result;
         }(m_engine));
-        return {dynamicSpeciesIndices, QSESpeciesIndices};
+        return {dynamicSpeciesIndices, QSESpeciesIndices, clusters};
+    }
+
+    std::vector<std::vector<size_t>> QSENetworkSolver::detectQSEClusters(
+        const std::vector<double> &Y,
+        const double T9,
+        const double rho
+    ) const {
+        const auto linkTimescale = m_config.get<double>("gridfire:solver:QSE:clusters:linkTimescale", 1.0e-5);
+        const auto minClusterSize = m_config.get<size_t>("gridfire:solver:QSE:clusters:minSize", 2);
+
+        const auto& networkSpecies = m_engine.getNetworkSpecies();
+        std::unordered_map<fourdst::atomic::Species, size_t> speciesIndices;
+        for (size_t i = 0; i < networkSpecies.size(); ++i) {
+            speciesIndices.emplace(networkSpecies[i], i);
+        }
+
+        // --- Fast links, reactant -> product, from the current reaction flows ---
+        std::vector<std::pair<size_t, size_t>> fastLinks;
+        const auto& reactions = m_engine.getNetworkReactions();
+        const std::vector<double> flows = m_engine.calculateAllMolarReactionFlows(Y, T9, rho);
+        for (size_t r = 0; r < reactions.size(); ++r) {
+            const auto& reaction = reactions[r];
+            const double speciesRate = flows[r] / rho;
+            if (!(speciesRate > 0.0)) {
+                continue;
+            }
+            for (const auto& reactant : reaction.reactants()) {
+                const size_t i = speciesIndices.at(reactant);
+                if (Y[i] / speciesRate > linkTimescale) {
+                    continue;
+                }
+                for (const auto& product : reaction.products()) {
+                    const size_t j = speciesIndices.at(product);
+                    if (j != i) {
+                        fastLinks.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+
+        std::vector<size_t> offsets, targets;
+        utils::buildAdjacency(networkSpecies.size(), fastLinks, offsets, targets);
+
+        // --- The light particles parametrize the clusters, so they are not members ---
+        const LightParticles light(networkSpecies);
+        std::vector<std::vector<size_t>> clusters;
+        for (auto& component : utils::stronglyConnectedComponents(networkSpecies.size(), offsets, targets)) {
+            std::erase_if(component, [&light](const size_t i) { return light.contains(i); });
+            if (component.size() < std::max<size_t>(minClusterSize, 2)) {
+                continue;
+            }
+            // Anchor on the most abundant member, and keep the rest in index order
+            const auto anchor = std::ranges::max_element(component, {}, [&Y](const size_t i) { return Y[i]; });
+            std::iter_swap(component.begin(), anchor);
+            std::sort(component.begin() + 1, component.end());
+            clusters.push_back(std::move(component));
+        }
+        return clusters;
     }
 
     Eigen::VectorXd QSENetworkSolver::calculateSteadyStateAbundances(
@@ -214,54 +654,133 @@ namespace gridfire::solver {
             LOG_DEBUG(m_logger, "No QSE species to solve for.");
             return Eigen::VectorXd(0);
         }
-        // Use the EigenFunctor with Eigen's nonlinear solver
-        EigenFunctor<double> functor(
-            m_engine,
-            Y,
-            indices.dynamicSpeciesIndices,
-            indices.QSESpeciesIndices,
-            T9,
-            rho
-        );
+        const auto maxIterations = m_config.get<int>("gridfire:solver:QSE:newton:maxIterations", 50);
+        const auto tolerance = m_config.get<double>("gridfire:solver:QSE:newton:tolerance", 1.0e-8);
+        const auto maxLogStep = m_config.get<double>("gridfire:solver:QSE:newton:maxLogStep", 5.0);
+        const auto jacobianReuseRate = m_config.get<double>("gridfire:solver:QSE:newton:jacobianReuseRate", 0.5);
 
-        Eigen::VectorXd v_qse_log_initial(indices.QSESpeciesIndices.size());
+        QSENewtonSystem system(m_engine, Y, indices.QSESpeciesIndices, T9, rho);
+
+        Eigen::VectorXd v(indices.QSESpeciesIndices.size());
         for (size_t i = 0; i < indices.QSESpeciesIndices.size(); ++i) {
-            v_qse_log_initial(i) = std::log(std::max(Y[indices.QSESpeciesIndices[i]], 1e-99));
-        }
-
-        const static std::unordered_map<Eigen::LevenbergMarquardtSpace::Status, const char*> statusMessages = {
-            {Eigen::LevenbergMarquardtSpace::NotStarted, "Not started"},
-            {Eigen::LevenbergMarquardtSpace::Running, "Running"},
-            {Eigen::LevenbergMarquardtSpace::ImproperInputParameters, "Improper input parameters"},
-            {Eigen::LevenbergMarquardtSpace::RelativeReductionTooSmall, "Relative reduction too small"},
-            {Eigen::LevenbergMarquardtSpace::RelativeErrorTooSmall, "Relative error too small"},
-            {Eigen::LevenbergMarquardtSpace::RelativeErrorAndReductionTooSmall, "Relative error and reduction too small"},
-            {Eigen::LevenbergMarquardtSpace::CosinusTooSmall, "Cosine too small"},
-            {Eigen::LevenbergMarquardtSpace::TooManyFunctionEvaluation, "Too many function evaluations"},
-            {Eigen::LevenbergMarquardtSpace::FtolTooSmall, "Function tolerance too small"},
-            {Eigen::LevenbergMarquardtSpace::XtolTooSmall, "X tolerance too small"},
-            {Eigen::LevenbergMarquardtSpace::GtolTooSmall, "Gradient tolerance too small"},
-            {Eigen::LevenbergMarquardtSpace::UserAsked, "User asked to stop"}
-        };
+            v(i) = std::log(std::max(Y[indices.QSESpeciesIndices[i]], 1e-99));
+        }
 
-        Eigen::LevenbergMarquardt lm(functor);
-        const Eigen::LevenbergMarquardtSpace::Status info = lm.minimize(v_qse_log_initial);
+        Eigen::VectorXd F;
+        system.residual(v, F);
+        double merit = 0.5 * F.squaredNorm();
+
+        Eigen::SparseMatrix<double> J;
+        Eigen::SparseLU<Eigen::SparseMatrix<double>> lu;
+        Eigen::VectorXd vTrial, FTrial;
+        bool factorized = false;
+        bool freshJacobian = false;
+        int factorizations = 0;
+        double previousStepNorm = 0.0;
+
+        for (int iteration = 0; iteration < maxIterations; ++iteration) {
+            if (merit == 0.0) {
+                LOG_DEBUG(m_logger, "QSE Newton solve found an exact steady state after {} iterations.", iteration);
+                return v.array().exp();
+            }
+
+            if (!factorized) {
+                system.jacobian(v, J);
+                lu.compute(J);
+                ++factorizations;
+                if (lu.info() != Eigen::Success) {
+                    LOG_ERROR(m_logger, "QSE Newton solve failed to factorize the QSE Jacobian at iteration {}.", iteration);
+                    throw std::runtime_error("QSE Newton solve failed: singular QSE Jacobian.");
+                }
+                factorized = true;
+                freshJacobian = true;
+            }
+
+            const Eigen::VectorXd step = -lu.solve(F);
+            const double stepNorm = step.allFinite() ? step.cwiseAbs().maxCoeff() : std::numeric_limits<double>::infinity();
+
+            // --- Backtracking line search on 0.5 |F|^2, starting from a step limited to maxLogStep ---
+            double lambda = std::isfinite(stepNorm) ? std::min(1.0, maxLogStep / std::max(stepNorm, std::numeric_limits<double>::min())) : 0.0;
+            bool accepted = false;
+            while (lambda >= NEWTON_MIN_DAMPING) {
+                vTrial = v + lambda * step;
+                system.residual(vTrial, FTrial);
+                const double trialMerit = 0.5 * FTrial.squaredNorm();
+                // With an exact Jacobian the directional derivative of the merit along the Newton step is -2 * merit
+                if (std::isfinite(trialMerit) && trialMerit <= (1.0 - 2.0 * NEWTON_ARMIJO_FRACTION * lambda) * merit) {
+                    accepted = true;
+                    merit = trialMerit;
+                    break;
+                }
+                lambda *= 0.5;
+            }
+
+            if (!accepted) {
+                if (!freshJacobian) {
+                    LOG_TRACE_L2(m_logger, "QSE Newton line search failed with a reused factorization, re-evaluating the Jacobian.");
+                    factorized = false;
+                    continue;
+                }
+                LOG_ERROR(m_logger, "QSE Newton line search failed at iteration {} (residual norm {:0.3E}).", iteration, F.norm());
+                throw std::runtime_error("QSE Newton solve failed: line search could not reduce the residual.");
+            }
 
-        if (info <= 0 || info >= 4) {
-            LOG_ERROR(m_logger, "QSE species minimization failed with status: {} ({})",
-                      static_cast<int>(info), statusMessages.at(info));
-            throw std::runtime_error(
-                "QSE species minimization failed with status: " + std::to_string(static_cast<int>(info)) +
-                " (" + std::string(statusMessages.at(info)) + ")"
-            );
+            std::swap(v, vTrial);
+            std::swap(F, FTrial);
+            const double takenStepNorm = lambda * stepNorm;
+            LOG_TRACE_L2(m_logger, "QSE Newton iteration {}: step {:0.3E}, damping {:0.3E}, residual norm {:0.3E}.", iteration, takenStepNorm, lambda, F.norm());
+
+            if (takenStepNorm < tolerance) {
+                LOG_DEBUG(m_logger, "QSE Newton solve converged in {} iterations with {} Jacobian factorizations.", iteration + 1, factorizations);
+                return v.array().exp();
+            }
+
+            // --- Keep the factorization only while it still yields fast contraction ---
+            if (lambda < 1.0 || (previousStepNorm > 0.0 && takenStepNorm > jacobianReuseRate * previousStepNorm)) {
+                factorized = false;
+            }
+            freshJacobian = false;
+            previousStepNorm = takenStepNorm;
+        }
+
+        LOG_ERROR(m_logger, "QSE Newton solve did not converge in {} iterations (residual norm {:0.3E}).", maxIterations, F.norm());
+        throw std::runtime_error("QSE Newton solve did not converge in " + std::to_string(maxIterations) + " iterations.");
+    }
+
+    void QSENetworkSolver::QSENewtonSystem::residual(const Eigen::VectorXd &v_QSE_log, Eigen::VectorXd &f_QSE) {
+        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
+            m_Y[m_QSESpeciesIndices[i]] = std::exp(v_QSE_log(i));
+        }
+
+        const std::vector<double> dydt_QSE = m_engine.calculateRHSSubset(m_Y, m_QSESpeciesIndices, m_T9, m_rho);
+        f_QSE = Eigen::Map<const Eigen::VectorXd>(dydt_QSE.data(), static_cast<Eigen::Index>(dydt_QSE.size()));
+    }
+
+    void QSENetworkSolver::QSENewtonSystem::jacobian(const Eigen::VectorXd &v_QSE_log, Eigen::SparseMatrix<double> &J_QSE) {
+        for (size_t i = 0; i < m_QSESpeciesIndices.size(); ++i) {
+            m_Y[m_QSESpeciesIndices[i]] = std::exp(v_QSE_log(i));
         }
-        LOG_DEBUG(m_logger, "QSE species minimization completed successfully with status: {} ({})",
-                  static_cast<int>(info), statusMessages.at(info));
-        return v_qse_log_initial.array().exp();
 
+        const std::vector<double> values = m_engine.calculateJacobianSubset(m_Y, m_QSESpeciesIndices, m_jacobianPattern, m_T9, m_rho);
+
+        const size_t numQSE = m_QSESpeciesIndices.size();
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(m_jacobianPattern.nonZeros());
+        for (size_t i = 0; i < numQSE; ++i) {
+            for (size_t k = m_jacobianPattern.rowOffsets[i]; k < m_jacobianPattern.rowOffsets[i + 1]; ++k) {
+                if (values[k] != 0.0) {
+                    const size_t j = m_jacobianPattern.columnIndices[k];
+                    // Chain rule for the log space transformation, dF_i/dv_j = J_ij * Y_j
+                    triplets.emplace_back(i, j, values[k] * m_Y[m_QSESpeciesIndices[j]]);
+                }
+            }
+        }
+        J_QSE.resize(static_cast<Eigen::Index>(numQSE), static_cast<Eigen::Index>(numQSE));
+        J_QSE.setFromTriplets(triplets.begin(), triplets.end());
+        J_QSE.makeCompressed();
     }
 
-    NetOut QSENetworkSolver::initializeNetworkWithShortIgnition(const NetIn &netIn) const {
+    NetOut QSENetworkSolver::initializeNetworkWithShortIgnition(const NetIn &netIn) {
         const auto ignitionTemperature = m_config.get<double>(
             "gridfire:solver:QSE:ignition:temperature",
             2e8
@@ -279,6 +798,40 @@ namespace gridfire::solver {
             1e-15
         ); // 1e-15 seconds
 
+        if (hasPopulatedIntermediates(netIn)) {
+            LOG_DEBUG(m_logger, "Composition already has populated intermediates, skipping network ignition.");
+            NetOut unchanged;
+            unchanged.composition = netIn.composition;
+            unchanged.num_steps = 0;
+            unchanged.energy = 0.0;
+            return unchanged;
+        }
+
+        const auto cacheSize = m_config.get<size_t>("gridfire:solver:QSE:ignition:cacheSize", 64);
+
+        // --- Key the cache on the network abundances, ignition conditions and rate multipliers, seeded by the reaction set ---
+        const auto& networkSpecies = m_engine.getNetworkSpecies();
+        std::vector<double> keyData;
+        keyData.reserve(networkSpecies.size() + 4);
+        for (const auto& species : networkSpecies) {
+            keyData.push_back(netIn.composition.contains(species) ?
+                netIn.composition.getMolarAbundance(std::string(species.name())) : 0.0);
+        }
+        keyData.insert(keyData.end(), {ignitionTemperature, ignitionDensity, ignitionTime, ignitionStepSize});
+        const uint64_t multiplierGeneration = m_engine.getRateMultiplierGeneration();
+        const uint64_t cacheKey = XXHash64::hash(
+            keyData.data(),
+            keyData.size() * sizeof(double),
+            XXHash64::hash(&multiplierGeneration, sizeof(multiplierGeneration), m_engine.getNetworkReactions().hash(0))
+        );
+
+        if (cacheSize > 0) {
+            if (const auto it = m_ignitionCache.find(cacheKey); it != m_ignitionCache.end()) {
+                LOG_DEBUG(m_logger, "Reusing cached network ignition result ({} entries cached).", m_ignitionCache.size());
+                return it->second;
+            }
+        }
+
         LOG_INFO(
             m_logger,
             "Igniting network with T={:<5.3E}, ρ={:<5.3E}, tMax={:<5.3E}, dt0={:<5.3E}...",
@@ -298,13 +851,43 @@ namespace gridfire::solver {
         LOG_DEBUG(m_logger, "Setting screening model to BARE for high temperature and density ignition.");
         m_engine.setScreeningModel(screening::ScreeningType::BARE);
         DirectNetworkSolver ignitionSolver(m_engine);
+        // The engine is culled for the conditions of the zone, not those of the pre-burn
+        ignitionSolver.setRecullDuringIntegration(false);
         NetOut postIgnition = ignitionSolver.evaluate(preIgnition);
         LOG_INFO(m_logger, "Network ignition completed in {} steps.", postIgnition.num_steps);
         m_engine.setScreeningModel(prevScreeningModel);
         LOG_DEBUG(m_logger, "Restoring previous screening model: {}", static_cast<int>(prevScreeningModel));
+
+        if (cacheSize > 0) {
+            while (m_ignitionCacheOrder.size() >= cacheSize) {
+                m_ignitionCache.erase(m_ignitionCacheOrder.front());
+                m_ignitionCacheOrder.pop_front();
+            }
+            m_ignitionCache.emplace(cacheKey, postIgnition);
+            m_ignitionCacheOrder.push_back(cacheKey);
+        }
         return postIgnition;
     }
 
+    bool QSENetworkSolver::hasPopulatedIntermediates(const NetIn &netIn) const {
+        const auto populatedAbundance = m_config.get<double>("gridfire:solver:QSE:ignition:populatedAbundance", 1.0e-20);
+        const auto populatedFraction = m_config.get<double>("gridfire:solver:QSE:ignition:populatedFraction", 0.9);
+
+        const auto& networkSpecies = m_engine.getNetworkSpecies();
+        if (networkSpecies.empty()) {
+            return false;
+        }
+
+        size_t populatedCount = 0;
+        for (const auto& species : networkSpecies) {
+            if (netIn.composition.contains(species) &&
+                netIn.composition.getMolarAbundance(std::string(species.name())) >= populatedAbundance) {
+                ++populatedCount;
+            }
+        }
+        return static_cast<double>(populatedCount) >= populatedFraction * static_cast<double>(networkSpecies.size());
+    }
+
     bool QSENetworkSolver::shouldUpdateView(const NetIn &conditions) const {
         // Policy 1: If the view has never been initialized, we must update.
         if (!m_isViewInitialized) {
@@ -363,7 +946,11 @@ namespace gridfire::solver {
             YFull[m_QSESpeciesIndices[i]] = m_Y_QSE(i);
         }
 
+        // --- Split the cluster totals over the cluster members ---
+        distributeClusterAbundances(YFull, m_QSEClusters);
+
         auto [full_dYdt, specificEnergyRate] = m_engine.calculateRHSAndEnergy(YFull, m_T9, m_rho);
+        collectClusterTotals(full_dYdt, m_QSEClusters); // The anchors integrate the cluster totals
 
         dYdtDynamic.resize(m_dynamicSpeciesIndices.size() + 1);
         for (size_t i = 0; i < m_dynamicSpeciesIndices.size(); ++i) {
@@ -372,106 +959,11 @@ namespace gridfire::solver {
         dYdtDynamic[m_dynamicSpeciesIndices.size()] = specificEnergyRate;
     }
 
-    NetOut DirectNetworkSolver::evaluate(const NetIn &netIn) {
-        namespace ublas = boost::numeric::ublas;
-        namespace odeint = boost::numeric::odeint;
-        using fourdst::composition::Composition;
-
-
-        const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
-        const unsigned long numSpecies = m_engine.getNetworkSpecies().size();
-
-        const auto absTol = m_config.get<double>("gridfire:solver:DirectNetworkSolver:absTol", 1.0e-8);
-        const auto relTol = m_config.get<double>("gridfire:solver:DirectNetworkSolver:relTol", 1.0e-8);
-
-        size_t stepCount = 0;
-
-        RHSFunctor rhsFunctor(m_engine, T9, netIn.density);
-        JacobianFunctor jacobianFunctor(m_engine, T9, netIn.density);
-
-        ublas::vector<double> Y(numSpecies + 1);
-
-        for (size_t i = 0; i < numSpecies; ++i) {
-            const auto& species = m_engine.getNetworkSpecies()[i];
-            try {
-                Y(i) = netIn.composition.getMolarAbundance(std::string(species.name()));
-            } catch (const std::runtime_error) {
-                LOG_DEBUG(m_logger, "Species '{}' not found in composition. Setting abundance to 0.0.", species.name());
-                Y(i) = 0.0;
-            }
-        }
-        Y(numSpecies) = 0.0;
-
-        const auto stepper = odeint::make_controlled<odeint::rosenbrock4<double>>(absTol, relTol);
-        stepCount = odeint::integrate_adaptive(
-            stepper,
-            std::make_pair(rhsFunctor, jacobianFunctor),
-            Y,
-            0.0,
-            netIn.tMax,
-            netIn.dt0
-        );
-
-        std::vector<double> finalMassFractions(numSpecies);
-        for (size_t i = 0; i < numSpecies; ++i) {
-            const double molarMass = m_engine.getNetworkSpecies()[i].mass();
-            finalMassFractions[i] = Y(i) * molarMass; // Convert from molar abundance to mass fraction
-            if (finalMassFractions[i] < MIN_ABUNDANCE_THRESHOLD) {
-                finalMassFractions[i] = 0.0;
-            }
-        }
-
-        std::vector<std::string> speciesNames;
-        speciesNames.reserve(numSpecies);
-        for (const auto& species : m_engine.getNetworkSpecies()) {
-            speciesNames.push_back(std::string(species.name()));
-        }
-
-        Composition outputComposition(speciesNames);
-        outputComposition.setMassFraction(speciesNames, finalMassFractions);
-        outputComposition.finalize(true);
-
-        NetOut netOut;
-        netOut.composition = std::move(outputComposition);
-        netOut.energy = Y(numSpecies); // Specific energy rate
-        netOut.num_steps = stepCount;
-
-        return netOut;
-    }
-
-    void DirectNetworkSolver::RHSFunctor::operator()(
-        const boost::numeric::ublas::vector<double> &Y,
-        boost::numeric::ublas::vector<double> &dYdt,
-        double t
-    ) const {
-        const std::vector<double> y(Y.begin(), m_numSpecies + Y.begin());
-
-        // std::string timescales = utils::formatNuclearTimescaleLogString(
-        //     m_engine,
-        //     y,
-        //     m_T9,
-        //     m_rho
-        // );
-        // LOG_TRACE_L2(m_logger, "{}", timescales);
-
-        auto [dydt, eps] = m_engine.calculateRHSAndEnergy(y, m_T9, m_rho);
-        dYdt.resize(m_numSpecies + 1);
-        std::ranges::copy(dydt, dYdt.begin());
-        dYdt(m_numSpecies) = eps;
-    }
-
-    void DirectNetworkSolver::JacobianFunctor::operator()(
-        const boost::numeric::ublas::vector<double> &Y,
-        boost::numeric::ublas::matrix<double> &J,
-        double t,
-        boost::numeric::ublas::vector<double> &dfdt
-    ) const {
-        J.resize(m_numSpecies+1, m_numSpecies+1);
-        J.clear();
-        for (int i = 0; i < m_numSpecies; ++i) {
-            for (int j = 0; j < m_numSpecies; ++j) {
-                J(i, j) = m_engine.getJacobianMatrixEntry(i, j);
-            }
-        }
-    }
-}
\ No newline at end of file
+    // --- Explicit instantiations, declared extern in solver.inl: dynamic dispatch, and static dispatch on each final engine type ---
+    template class BasicDirectNetworkSolver<DynamicEngine>;
+    template class BasicDirectNetworkSolver<GraphEngine>;
+    template class BasicDirectNetworkSolver<AdaptiveEngineView>;
+    template class BasicDirectNetworkSolver<FileDefinedEngineView>;
+    template class BasicDirectNetworkSolver<FusedEngineView>;
+    template class BasicDirectNetworkSolver<DRGEPEngineView>;
+}
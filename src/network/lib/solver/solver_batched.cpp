@@ -0,0 +1,292 @@
+#include "gridfire/solver/solver_batched.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/composition/composition.h"
+#include "fourdst/config/config.h"
+
+#include <vector>
+#include <array>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "quill/LogMacros.h"
+
+namespace {
+    // --- Dormand-Prince 5(4) tableau ---
+    constexpr size_t NUM_STAGES = 7;
+
+    constexpr std::array<std::array<double, NUM_STAGES>, NUM_STAGES> DP_A = {{
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0/5.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {3.0/40.0, 9.0/40.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {44.0/45.0, -56.0/15.0, 32.0/9.0, 0.0, 0.0, 0.0, 0.0},
+        {19372.0/6561.0, -25360.0/2187.0, 64448.0/6561.0, -212.0/729.0, 0.0, 0.0, 0.0},
+        {9017.0/3168.0, -355.0/33.0, 46732.0/5247.0, 49.0/176.0, -5103.0/18656.0, 0.0, 0.0},
+        {35.0/384.0, 0.0, 500.0/1113.0, 125.0/192.0, -2187.0/6784.0, 11.0/84.0, 0.0}
+    }};
+
+    // The fifth order weights are the last row of A (FSAL), the error weights are b - b*.
+    constexpr std::array<double, NUM_STAGES> DP_E = {
+        71.0/57600.0, 0.0, -71.0/16695.0, 71.0/1920.0, -17253.0/339200.0, 22.0/525.0, -1.0/40.0
+    };
+
+    constexpr double SAFETY_FACTOR = 0.9;
+    constexpr double MIN_STEP_FACTOR = 0.2;
+    constexpr double MAX_STEP_FACTOR = 10.0;
+    constexpr double ERROR_EXPONENT = 1.0 / 5.0;
+}
+
+namespace gridfire::solver {
+
+    NetOut BatchedExplicitNetworkSolver::evaluate(const NetIn &netIn) {
+        return evaluate(std::vector<NetIn>{netIn}).front();
+    }
+
+    std::vector<NetOut> BatchedExplicitNetworkSolver::evaluate(const std::vector<NetIn> &netIns) {
+        using fourdst::composition::Composition;
+
+        const auto absTol = m_config.get<double>("gridfire:solver:BatchedExplicitNetworkSolver:absTol", 1.0e-8);
+        const auto relTol = m_config.get<double>("gridfire:solver:BatchedExplicitNetworkSolver:relTol", 1.0e-8);
+        const auto maxSteps = m_config.get<size_t>("gridfire:solver:BatchedExplicitNetworkSolver:maxSteps", 1000000);
+
+        const auto& networkSpecies = m_engine.getNetworkSpecies();
+        const size_t numSpecies = networkSpecies.size();
+        const size_t numZones = netIns.size();
+        const size_t stateSize = numSpecies * numZones;
+
+        if (numZones == 0) {
+            return {};
+        }
+
+        // --- Per zone conditions and controller state ---
+        std::vector<double> T9(numZones);
+        std::vector<double> rho(numZones);
+        std::vector<double> t(numZones, 0.0);
+        std::vector<double> tMax(numZones);
+        std::vector<double> h(numZones);
+        std::vector<double> hStage(numZones, 0.0); ///< Step used in the current sweep; zero for masked zones.
+        std::vector<double> energy(numZones, 0.0);
+        std::vector<double> errorNorm(numZones, 0.0);
+        std::vector<size_t> stepCount(numZones, 0);
+        std::vector<uint8_t> active(numZones, 0);
+        std::vector<uint8_t> accepted(numZones, 0);
+
+        // --- Species-major state, Y[i * numZones + z] ---
+        std::vector<double> Y(stateSize, 0.0);
+        std::vector<double> Ystage(stateSize, 0.0);
+
+        for (size_t z = 0; z < numZones; ++z) {
+            const NetIn& netIn = netIns[z];
+            T9[z] = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
+            rho[z] = netIn.density;
+            tMax[z] = netIn.tMax;
+            h[z] = netIn.dt0;
+            active[z] = netIn.tMax > 0.0 ? 1 : 0;
+
+            for (size_t i = 0; i < numSpecies; ++i) {
+                const auto& species = networkSpecies[i];
+                try {
+                    Y[i * numZones + z] = netIn.composition.getMolarAbundance(std::string(species.name()));
+                } catch (const std::runtime_error&) {
+                    LOG_DEBUG(m_logger, "Species '{}' not found in composition of zone {}. Setting abundance to 0.0.", species.name(), z);
+                    Y[i * numZones + z] = 0.0;
+                }
+            }
+        }
+
+        std::array<BatchStepDerivatives, NUM_STAGES> k;
+        m_engine.calculateRHSAndEnergyBatch(Y, T9, rho, active, k[0]);
+
+        // --- Per zone event monitors, only built if events are registered ---
+        auto gatherEndpoint = [&](const size_t z) -> EventStepEndpoint {
+            EventStepEndpoint endpoint;
+            endpoint.t = t[z];
+            endpoint.Y.resize(numSpecies);
+            endpoint.dydt.resize(numSpecies);
+            for (size_t i = 0; i < numSpecies; ++i) {
+                endpoint.Y[i] = Y[i * numZones + z];
+                endpoint.dydt[i] = k[0].dydt[i * numZones + z];
+            }
+            endpoint.energy = energy[z];
+            endpoint.nuclearEnergyGenerationRate = k[0].nuclearEnergyGenerationRate[z];
+            return endpoint;
+        };
+
+        std::vector<EventMonitor> eventMonitors;
+        std::vector<std::string> triggeredEvents(numZones);
+        if (!m_events.empty()) {
+            eventMonitors.reserve(numZones);
+            for (size_t z = 0; z < numZones; ++z) {
+                eventMonitors.emplace_back(m_events, m_engine, T9[z], rho[z]);
+                if (active[z]) {
+                    eventMonitors[z].initialize(gatherEndpoint(z));
+                }
+            }
+        }
+
+        size_t numActive = std::ranges::count(active, 1);
+        size_t sweepCount = 0;
+        while (numActive > 0) {
+            for (size_t z = 0; z < numZones; ++z) {
+                if (active[z]) {
+                    h[z] = std::min(h[z], tMax[z] - t[z]);
+                    if (h[z] <= std::numeric_limits<double>::epsilon() * std::max(t[z], 1.0)) {
+                        LOG_ERROR(m_logger, "Batched explicit solver step size underflow (h = {:0.3E}) in zone {} at t = {:0.3E} s.", h[z], z, t[z]);
+                        m_logger->flush_log();
+                        throw std::runtime_error("Batched explicit solver step size underflow in zone " + std::to_string(z) + ".");
+                    }
+                    hStage[z] = h[z];
+                } else {
+                    hStage[z] = 0.0;
+                }
+            }
+
+            // --- Stages 2 through 7; each is one sweep over all zones and one batched RHS call ---
+            for (size_t s = 1; s < NUM_STAGES; ++s) {
+                for (size_t i = 0; i < numSpecies; ++i) {
+                    const size_t offset = i * numZones;
+                    for (size_t z = 0; z < numZones; ++z) {
+                        double increment = 0.0;
+                        for (size_t j = 0; j < s; ++j) {
+                            increment += DP_A[s][j] * k[j].dydt[offset + z];
+                        }
+                        Ystage[offset + z] = Y[offset + z] + hStage[z] * increment;
+                    }
+                }
+                m_engine.calculateRHSAndEnergyBatch(Ystage, T9, rho, active, k[s]);
+            }
+            // Ystage now holds the fifth order solution (the seventh stage is evaluated at y_{n+1}).
+
+            // --- Per zone weighted RMS error ---
+            std::ranges::fill(errorNorm, 0.0);
+            for (size_t i = 0; i < numSpecies; ++i) {
+                const size_t offset = i * numZones;
+                for (size_t z = 0; z < numZones; ++z) {
+                    double error = 0.0;
+                    for (size_t j = 0; j < NUM_STAGES; ++j) {
+                        error += DP_E[j] * k[j].dydt[offset + z];
+                    }
+                    error *= hStage[z];
+                    const double scale = absTol + relTol * std::max(std::abs(Y[offset + z]), std::abs(Ystage[offset + z]));
+                    const double ratio = error / scale;
+                    errorNorm[z] += ratio * ratio;
+                }
+            }
+
+            // --- Per zone step acceptance and step size control ---
+            for (size_t z = 0; z < numZones; ++z) {
+                accepted[z] = 0;
+                if (!active[z]) {
+                    continue;
+                }
+                const double err = std::sqrt(errorNorm[z] / static_cast<double>(std::max<size_t>(numSpecies, 1)));
+                double stepFactor = MAX_STEP_FACTOR;
+                if (!std::isfinite(err)) {
+                    stepFactor = MIN_STEP_FACTOR;
+                } else if (err > 0.0) {
+                    stepFactor = std::clamp(SAFETY_FACTOR * std::pow(err, -ERROR_EXPONENT), MIN_STEP_FACTOR, MAX_STEP_FACTOR);
+                }
+
+                if (err <= 1.0) {
+                    accepted[z] = 1;
+                    double energyIncrement = 0.0;
+                    for (size_t j = 0; j < NUM_STAGES; ++j) {
+                        energyIncrement += DP_A[NUM_STAGES - 1][j] * k[j].nuclearEnergyGenerationRate[z];
+                    }
+                    energy[z] += h[z] * energyIncrement;
+                    t[z] += h[z];
+                    ++stepCount[z];
+                    if (tMax[z] - t[z] <= std::numeric_limits<double>::epsilon() * tMax[z]) {
+                        active[z] = 0;
+                    } else if (stepCount[z] >= maxSteps) {
+                        LOG_ERROR(m_logger, "Batched explicit solver exceeded the maximum number of steps ({}) in zone {} at t = {:0.3E} s.", maxSteps, z, t[z]);
+                        m_logger->flush_log();
+                        throw std::runtime_error("Batched explicit solver exceeded the maximum number of steps in zone " + std::to_string(z) + ".");
+                    }
+                } else {
+                    stepFactor = std::min(stepFactor, 1.0);
+                }
+                h[z] *= stepFactor;
+            }
+
+            // --- Commit accepted zones; the last stage derivative becomes the first of the next step (FSAL) ---
+            for (size_t i = 0; i < numSpecies; ++i) {
+                const size_t offset = i * numZones;
+                for (size_t z = 0; z < numZones; ++z) {
+                    if (accepted[z]) {
+                        Y[offset + z] = Ystage[offset + z];
+                        k[0].dydt[offset + z] = k[NUM_STAGES - 1].dydt[offset + z];
+                    }
+                }
+            }
+            for (size_t z = 0; z < numZones; ++z) {
+                if (accepted[z]) {
+                    k[0].nuclearEnergyGenerationRate[z] = k[NUM_STAGES - 1].nuclearEnergyGenerationRate[z];
+                }
+            }
+
+            // --- Event checks; a zone whose event fired is rewound to the event and retired ---
+            for (size_t z = 0; z < eventMonitors.size(); ++z) {
+                if (!accepted[z]) {
+                    continue;
+                }
+                const std::optional<EventLocation> event = eventMonitors[z].checkStep(gatherEndpoint(z));
+                if (!event.has_value()) {
+                    continue;
+                }
+                LOG_INFO(m_logger, "Event '{}' triggered in zone {} at t = {:0.3E} s.", event->name, z, event->t);
+                active[z] = 0;
+                t[z] = event->t;
+                energy[z] = event->energy;
+                for (size_t i = 0; i < numSpecies; ++i) {
+                    Y[i * numZones + z] = event->Y[i];
+                }
+                triggeredEvents[z] = event->name;
+            }
+
+            numActive = std::ranges::count(active, 1);
+            ++sweepCount;
+            LOG_TRACE_L2(m_logger, "Batched explicit sweep {} complete, {} of {} zones still active.", sweepCount, numActive, numZones);
+        }
+
+        // --- Marshal the per zone results ---
+        std::vector<std::string> speciesNames;
+        speciesNames.reserve(numSpecies);
+        for (const auto& species : networkSpecies) {
+            speciesNames.push_back(std::string(species.name()));
+        }
+
+        std::vector<NetOut> netOuts;
+        netOuts.reserve(numZones);
+        std::vector<double> finalMassFractions(numSpecies);
+        for (size_t z = 0; z < numZones; ++z) {
+            for (size_t i = 0; i < numSpecies; ++i) {
+                const double molarMass = networkSpecies[i].mass();
+                finalMassFractions[i] = Y[i * numZones + z] * molarMass; // Convert from molar abundance to mass fraction
+                if (finalMassFractions[i] < MIN_ABUNDANCE_THRESHOLD) {
+                    finalMassFractions[i] = 0.0;
+                }
+            }
+
+            Composition outputComposition(speciesNames);
+            outputComposition.setMassFraction(speciesNames, finalMassFractions);
+            outputComposition.finalize(true);
+
+            NetOut netOut;
+            netOut.composition = std::move(outputComposition);
+            netOut.energy = energy[z]; // Specific energy rate
+            netOut.num_steps = static_cast<int>(stepCount[z]);
+            netOut.time = triggeredEvents[z].empty() ? tMax[z] : t[z];
+            netOut.triggeredEvent = triggeredEvents[z];
+            netOuts.push_back(std::move(netOut));
+        }
+
+        return netOuts;
+    }
+}
@@ -0,0 +1,302 @@
+#include "gridfire/solver/solver_dispatch.h"
+#include "gridfire/solver/rosenbrock_controller.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/composition/composition.h"
+#include "fourdst/config/config.h"
+
+#include <boost/numeric/odeint.hpp>
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <memory>
+
+#include "quill/LogMacros.h"
+
+namespace {
+    constexpr size_t MAX_FAILED_STEP_ATTEMPTS = 500; ///< Matches odeint's default failed step checker.
+    constexpr double STABILITY_BOUND_FRACTION = 0.9; ///< Fraction of the stability limit at which explicit steps count as stability bound.
+    constexpr double POWER_ITERATION_TOLERANCE = 0.05; ///< Relative change in the estimate at which power iteration stops.
+
+    double euclideanNorm(const std::vector<double>& v) {
+        double sum = 0.0;
+        for (const double x : v) {
+            sum += x * x;
+        }
+        return std::sqrt(sum);
+    }
+}
+
+namespace gridfire::solver {
+
+    NetOut StiffnessDispatchNetworkSolver::evaluate(const NetIn &netIn) {
+        SolverState state;
+        return evaluate(netIn, state);
+    }
+
+    NetOut StiffnessDispatchNetworkSolver::evaluate(const NetIn &netIn, SolverState &state) {
+        namespace ublas = boost::numeric::ublas;
+        namespace odeint = boost::numeric::odeint;
+        using state_type = ublas::vector<double>;
+        using fourdst::composition::Composition;
+
+        const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
+        const double rho = netIn.density; // Density in g/cm^3
+        const size_t numSpecies = m_engine.getNetworkSpecies().size();
+
+        const auto absTol = m_config.get<double>("gridfire:solver:StiffnessDispatchNetworkSolver:absTol", 1.0e-8);
+        const auto relTol = m_config.get<double>("gridfire:solver:StiffnessDispatchNetworkSolver:relTol", 1.0e-8);
+        const auto stabilityLimit = m_config.get<double>("gridfire:solver:StiffnessDispatchNetworkSolver:stabilityLimit", 3.3);
+        const auto maxExplicitStabilitySteps = m_config.get<double>("gridfire:solver:StiffnessDispatchNetworkSolver:maxExplicitStabilitySteps", 50.0);
+        const auto checkInterval = m_config.get<size_t>("gridfire:solver:StiffnessDispatchNetworkSolver:checkInterval", 25);
+        const auto hysteresis = m_config.get<double>("gridfire:solver:StiffnessDispatchNetworkSolver:hysteresis", 2.0);
+        const auto powerIterations = m_config.get<int>("gridfire:solver:StiffnessDispatchNetworkSolver:powerIterations", 8);
+
+        if (!state.isCompatibleWith(m_engine)) {
+            LOG_DEBUG(m_logger, "Solver state does not match the current network, resetting it.");
+            state.bind(m_engine);
+        }
+
+        state_type Y(numSpecies + 1);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const auto& species = m_engine.getNetworkSpecies()[i];
+            try {
+                Y(i) = netIn.composition.getMolarAbundance(std::string(species.name()));
+            } catch (const std::runtime_error&) {
+                LOG_DEBUG(m_logger, "Species '{}' not found in composition. Setting abundance to 0.0.", species.name());
+                Y(i) = 0.0;
+            }
+        }
+        Y(numSpecies) = 0.0;
+
+        const RHSFunctor rhsFunctor(m_engine, T9, rho);
+        const JacobianFunctor jacobianFunctor(m_engine, T9, rho);
+
+        auto explicitStepper = odeint::make_controlled<odeint::runge_kutta_dopri5<state_type>>(absTol, relTol);
+        if (!state.rosenbrockController) {
+            state.rosenbrockController = std::make_unique<RosenbrockController>(absTol, relTol);
+        }
+
+        auto spectralRadiusAt = [&](const state_type& state_Y) -> double {
+            const std::vector<double> y(state_Y.begin(), state_Y.begin() + numSpecies);
+            const auto [dydt, eps] = m_engine.calculateRHSAndEnergy(y, T9, rho);
+            return estimateSpectralRadius(y, dydt, T9, rho, state.dominantEigenvector, powerIterations);
+        };
+
+        // Decides the integration mode given the spectral radius, the current step size and the remaining interval.
+        auto shouldBeStiff = [&](const bool currentlyStiff, const double radius, const double h, const double remaining) -> bool {
+            const double stabilitySteps = radius * remaining / stabilityLimit;
+            if (currentlyStiff) {
+                const bool explicitWouldBeStable = radius * h * hysteresis < stabilityLimit;
+                const bool fewStabilitySteps = stabilitySteps * hysteresis < maxExplicitStabilitySteps;
+                return !(explicitWouldBeStable || fewStabilitySteps);
+            }
+            const bool stabilityBound = radius * h >= STABILITY_BOUND_FRACTION * stabilityLimit;
+            return stabilityBound && stabilitySteps > maxExplicitStabilitySteps;
+        };
+
+        double t = 0.0;
+        double dt = state.lastStepSize > 0.0 ? state.lastStepSize : netIn.dt0;
+
+        double spectralRadius = spectralRadiusAt(Y);
+        bool stiff = state.stiff.has_value() ?
+            shouldBeStiff(*state.stiff, spectralRadius, dt, netIn.tMax) :
+            spectralRadius * netIn.tMax / stabilityLimit > maxExplicitStabilitySteps;
+        LOG_DEBUG(m_logger, "Estimated spectral radius {:0.3E} s^-1, starting with the {} integrator.", spectralRadius, stiff ? "implicit" : "explicit");
+
+        EventMonitor eventMonitor(m_events, m_engine, T9, rho);
+        std::optional<EventLocation> event;
+        auto makeEventEndpoint = [&](const double time, const state_type& x) -> EventStepEndpoint {
+            return eventMonitor.makeEndpoint(time, std::vector<double>(x.begin(), x.begin() + numSpecies), x(numSpecies));
+        };
+        if (!eventMonitor.empty()) {
+            eventMonitor.initialize(makeEventEndpoint(t, Y));
+        }
+
+        size_t stepCount = 0;
+        size_t stepsSinceCheck = 0;
+        size_t failedAttempts = 0;
+        size_t modeSwitches = 0;
+        while (netIn.tMax - t > std::numeric_limits<double>::epsilon() * std::abs(netIn.tMax)) {
+            double dtTry = std::min(dt, netIn.tMax - t);
+            const bool clamped = dtTry < dt;
+
+            const odeint::controlled_step_result result = stiff ?
+                state.rosenbrockController->try_step(std::make_pair(rhsFunctor, jacobianFunctor), Y, t, dtTry) :
+                explicitStepper.try_step(rhsFunctor, Y, t, dtTry);
+
+            if (result == odeint::success) {
+                ++stepCount;
+                ++stepsSinceCheck;
+                failedAttempts = 0;
+                dt = clamped ? std::max(dtTry, dt) : dtTry;
+                if (!eventMonitor.empty()) {
+                    event = eventMonitor.checkStep(makeEventEndpoint(t, Y));
+                    if (event.has_value()) {
+                        break;
+                    }
+                }
+            } else {
+                if (++failedAttempts >= MAX_FAILED_STEP_ATTEMPTS) {
+                    LOG_ERROR(m_logger, "Step size adjustment failed {} times in a row at t = {:0.3E} s (dt = {:0.3E} s).", failedAttempts, t, dtTry);
+                    m_logger->flush_log();
+                    throw std::runtime_error("Step size adjustment failed after " + std::to_string(failedAttempts) + " attempts.");
+                }
+                dt = dtTry;
+            }
+
+            if (stepsSinceCheck >= checkInterval) {
+                stepsSinceCheck = 0;
+                spectralRadius = spectralRadiusAt(Y);
+                const bool newStiff = shouldBeStiff(stiff, spectralRadius, dt, netIn.tMax - t);
+                if (newStiff != stiff) {
+                    LOG_DEBUG(m_logger, "Switching to the {} integrator at t = {:0.3E} s (spectral radius {:0.3E} s^-1, dt = {:0.3E} s).",
+                        newStiff ? "implicit" : "explicit", t, spectralRadius, dt);
+                    stiff = newStiff;
+                    ++modeSwitches;
+                    // The FSAL derivative cached by the explicit stepper is stale once the implicit stepper has moved Y
+                    explicitStepper.reset();
+                }
+            }
+        }
+        LOG_DEBUG(m_logger, "Stiffness dispatch completed in {} steps with {} integrator switches.", stepCount, modeSwitches);
+
+        state.lastStepSize = dt;
+        state.stiff = stiff;
+        state.T9 = T9;
+        state.rho = rho;
+
+        if (event.has_value()) {
+            LOG_INFO(m_logger, "Event '{}' triggered at t = {:0.3E} s.", event->name, event->t);
+            std::ranges::copy(event->Y, Y.begin());
+            Y(numSpecies) = event->energy;
+        }
+
+        std::vector<double> finalMassFractions(numSpecies);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const double molarMass = m_engine.getNetworkSpecies()[i].mass();
+            finalMassFractions[i] = Y(i) * molarMass; // Convert from molar abundance to mass fraction
+            if (finalMassFractions[i] < MIN_ABUNDANCE_THRESHOLD) {
+                finalMassFractions[i] = 0.0;
+            }
+        }
+
+        std::vector<std::string> speciesNames;
+        speciesNames.reserve(numSpecies);
+        for (const auto& species : m_engine.getNetworkSpecies()) {
+            speciesNames.push_back(std::string(species.name()));
+        }
+
+        Composition outputComposition(speciesNames);
+        outputComposition.setMassFraction(speciesNames, finalMassFractions);
+        outputComposition.finalize(true);
+
+        NetOut netOut;
+        netOut.composition = std::move(outputComposition);
+        netOut.energy = Y(numSpecies); // Specific energy rate
+        netOut.num_steps = stepCount;
+        netOut.time = event.has_value() ? event->t : netIn.tMax;
+        netOut.triggeredEvent = event.has_value() ? event->name : "";
+
+        return netOut;
+    }
+
+    double StiffnessDispatchNetworkSolver::estimateSpectralRadius(
+        const std::vector<double> &Y,
+        const std::vector<double> &dydt,
+        const double T9,
+        const double rho,
+        std::vector<double> &v,
+        const int maxIterations
+    ) const {
+        const size_t n = Y.size();
+        if (n == 0) {
+            return 0.0;
+        }
+
+        if (v.size() != n || euclideanNorm(v) == 0.0 || !std::isfinite(euclideanNorm(v))) {
+            v.assign(n, 1.0);
+        }
+        const double vNorm = euclideanNorm(v);
+        for (double& x : v) {
+            x /= vNorm;
+        }
+
+        const double epsilon = std::sqrt(std::numeric_limits<double>::epsilon()) * std::max(euclideanNorm(Y), 1.0);
+
+        std::vector<double> Yperturbed(n);
+        std::vector<double> Jv(n);
+        double estimate = 0.0;
+        for (int iteration = 0; iteration < maxIterations; ++iteration) {
+            for (size_t i = 0; i < n; ++i) {
+                Yperturbed[i] = Y[i] + epsilon * v[i];
+            }
+            const auto [perturbedDydt, eps] = m_engine.calculateRHSAndEnergy(Yperturbed, T9, rho);
+            for (size_t i = 0; i < n; ++i) {
+                Jv[i] = (perturbedDydt[i] - dydt[i]) / epsilon;
+            }
+
+            const double norm = euclideanNorm(Jv);
+            if (!std::isfinite(norm)) {
+                LOG_WARNING(m_logger, "Non-finite Jacobian-vector product during spectral radius estimation; keeping estimate {:0.3E}.", estimate);
+                break;
+            }
+            if (norm == 0.0) {
+                estimate = 0.0;
+                break;
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                v[i] = Jv[i] / norm;
+            }
+            const bool converged = iteration > 0 && std::abs(norm - estimate) <= POWER_ITERATION_TOLERANCE * norm;
+            estimate = norm;
+            if (converged) {
+                break;
+            }
+        }
+        LOG_TRACE_L2(m_logger, "Estimated spectral radius: {:0.3E} s^-1.", estimate);
+        return estimate;
+    }
+
+    void StiffnessDispatchNetworkSolver::RHSFunctor::operator()(
+        const boost::numeric::ublas::vector<double> &Y,
+        boost::numeric::ublas::vector<double> &dYdt,
+        double
+    ) const {
+        const std::vector<double> y(Y.begin(), m_numSpecies + Y.begin());
+        auto [dydt, eps] = m_engine.calculateRHSAndEnergy(y, m_T9, m_rho);
+        dYdt.resize(m_numSpecies + 1);
+        std::ranges::copy(dydt, dYdt.begin());
+        dYdt(m_numSpecies) = eps;
+    }
+
+    void StiffnessDispatchNetworkSolver::JacobianFunctor::operator()(
+        const boost::numeric::ublas::vector<double> &Y,
+        boost::numeric::ublas::matrix<double> &J,
+        double,
+        boost::numeric::ublas::vector<double> &dfdt
+    ) const {
+        const std::vector<double> y(Y.begin(), m_numSpecies + Y.begin());
+        m_engine.generateJacobianMatrix(y, m_T9, m_rho);
+
+        J.resize(m_numSpecies + 1, m_numSpecies + 1);
+        J.clear();
+        for (size_t i = 0; i < m_numSpecies; ++i) {
+            for (size_t j = 0; j < m_numSpecies; ++j) {
+                J(i, j) = m_engine.getJacobianMatrixEntry(static_cast<int>(i), static_cast<int>(j));
+            }
+        }
+
+        // The network is autonomous at fixed temperature and density
+        dfdt.resize(m_numSpecies + 1);
+        dfdt.clear();
+    }
+}
@@ -0,0 +1,214 @@
+#include "gridfire/solver/solver_events.h"
+#include "gridfire/engine/engine_abstract.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+
+#include <vector>
+#include <string>
+#include <optional>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+    constexpr int MAX_LOCALIZATION_ITERATIONS = 60;
+    constexpr double RELATIVE_TIME_TOLERANCE = 1.0e-10; ///< Event times are located to this fraction of the step.
+
+    struct HermiteBasis {
+        double h00, h10, h01, h11;
+    };
+
+    HermiteBasis hermiteBasis(const double theta) {
+        const double theta2 = theta * theta;
+        const double theta3 = theta2 * theta;
+        return {
+            2.0 * theta3 - 3.0 * theta2 + 1.0,
+            theta3 - 2.0 * theta2 + theta,
+            -2.0 * theta3 + 3.0 * theta2,
+            theta3 - theta2
+        };
+    }
+}
+
+namespace gridfire::solver {
+
+    namespace events {
+        SolverEvent massFractionBelow(const std::string &speciesName, const double threshold) {
+            return {
+                "massFractionBelow(" + speciesName + ")",
+                [speciesName, threshold](const EventContext& context) -> double {
+                    for (size_t i = 0; i < context.species.size(); ++i) {
+                        if (context.species[i].name() == speciesName) {
+                            return threshold - context.Y[i] * context.species[i].mass();
+                        }
+                    }
+                    return -1.0; // Species not in the network, never fires
+                }
+            };
+        }
+
+        SolverEvent energyGenerationAbove(const double threshold) {
+            return {
+                "energyGenerationAbove",
+                [threshold](const EventContext& context) -> double {
+                    return context.nuclearEnergyGenerationRate - threshold;
+                }
+            };
+        }
+
+        SolverEvent abundanceChangeExceeds(const double relativeChange, const double abundanceFloor) {
+            return {
+                "abundanceChangeExceeds",
+                [relativeChange, abundanceFloor](const EventContext& context) -> double {
+                    double maxChange = 0.0;
+                    for (size_t i = 0; i < context.Y.size(); ++i) {
+                        if (context.Y0[i] < abundanceFloor) {
+                            continue;
+                        }
+                        maxChange = std::max(maxChange, std::abs(context.Y[i] - context.Y0[i]) / context.Y0[i]);
+                    }
+                    return maxChange - relativeChange;
+                }
+            };
+        }
+    }
+
+    EventMonitor::EventMonitor(
+        const std::vector<SolverEvent> &events,
+        const Engine &engine,
+        const double T9,
+        const double rho
+    ) :
+    m_events(events),
+    m_engine(engine),
+    m_T9(T9),
+    m_rho(rho) {}
+
+    void EventMonitor::initialize(const EventStepEndpoint &start) {
+        initialize(start, start.Y);
+    }
+
+    void EventMonitor::initialize(const EventStepEndpoint &start, std::vector<double> Y0) {
+        m_Y0 = std::move(Y0);
+        m_previous = start;
+        m_previousValues.resize(m_events.size());
+        for (size_t e = 0; e < m_events.size(); ++e) {
+            m_previousValues[e] = evaluateCondition(e, start.t, start.Y, start.nuclearEnergyGenerationRate);
+        }
+    }
+
+    std::optional<EventLocation> EventMonitor::checkStep(const EventStepEndpoint &end) {
+        std::vector<double> endValues(m_events.size());
+        for (size_t e = 0; e < m_events.size(); ++e) {
+            endValues[e] = evaluateCondition(e, end.t, end.Y, end.nuclearEnergyGenerationRate);
+        }
+
+        std::optional<EventLocation> earliest;
+        std::vector<double> Y;
+        double energy = 0.0;
+        const double timeTolerance = std::max(
+            RELATIVE_TIME_TOLERANCE * (end.t - m_previous.t),
+            4.0 * std::numeric_limits<double>::epsilon() * std::abs(end.t)
+        );
+
+        for (size_t e = 0; e < m_events.size(); ++e) {
+            if (!(m_previousValues[e] < 0.0 && endValues[e] >= 0.0)) {
+                continue;
+            }
+
+            // --- Illinois regula falsi on [a, b] with g(a) < 0 <= g(b) ---
+            double a = m_previous.t;
+            double b = earliest.has_value() ? earliest->t : end.t; // An event after the earliest one found is irrelevant
+            double ga = m_previousValues[e];
+            double gb = endValues[e];
+            if (earliest.has_value()) {
+                interpolate(end, b, Y, energy);
+                const auto rhs = m_engine.calculateRHSAndEnergy(Y, m_T9, m_rho);
+                gb = evaluateCondition(e, b, Y, rhs.nuclearEnergyGenerationRate);
+                if (gb < 0.0) {
+                    continue; // This event crosses after the earliest event found so far
+                }
+            }
+
+            int side = 0;
+            for (int iteration = 0; iteration < MAX_LOCALIZATION_ITERATIONS && b - a > timeTolerance; ++iteration) {
+                double c = (a * gb - b * ga) / (gb - ga);
+                if (!(c > a && c < b)) {
+                    c = 0.5 * (a + b);
+                }
+                interpolate(end, c, Y, energy);
+                const auto rhs = m_engine.calculateRHSAndEnergy(Y, m_T9, m_rho);
+                const double gc = evaluateCondition(e, c, Y, rhs.nuclearEnergyGenerationRate);
+                if (gc >= 0.0) {
+                    b = c;
+                    gb = gc;
+                    if (side == 1) {
+                        ga *= 0.5;
+                    }
+                    side = 1;
+                } else {
+                    a = c;
+                    ga = gc;
+                    if (side == -1) {
+                        gb *= 0.5;
+                    }
+                    side = -1;
+                }
+            }
+
+            // Report the right end of the bracket, where the event condition is satisfied
+            interpolate(end, b, Y, energy);
+            earliest = EventLocation{e, m_events[e].name, b, Y, energy};
+        }
+
+        if (!earliest.has_value()) {
+            m_previous = end;
+            m_previousValues = std::move(endValues);
+        }
+        return earliest;
+    }
+
+    EventStepEndpoint EventMonitor::makeEndpoint(
+        const double t,
+        std::vector<double> Y,
+        const double energy
+    ) const {
+        EventStepEndpoint endpoint;
+        auto [dydt, nuclearEnergyGenerationRate] = m_engine.calculateRHSAndEnergy(Y, m_T9, m_rho);
+        endpoint.t = t;
+        endpoint.Y = std::move(Y);
+        endpoint.dydt = std::move(dydt);
+        endpoint.energy = energy;
+        endpoint.nuclearEnergyGenerationRate = nuclearEnergyGenerationRate;
+        return endpoint;
+    }
+
+    double EventMonitor::evaluateCondition(
+        const size_t eventIndex,
+        const double t,
+        const std::vector<double> &Y,
+        const double nuclearEnergyGenerationRate
+    ) const {
+        const EventContext context{t, Y, m_Y0, nuclearEnergyGenerationRate, m_engine.getNetworkSpecies()};
+        return m_events[eventIndex].condition(context);
+    }
+
+    void EventMonitor::interpolate(
+        const EventStepEndpoint &end,
+        const double t,
+        std::vector<double> &Y,
+        double &energy
+    ) const {
+        const double h = end.t - m_previous.t;
+        const double theta = h > 0.0 ? (t - m_previous.t) / h : 1.0;
+        const auto [h00, h10, h01, h11] = hermiteBasis(theta);
+
+        Y.resize(end.Y.size());
+        for (size_t i = 0; i < end.Y.size(); ++i) {
+            Y[i] = h00 * m_previous.Y[i] + h10 * h * m_previous.dydt[i] + h01 * end.Y[i] + h11 * h * end.dydt[i];
+        }
+        energy = h00 * m_previous.energy + h10 * h * m_previous.nuclearEnergyGenerationRate +
+                 h01 * end.energy + h11 * h * end.nuclearEnergyGenerationRate;
+    }
+}
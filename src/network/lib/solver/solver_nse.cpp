@@ -0,0 +1,278 @@
+#include "gridfire/solver/solver_nse.h"
+#include "gridfire/network.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+#include "fourdst/composition/composition.h"
+#include "fourdst/config/config.h"
+
+#include "Eigen/Dense"
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "quill/LogMacros.h"
+
+namespace {
+    constexpr double PROTON_ATOMIC_MASS = 1.00782503223; ///< Atomic mass of H-1 in u; the electron masses cancel in the binding energies.
+    constexpr double NEUTRON_MASS = 1.00866491595; ///< Neutron mass in u.
+    constexpr double MEV_PER_U = 931.49410242; ///< Energy equivalent of the atomic mass unit in MeV.
+    constexpr double K_MEV_PER_T9 = 0.0861733326; ///< Boltzmann constant in MeV per 10^9 K.
+    constexpr double ERG_PER_MEV = 1.602176634e-6; ///< MeV to erg.
+    constexpr double AVOGADRO = 6.02214076e23; ///< Avogadro's number in mol^-1.
+    constexpr double QUANTUM_CONCENTRATION_T9 = 5.9429e33; ///< (m_u k T / 2πħ²)^{3/2} at T9 = 1, in cm^-3.
+    constexpr double LN2 = 0.69314718056;
+
+    constexpr double MAX_LOG_STEP = 5.0; ///< Largest change of ln Y_p or ln Y_n in a single Newton step.
+    constexpr int MAX_LINE_SEARCH_HALVINGS = 30;
+
+    /**
+     * @brief The mass and charge constraints and their log-space Jacobian at given nucleon abundances.
+     */
+    struct NSEConstraints {
+        Eigen::Vector2d residual; ///< (ln Σ A Y, ln(Σ Z Y / Ye)).
+        Eigen::Matrix2d jacobian; ///< Derivatives of the residuals with respect to (ln Y_p, ln Y_n).
+    };
+
+    NSEConstraints evaluateConstraints(
+        const std::vector<double>& lnYOffset,
+        const std::vector<int>& Z,
+        const std::vector<int>& N,
+        const Eigen::Vector2d& x,
+        const double Ye
+    ) {
+        const size_t n = lnYOffset.size();
+        double shift = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < n; ++i) {
+            shift = std::max(shift, lnYOffset[i] + Z[i] * x(0) + N[i] * x(1));
+        }
+
+        // All sums are scaled by exp(-shift); the scale cancels in the ratios and is added back in the logarithms
+        double sumA = 0.0, sumZ = 0.0;
+        double sumAZ = 0.0, sumAN = 0.0, sumZZ = 0.0, sumZN = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            const double w = std::exp(lnYOffset[i] + Z[i] * x(0) + N[i] * x(1) - shift);
+            const double A = Z[i] + N[i];
+            sumA += A * w;
+            sumZ += Z[i] * w;
+            sumAZ += A * Z[i] * w;
+            sumAN += A * N[i] * w;
+            sumZZ += Z[i] * Z[i] * w;
+            sumZN += Z[i] * N[i] * w;
+        }
+
+        NSEConstraints constraints;
+        constraints.residual << shift + std::log(sumA), shift + std::log(sumZ / Ye);
+        constraints.jacobian << sumAZ / sumA, sumAN / sumA,
+                                sumZZ / sumZ, sumZN / sumZ;
+        return constraints;
+    }
+}
+
+namespace gridfire::solver {
+
+    NetOut NSENetworkSolver::evaluate(const NetIn &netIn) {
+        SolverState state;
+        return evaluate(netIn, state);
+    }
+
+    NetOut NSENetworkSolver::evaluate(const NetIn &netIn, SolverState &state) {
+        using fourdst::composition::Composition;
+
+        const auto maxIterations = m_config.get<int>("gridfire:solver:NSENetworkSolver:maxIterations", 100);
+        const auto tolerance = m_config.get<double>("gridfire:solver:NSENetworkSolver:tolerance", 1.0e-10);
+
+        if (!state.isCompatibleWith(m_engine)) {
+            LOG_DEBUG(m_logger, "Solver state does not match the current network, resetting it.");
+            state.bind(m_engine);
+        }
+
+        const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
+        const double rho = netIn.density; // Density in g/cm^3
+        const auto& networkSpecies = m_engine.getNetworkSpecies();
+        const size_t numSpecies = networkSpecies.size();
+
+        // --- Initial abundances and electron fraction ---
+        std::vector<double> Y0(numSpecies, 0.0);
+        double Ye = 0.0;
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const auto& species = networkSpecies[i];
+            if (netIn.composition.contains(species)) {
+                Y0[i] = netIn.composition.getMolarAbundance(std::string(species.name()));
+            }
+            Ye += species.z() * Y0[i];
+        }
+        if (!(Ye > 0.0)) {
+            LOG_ERROR(m_logger, "Cannot compute NSE for a composition with electron fraction {:0.3E}.", Ye);
+            m_logger->flush_log();
+            throw std::runtime_error("Cannot compute NSE for a composition without charged species.");
+        }
+
+        // --- Everything in ln Y_i except Z ln Y_p + N ln Y_n ---
+        std::vector<double> lnYOffset(numSpecies);
+        std::vector<double> bindingEnergies(numSpecies);
+        std::vector<int> Z(numSpecies), N(numSpecies);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const auto& species = networkSpecies[i];
+            const int A = species.a();
+            Z[i] = species.z();
+            N[i] = A - species.z();
+            bindingEnergies[i] = bindingEnergy(species);
+            const double G = m_partitionFunction ? m_partitionFunction(species, T9) : groundStatePartitionFunction(species, T9);
+            lnYOffset[i] = sahaLogOffset(species, T9, rho, G);
+        }
+
+        // --- Initial guess: warm start, or ln Y_p = ln Y_n such that the most favoured nucleus holds all the mass ---
+        Eigen::Vector2d x;
+        if (state.NSELogNucleonAbundances.has_value()) {
+            x << state.NSELogNucleonAbundances->first, state.NSELogNucleonAbundances->second;
+        } else {
+            double guess = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < numSpecies; ++i) {
+                const int A = Z[i] + N[i];
+                guess = std::min(guess, -(lnYOffset[i] + std::log(static_cast<double>(A))) / A);
+            }
+            x << guess, guess;
+        }
+
+        NSEConstraints constraints = evaluateConstraints(lnYOffset, Z, N, x, Ye);
+        int iteration = 0;
+        for (; iteration < maxIterations; ++iteration) {
+            const double residualNorm = constraints.residual.cwiseAbs().maxCoeff();
+            LOG_TRACE_L2(m_logger, "NSE Newton iteration {}: ln Yp = {:0.6E}, ln Yn = {:0.6E}, residual = {:0.3E}.", iteration, x(0), x(1), residualNorm);
+            if (residualNorm < tolerance) {
+                break;
+            }
+
+            Eigen::Vector2d step = -constraints.jacobian.fullPivLu().solve(constraints.residual);
+            if (!step.allFinite()) {
+                LOG_ERROR(m_logger, "NSE Newton iteration produced a non-finite step at T9 = {:0.3f}, rho = {:0.3E}.", T9, rho);
+                m_logger->flush_log();
+                throw std::runtime_error("NSE Newton iteration failed: singular constraint Jacobian.");
+            }
+            const double stepNorm = step.cwiseAbs().maxCoeff();
+            if (stepNorm > MAX_LOG_STEP) {
+                step *= MAX_LOG_STEP / stepNorm;
+            }
+
+            // --- Halve the step until the residual decreases ---
+            double lambda = 1.0;
+            NSEConstraints trial = evaluateConstraints(lnYOffset, Z, N, x + step, Ye);
+            for (int halving = 0; halving < MAX_LINE_SEARCH_HALVINGS &&
+                 !(trial.residual.allFinite() && trial.residual.squaredNorm() < constraints.residual.squaredNorm()); ++halving) {
+                lambda *= 0.5;
+                trial = evaluateConstraints(lnYOffset, Z, N, x + lambda * step, Ye);
+            }
+            x += lambda * step;
+            constraints = trial;
+        }
+
+        if (constraints.residual.cwiseAbs().maxCoeff() >= tolerance) {
+            LOG_ERROR(m_logger, "NSE Newton iteration did not converge in {} iterations at T9 = {:0.3f}, rho = {:0.3E} (residual {:0.3E}).",
+                maxIterations, T9, rho, constraints.residual.cwiseAbs().maxCoeff());
+            m_logger->flush_log();
+            throw std::runtime_error("NSE Newton iteration did not converge in " + std::to_string(maxIterations) + " iterations.");
+        }
+        LOG_DEBUG(m_logger, "NSE converged in {} iterations at T9 = {:0.3f}, rho = {:0.3E}, Ye = {:0.4f}.", iteration, T9, rho, Ye);
+
+        state.NSELogNucleonAbundances = std::make_pair(x(0), x(1));
+        state.T9 = T9;
+        state.rho = rho;
+
+        // --- Marshal output variables ---
+        std::vector<std::string> speciesNames(numSpecies);
+        std::vector<double> finalMassFractions(numSpecies);
+        double massFractionSum = 0.0;
+        double energy = 0.0;
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const auto& species = networkSpecies[i];
+            const double Y = std::exp(lnYOffset[i] + Z[i] * x(0) + N[i] * x(1));
+            speciesNames[i] = species.name();
+            finalMassFractions[i] = Y * species.mass(); // Convert from molar abundance to mass fraction
+            massFractionSum += finalMassFractions[i];
+            energy += (Y - Y0[i]) * bindingEnergies[i];
+        }
+        for (auto& mf : finalMassFractions) {
+            mf /= massFractionSum; // Normalize to get mass fractions
+        }
+
+        Composition outputComposition(speciesNames, finalMassFractions);
+        NetOut netOut;
+        netOut.composition = outputComposition;
+        netOut.energy = energy * ERG_PER_MEV * AVOGADRO; // Specific energy released (erg/g)
+        netOut.num_steps = iteration;
+        netOut.time = netIn.tMax;
+        return netOut;
+    }
+
+    void NSENetworkSolver::setPartitionFunction(PartitionFunction partitionFunction) {
+        m_partitionFunction = std::move(partitionFunction);
+    }
+
+    double NSENetworkSolver::equilibrationTimescale(const double T9, const double rho) {
+        return std::pow(rho, 0.2) * std::exp(179.7 / T9 - 40.5);
+    }
+
+    double NSENetworkSolver::bindingEnergy(const fourdst::atomic::Species &species) {
+        const int Z = species.z();
+        const int N = species.a() - species.z();
+        return (Z * PROTON_ATOMIC_MASS + N * NEUTRON_MASS - species.mass()) * MEV_PER_U;
+    }
+
+    double NSENetworkSolver::groundStatePartitionFunction(const fourdst::atomic::Species &species, double) {
+        return species.a() == 1 ? 2.0 : 1.0;
+    }
+
+    double NSENetworkSolver::sahaLogOffset(
+        const fourdst::atomic::Species &species,
+        const double T9,
+        const double rho,
+        const double G
+    ) {
+        const int A = species.a();
+        const double lnDensityRatio = std::log(rho * AVOGADRO / (QUANTUM_CONCENTRATION_T9 * std::pow(T9, 1.5)));
+        return std::log(G) + 1.5 * std::log(static_cast<double>(A)) - A * LN2 +
+               (A - 1) * lnDensityRatio + bindingEnergy(species) / (K_MEV_PER_T9 * T9);
+    }
+
+    NSEDispatchNetworkSolver::NSEDispatchNetworkSolver(
+        DynamicEngine &engine,
+        DynamicNetworkSolverStrategy &fallbackSolver
+    ) :
+    DynamicNetworkSolverStrategy(engine),
+    m_nseSolver(engine),
+    m_fallbackSolver(fallbackSolver) {}
+
+    NetOut NSEDispatchNetworkSolver::evaluate(const NetIn &netIn) {
+        SolverState state;
+        return evaluate(netIn, state);
+    }
+
+    NetOut NSEDispatchNetworkSolver::evaluate(const NetIn &netIn, SolverState &state) {
+        const auto enterT9 = m_config.get<double>("gridfire:solver:NSEDispatchNetworkSolver:enterT9", 5.0);
+        const auto exitT9 = m_config.get<double>("gridfire:solver:NSEDispatchNetworkSolver:exitT9", 4.5);
+        const auto equilibrationFraction = m_config.get<double>("gridfire:solver:NSEDispatchNetworkSolver:equilibrationFraction", 0.1);
+        const auto exitTimescaleFactor = m_config.get<double>("gridfire:solver:NSEDispatchNetworkSolver:exitTimescaleFactor", 10.0);
+
+        const double T9 = netIn.temperature / 1e9; // Convert temperature from Kelvin to T9 (T9 = T / 1e9)
+        const double tau = NSENetworkSolver::equilibrationTimescale(T9, netIn.density);
+
+        const bool wasInNSE = state.inNSE.value_or(false);
+        const bool inNSE = wasInNSE ?
+            T9 >= exitT9 && tau <= exitTimescaleFactor * netIn.tMax :
+            T9 >= enterT9 && tau <= equilibrationFraction * netIn.tMax;
+
+        if (inNSE != wasInNSE) {
+            LOG_DEBUG(m_logger, "Zone {} NSE at T9 = {:0.3f} (relaxation timescale {:0.3E} s, timestep {:0.3E} s).",
+                inNSE ? "entering" : "leaving", T9, tau, netIn.tMax);
+        }
+
+        NetOut netOut = inNSE ? m_nseSolver.evaluate(netIn, state) : m_fallbackSolver.evaluate(netIn, state);
+        state.inNSE = inNSE; // Set after the call, since a solver may have re-bound the state
+        return netOut;
+    }
+}
@@ -0,0 +1,251 @@
+#include "gridfire/utils/graph.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <cstddef>
+
+namespace gridfire::utils {
+    std::vector<std::vector<size_t>> stronglyConnectedComponents(
+        const size_t numNodes,
+        const std::vector<size_t> &offsets,
+        const std::vector<size_t> &targets
+    ) {
+        constexpr size_t UNVISITED = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> index(numNodes, UNVISITED);
+        std::vector<size_t> lowLink(numNodes, 0);
+        std::vector<uint8_t> onStack(numNodes, 0);
+        std::vector<size_t> componentStack;
+        std::vector<std::pair<size_t, size_t>> callStack; // (node, next edge to visit)
+        std::vector<std::vector<size_t>> components;
+
+        size_t nextIndex = 0;
+        for (size_t root = 0; root < numNodes; ++root) {
+            if (index[root] != UNVISITED) {
+                continue;
+            }
+
+            callStack.emplace_back(root, offsets[root]);
+            index[root] = lowLink[root] = nextIndex++;
+            componentStack.push_back(root);
+            onStack[root] = 1;
+
+            while (!callStack.empty()) {
+                auto& [node, edge] = callStack.back();
+                if (edge < offsets[node + 1]) {
+                    const size_t successor = targets[edge++];
+                    if (index[successor] == UNVISITED) {
+                        // --- Recurse into the successor ---
+                        index[successor] = lowLink[successor] = nextIndex++;
+                        componentStack.push_back(successor);
+                        onStack[successor] = 1;
+                        callStack.emplace_back(successor, offsets[successor]);
+                    } else if (onStack[successor]) {
+                        lowLink[node] = std::min(lowLink[node], index[successor]);
+                    }
+                    continue;
+                }
+
+                // --- All successors visited; pop the node and propagate its low link ---
+                const size_t finished = node;
+                callStack.pop_back();
+                if (!callStack.empty()) {
+                    const size_t parent = callStack.back().first;
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[finished]);
+                }
+
+                if (lowLink[finished] == index[finished]) {
+                    std::vector<size_t> component;
+                    size_t member;
+                    do {
+                        member = componentStack.back();
+                        componentStack.pop_back();
+                        onStack[member] = 0;
+                        component.push_back(member);
+                    } while (member != finished);
+                    components.push_back(std::move(component));
+                }
+            }
+        }
+        return components;
+    }
+
+    void buildAdjacency(
+        const size_t numNodes,
+        const std::vector<std::pair<size_t, size_t>> &edges,
+        std::vector<size_t> &offsets,
+        std::vector<size_t> &targets
+    ) {
+        offsets.assign(numNodes + 1, 0);
+        for (const auto& [source, target] : edges) {
+            ++offsets[source + 1];
+        }
+        for (size_t i = 0; i < numNodes; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        targets.resize(edges.size());
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& [source, target] : edges) {
+            targets[fill[source]++] = target;
+        }
+    }
+
+    size_t BlockOrdering::largestBlock() const {
+        size_t largest = 0;
+        for (size_t b = 0; b < numBlocks(); ++b) {
+            largest = std::max(largest, blockOffsets[b + 1] - blockOffsets[b]);
+        }
+        return largest;
+    }
+
+    BlockOrdering blockTriangularOrdering(
+        const size_t numNodes,
+        const std::vector<size_t> &offsets,
+        const std::vector<size_t> &targets
+    ) {
+        BlockOrdering result;
+        result.ordering.reserve(numNodes);
+        result.blockOffsets.push_back(0);
+        for (const auto& component : stronglyConnectedComponents(numNodes, offsets, targets)) {
+            result.ordering.insert(result.ordering.end(), component.begin(), component.end());
+            result.blockOffsets.push_back(result.ordering.size());
+        }
+        return result;
+    }
+
+    BlockOrdering restrictBlockOrdering(
+        const BlockOrdering &ordering,
+        const std::vector<size_t> &subset
+    ) {
+        constexpr size_t ABSENT = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> subsetPosition(ordering.ordering.size(), ABSENT);
+        for (size_t k = 0; k < subset.size(); ++k) {
+            subsetPosition[subset[k]] = k;
+        }
+
+        BlockOrdering result;
+        result.ordering.reserve(subset.size());
+        result.blockOffsets.push_back(0);
+        for (size_t b = 0; b < ordering.numBlocks(); ++b) {
+            for (size_t k = ordering.blockOffsets[b]; k < ordering.blockOffsets[b + 1]; ++k) {
+                const size_t position = subsetPosition[ordering.ordering[k]];
+                if (position != ABSENT) {
+                    result.ordering.push_back(position);
+                }
+            }
+            if (result.ordering.size() > result.blockOffsets.back()) {
+                result.blockOffsets.push_back(result.ordering.size());
+            }
+        }
+        return result;
+    }
+
+    std::vector<size_t> reverseCuthillMcKee(
+        const size_t numNodes,
+        const std::vector<size_t> &offsets,
+        const std::vector<size_t> &targets
+    ) {
+        std::vector<size_t> degree(numNodes);
+        for (size_t i = 0; i < numNodes; ++i) {
+            degree[i] = offsets[i + 1] - offsets[i];
+        }
+        const auto byDegree = [&degree](const size_t a, const size_t b) {
+            return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+        };
+
+        std::vector<size_t> roots(numNodes);
+        for (size_t i = 0; i < numNodes; ++i) {
+            roots[i] = i;
+        }
+        std::ranges::sort(roots, byDegree);
+
+        std::vector<uint8_t> visited(numNodes, 0);
+        std::vector<size_t> ordering;
+        ordering.reserve(numNodes);
+        std::vector<size_t> neighbours;
+        for (const size_t root : roots) {
+            if (visited[root]) {
+                continue;
+            }
+
+            // --- Breadth first traversal of the component; `ordering` doubles as the queue ---
+            size_t head = ordering.size();
+            ordering.push_back(root);
+            visited[root] = 1;
+            while (head < ordering.size()) {
+                const size_t node = ordering[head++];
+                neighbours.clear();
+                for (size_t e = offsets[node]; e < offsets[node + 1]; ++e) {
+                    const size_t neighbour = targets[e];
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = 1;
+                        neighbours.push_back(neighbour);
+                    }
+                }
+                std::ranges::sort(neighbours, byDegree);
+                ordering.insert(ordering.end(), neighbours.begin(), neighbours.end());
+            }
+        }
+
+        std::ranges::reverse(ordering);
+        return ordering;
+    }
+
+    bool SparsityPattern::contains(const size_t row, const size_t column) const {
+        const auto first = columnIndices.begin() + static_cast<std::ptrdiff_t>(rowOffsets[row]);
+        const auto last = columnIndices.begin() + static_cast<std::ptrdiff_t>(rowOffsets[row + 1]);
+        return std::binary_search(first, last, column);
+    }
+
+    SparsityPattern buildSparsityPattern(
+        const size_t numRows,
+        const size_t numColumns,
+        std::vector<std::pair<size_t, size_t>> entries
+    ) {
+        std::ranges::sort(entries);
+        const auto duplicates = std::ranges::unique(entries);
+        entries.erase(duplicates.begin(), duplicates.end());
+
+        SparsityPattern pattern;
+        pattern.numRows = numRows;
+        pattern.numColumns = numColumns;
+        buildAdjacency(numRows, entries, pattern.rowOffsets, pattern.columnIndices); // Sorted entries give sorted rows
+        return pattern;
+    }
+
+    SparsityPattern restrictSparsityPattern(
+        const SparsityPattern &pattern,
+        const std::vector<size_t> &rowSubset,
+        const std::vector<size_t> &columnSubset
+    ) {
+        constexpr size_t ABSENT = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> columnPosition(pattern.numColumns, ABSENT);
+        for (size_t k = 0; k < columnSubset.size(); ++k) {
+            columnPosition[columnSubset[k]] = k;
+        }
+
+        SparsityPattern result;
+        result.numRows = rowSubset.size();
+        result.numColumns = columnSubset.size();
+        result.rowOffsets.reserve(rowSubset.size() + 1);
+        result.rowOffsets.push_back(0);
+        for (const size_t row : rowSubset) {
+            const size_t rowBegin = result.columnIndices.size();
+            for (size_t e = pattern.rowOffsets[row]; e < pattern.rowOffsets[row + 1]; ++e) {
+                const size_t position = columnPosition[pattern.columnIndices[e]];
+                if (position != ABSENT) {
+                    result.columnIndices.push_back(position);
+                }
+            }
+            std::sort(result.columnIndices.begin() + static_cast<std::ptrdiff_t>(rowBegin), result.columnIndices.end());
+            result.rowOffsets.push_back(result.columnIndices.size());
+        }
+        return result;
+    }
+}
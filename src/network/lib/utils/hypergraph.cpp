@@ -0,0 +1,176 @@
+#include "gridfire/utils/hypergraph.h"
+#include "gridfire/reaction/reaction.h"
+
+#include "fourdst/composition/atomicSpecies.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace gridfire::utils {
+    using fourdst::atomic::Species;
+
+    namespace {
+        /**
+         * @brief Transposes a reaction → species CSR incidence into species → reaction.
+         */
+        void transposeIncidence(
+            const size_t numSpecies,
+            const std::vector<size_t>& offsets,
+            const std::vector<size_t>& indices,
+            std::vector<size_t>& outOffsets,
+            std::vector<size_t>& outIndices
+        ) {
+            outOffsets.assign(numSpecies + 1, 0);
+            for (const size_t i : indices) {
+                ++outOffsets[i + 1];
+            }
+            for (size_t i = 0; i < numSpecies; ++i) {
+                outOffsets[i + 1] += outOffsets[i];
+            }
+            outIndices.assign(indices.size(), 0);
+            std::vector<size_t> cursor(outOffsets.begin(), outOffsets.end() - 1);
+            // Reactions are visited in increasing order, so each species' list comes out sorted
+            for (size_t j = 0; j + 1 < offsets.size(); ++j) {
+                for (size_t k = offsets[j]; k < offsets[j + 1]; ++k) {
+                    outIndices[cursor[indices[k]]++] = j;
+                }
+            }
+        }
+    }
+
+    NetworkHypergraph::NetworkHypergraph(
+        const std::vector<Species> &species,
+        const reaction::LogicalReactionSet &reactions
+    ) {
+        m_speciesIndex.reserve(species.size());
+        for (size_t i = 0; i < species.size(); ++i) {
+            m_speciesIndex.emplace(species[i], i);
+        }
+
+        // --- Reaction -> species incidence, collapsing repeated species into counts ---
+        const auto appendUnique = [&](
+            const std::vector<Species>& members,
+            const std::string_view reactionId,
+            std::vector<size_t>& outIndices,
+            std::vector<int>& outCounts
+        ) {
+            std::vector<size_t> local;
+            local.reserve(members.size());
+            for (const auto& member : members) {
+                const auto it = m_speciesIndex.find(member);
+                if (it == m_speciesIndex.end()) {
+                    throw std::runtime_error(
+                        "Species '" + std::string(member.name()) + "' of reaction '" + std::string(reactionId) +
+                        "' is not part of the network hypergraph."
+                    );
+                }
+                local.push_back(it->second);
+            }
+            std::ranges::sort(local);
+            for (size_t k = 0; k < local.size(); ) {
+                size_t next = k;
+                while (next < local.size() && local[next] == local[k]) {
+                    ++next;
+                }
+                outIndices.push_back(local[k]);
+                outCounts.push_back(static_cast<int>(next - k));
+                k = next;
+            }
+        };
+
+        m_reactantOffsets.reserve(reactions.size() + 1);
+        m_productOffsets.reserve(reactions.size() + 1);
+        m_reactantOffsets.push_back(0);
+        m_productOffsets.push_back(0);
+        for (const auto& reaction : reactions) {
+            appendUnique(reaction.reactants(), reaction.id(), m_reactantIndices, m_reactantCounts);
+            appendUnique(reaction.products(), reaction.id(), m_productIndices, m_productCounts);
+            m_reactantOffsets.push_back(m_reactantIndices.size());
+            m_productOffsets.push_back(m_productIndices.size());
+        }
+
+        // --- Species -> reaction incidence ---
+        transposeIncidence(species.size(), m_reactantOffsets, m_reactantIndices, m_consumerOffsets, m_consumerIndices);
+        transposeIncidence(species.size(), m_productOffsets, m_productIndices, m_producerOffsets, m_producerIndices);
+    }
+
+    bool NetworkHypergraph::containsSpecies(const Species &species) const {
+        return m_speciesIndex.contains(species);
+    }
+
+    size_t NetworkHypergraph::speciesIndex(const Species &species) const {
+        const auto it = m_speciesIndex.find(species);
+        if (it == m_speciesIndex.end()) {
+            throw std::out_of_range("Species '" + std::string(species.name()) + "' is not part of the network hypergraph.");
+        }
+        return it->second;
+    }
+
+    std::span<const size_t> NetworkHypergraph::reactants(const size_t j) const {
+        return {m_reactantIndices.data() + m_reactantOffsets[j], m_reactantOffsets[j + 1] - m_reactantOffsets[j]};
+    }
+
+    std::span<const int> NetworkHypergraph::reactantCounts(const size_t j) const {
+        return {m_reactantCounts.data() + m_reactantOffsets[j], m_reactantOffsets[j + 1] - m_reactantOffsets[j]};
+    }
+
+    std::span<const size_t> NetworkHypergraph::products(const size_t j) const {
+        return {m_productIndices.data() + m_productOffsets[j], m_productOffsets[j + 1] - m_productOffsets[j]};
+    }
+
+    std::span<const int> NetworkHypergraph::productCounts(const size_t j) const {
+        return {m_productCounts.data() + m_productOffsets[j], m_productOffsets[j + 1] - m_productOffsets[j]};
+    }
+
+    std::span<const size_t> NetworkHypergraph::consumers(const size_t i) const {
+        return {m_consumerIndices.data() + m_consumerOffsets[i], m_consumerOffsets[i + 1] - m_consumerOffsets[i]};
+    }
+
+    std::span<const size_t> NetworkHypergraph::producers(const size_t i) const {
+        return {m_producerIndices.data() + m_producerOffsets[i], m_producerOffsets[i + 1] - m_producerOffsets[i]};
+    }
+
+    std::vector<bool> NetworkHypergraph::reachableFrom(const std::vector<size_t> &seeds) const {
+        std::vector<bool> reached(numSpecies(), false);
+        std::vector<size_t> worklist;
+        worklist.reserve(numSpecies());
+
+        const auto reach = [&](const size_t i) {
+            if (!reached[i]) {
+                reached[i] = true;
+                worklist.push_back(i);
+            }
+        };
+
+        std::vector<size_t> remaining(numReactions());
+        for (size_t j = 0; j < numReactions(); ++j) {
+            remaining[j] = m_reactantOffsets[j + 1] - m_reactantOffsets[j];
+            if (remaining[j] == 0) {
+                for (const size_t product : products(j)) {
+                    reach(product);
+                }
+            }
+        }
+        for (const size_t seed : seeds) {
+            reach(seed);
+        }
+
+        while (!worklist.empty()) {
+            const size_t i = worklist.back();
+            worklist.pop_back();
+            for (const size_t j : consumers(i)) {
+                if (--remaining[j] == 0) {
+                    for (const size_t product : products(j)) {
+                        reach(product);
+                    }
+                }
+            }
+        }
+        return reached;
+    }
+}
@@ -5,8 +5,12 @@
 #include "fourdst/config/config.h"
 #include "gridfire/engine/engine_approx8.h"
 #include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_defined.h"
+#include "gridfire/io/network_file.h"
 #include "gridfire/network.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 
@@ -89,3 +93,64 @@ TEST_F(approx8Test, reaclib) {
     // netOut = network.evaluate(netIn);
     // std::cout << netOut << std::endl;
 }
+
+/**
+ * @brief The reordered precomputed kernels give the same RHS, energy and Jacobian as the natural species order.
+ */
+TEST_F(approx8Test, speciesReordering) {
+    using namespace gridfire;
+    const std::vector<double> comp = {0.708, 0.0, 2.94e-5, 0.276, 0.003, 0.0011, 9.62e-3, 1.62e-3, 5.16e-4};
+    const std::vector<std::string> symbols = {"H-1", "H-2", "He-3", "He-4", "C-12", "N-14", "O-16", "Ne-20", "Mg-24"};
+
+    fourdst::composition::Composition composition;
+    composition.registerSymbol(symbols, true);
+    composition.setMassFraction(symbols, comp);
+    composition.finalize(true);
+
+    GraphEngine graph(composition);
+    io::SimpleReactionListFileParser parser{};
+    const std::string approx8Net = std::string(getenv("MESON_SOURCE_ROOT")) + "/tests/graphnet_sandbox/approx8.net";
+    FileDefinedEngineView approx8(graph, approx8Net, parser);
+
+    const auto& species = approx8.getNetworkSpecies();
+    const size_t numSpecies = species.size();
+    std::vector<double> Y(numSpecies);
+    for (size_t i = 0; i < numSpecies; ++i) {
+        const double abundance = composition.contains(species[i]) ?
+            composition.getMolarAbundance(std::string(species[i].name())) : 0.0;
+        Y[i] = std::max(abundance, 1.0e-20); // Keep every reaction flowing so that no Jacobian entry is trivially zero
+    }
+    const double T9 = 0.015;
+    const double rho = 1.0e2;
+
+    const auto evaluate = [&](const bool reorder, StepDerivatives<double>& derivatives, std::vector<double>& jacobian) {
+        graph.setSpeciesReordering(reorder);
+        EXPECT_EQ(graph.isSpeciesReorderingEnabled(), reorder);
+        derivatives = approx8.calculateRHSAndEnergy(Y, T9, rho);
+        approx8.generateJacobianMatrix(Y, T9, rho);
+        jacobian.assign(numSpecies * numSpecies, 0.0);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            for (size_t j = 0; j < numSpecies; ++j) {
+                jacobian[i * numSpecies + j] = approx8.getJacobianMatrixEntry(static_cast<int>(i), static_cast<int>(j));
+            }
+        }
+    };
+
+    StepDerivatives<double> reordered, natural;
+    std::vector<double> reorderedJacobian, naturalJacobian;
+    evaluate(true, reordered, reorderedJacobian);
+    evaluate(false, natural, naturalJacobian);
+
+    const double relError = 1e-12;
+    const auto expectClose = [relError](const double a, const double b) {
+        EXPECT_NEAR(a, b, relError * std::max({std::abs(a), std::abs(b), 1e-300}));
+    };
+    ASSERT_EQ(reordered.dydt.size(), natural.dydt.size());
+    for (size_t i = 0; i < numSpecies; ++i) {
+        expectClose(reordered.dydt[i], natural.dydt[i]);
+    }
+    expectClose(reordered.nuclearEnergyGenerationRate, natural.nuclearEnergyGenerationRate);
+    for (size_t k = 0; k < reorderedJacobian.size(); ++k) {
+        expectClose(reorderedJacobian[k], naturalJacobian[k]);
+    }
+}
@@ -0,0 +1,363 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include "fourdst/composition/composition.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_adaptive.h"
+#include "gridfire/engine/views/engine_defined.h"
+#include "gridfire/engine/views/engine_drgep.h"
+#include "gridfire/engine/views/engine_fused.h"
+#include "gridfire/io/network_file.h"
+#include "gridfire/network.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const std::string APPROX8_NET = std::string(getenv("MESON_SOURCE_ROOT")) + "/tests/graphnet_sandbox/approx8.net";
+
+    gridfire::NetIn approx8NetIn() {
+        const std::vector<double> comp = {0.708, 0.0, 2.94e-5, 0.276, 0.003, 0.0011, 9.62e-3, 1.62e-3, 5.16e-4};
+        const std::vector<std::string> symbols = {"H-1", "H-2", "He-3", "He-4", "C-12", "N-14", "O-16", "Ne-20", "Mg-24"};
+
+        fourdst::composition::Composition composition;
+        composition.registerSymbol(symbols, true);
+        composition.setMassFraction(symbols, comp);
+        composition.finalize(true);
+
+        gridfire::NetIn netIn;
+        netIn.composition = composition;
+        netIn.temperature = 1.5e7;
+        netIn.density = 1e2;
+        netIn.energy = 0.0;
+        netIn.tMax = 3.15e13;
+        netIn.dt0 = 1e-12;
+        return netIn;
+    }
+
+    /**
+     * @brief Molar abundances of the engine species, floored so that every reaction flows.
+     */
+    std::vector<double> molarAbundances(const gridfire::DynamicEngine& engine, const gridfire::NetIn& netIn) {
+        const auto& species = engine.getNetworkSpecies();
+        std::vector<double> Y(species.size());
+        for (size_t i = 0; i < species.size(); ++i) {
+            const double abundance = netIn.composition.contains(species[i]) ?
+                netIn.composition.getMolarAbundance(std::string(species[i].name())) : 0.0;
+            Y[i] = std::max(abundance, 1.0e-20);
+        }
+        return Y;
+    }
+
+    /**
+     * @brief A distinct multiplier for each reaction of the engine.
+     */
+    std::vector<double> testMultipliers(const gridfire::GraphEngine& engine) {
+        std::vector<double> multipliers(engine.getNetworkReactions().size());
+        for (size_t i = 0; i < multipliers.size(); ++i) {
+            multipliers[i] = 0.5 + 0.25 * static_cast<double>(i % 5);
+        }
+        return multipliers;
+    }
+}
+
+class engineViewTest : public ::testing::Test {};
+
+/**
+ * @brief The compact engine of an AdaptiveEngineView carries the rate multipliers of the base engine.
+ */
+TEST_F(engineViewTest, compactEngineRateMultipliers) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    graph.setRateMultipliers(testMultipliers(graph));
+
+    AdaptiveEngineView delegating(approx8);
+    delegating.setCompactEngineMaterialization(false);
+    delegating.update(netIn);
+
+    AdaptiveEngineView compact(approx8);
+    compact.setCompactEngineMaterialization(true);
+    compact.update(netIn);
+
+    ASSERT_EQ(compact.getNetworkSpecies(), delegating.getNetworkSpecies());
+    EXPECT_EQ(compact.getRateMultipliers(), delegating.getRateMultipliers());
+
+    const double T9 = netIn.temperature / 1.0e9;
+    const std::vector<double> Y = molarAbundances(delegating, netIn);
+    const auto expected = delegating.calculateRHSAndEnergy(Y, T9, netIn.density);
+    const auto actual = compact.calculateRHSAndEnergy(Y, T9, netIn.density);
+
+    const double relError = 1e-12;
+    for (size_t i = 0; i < expected.dydt.size(); ++i) {
+        EXPECT_NEAR(actual.dydt[i], expected.dydt[i], relError * std::abs(expected.dydt[i]));
+    }
+    EXPECT_NEAR(actual.nuclearEnergyGenerationRate, expected.nuclearEnergyGenerationRate,
+        relError * std::abs(expected.nuclearEnergyGenerationRate));
+
+    // --- The multipliers do change the result, and the compact engine follows later changes ---
+    graph.setRateMultipliers(std::vector<double>(graph.getNetworkReactions().size(), 1.0));
+    const auto unmultiplied = delegating.calculateRHSAndEnergy(Y, T9, netIn.density);
+    EXPECT_GT(std::abs(unmultiplied.nuclearEnergyGenerationRate / expected.nuclearEnergyGenerationRate - 1.0), 1e-3);
+
+    EXPECT_EQ(compact.getRateMultipliers(), delegating.getRateMultipliers());
+    const auto compactUnmultiplied = compact.calculateRHSAndEnergy(Y, T9, netIn.density);
+    for (size_t i = 0; i < unmultiplied.dydt.size(); ++i) {
+        EXPECT_NEAR(compactUnmultiplied.dydt[i], unmultiplied.dydt[i], relError * std::abs(unmultiplied.dydt[i]));
+    }
+    EXPECT_NEAR(compactUnmultiplied.nuclearEnergyGenerationRate, unmultiplied.nuclearEnergyGenerationRate,
+        relError * std::abs(unmultiplied.nuclearEnergyGenerationRate));
+}
+
+/**
+ * @brief The derivatives of the RHS and of the taped Jacobian with respect to each rate multiplier agree
+ *        with central finite differences.
+ *
+ * The RHS is linear in each multiplier: d(dY_i/dt)/dm_j is nu_ij times the unmultiplied flow of reaction j
+ * over rho, and dJ/dm_j is the Jacobian with only reaction j switched on.
+ */
+TEST_F(engineViewTest, rateMultiplierSensitivity) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    const FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    GraphEngine engine(approx8.getNetworkReactions());
+
+    const auto& species = engine.getNetworkSpecies();
+    const auto& reactions = engine.getNetworkReactions();
+    const size_t numSpecies = species.size();
+    const double T9 = netIn.temperature / 1.0e9;
+    const double rho = netIn.density;
+    const std::vector<double> Y = molarAbundances(engine, netIn);
+    const std::vector<double> multipliers = testMultipliers(engine);
+
+    auto jacobian = [&](const std::vector<double>& m) {
+        engine.setRateMultipliers(m);
+        engine.generateJacobianMatrix(Y, T9, rho);
+        std::vector<double> J(numSpecies * numSpecies);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            for (size_t k = 0; k < numSpecies; ++k) {
+                J[i * numSpecies + k] = engine.getJacobianMatrixEntry(static_cast<int>(i), static_cast<int>(k));
+            }
+        }
+        return J;
+    };
+
+    engine.setRateMultipliers(multipliers);
+    const auto rhs = engine.calculateRHSAndEnergy(Y, T9, rho);
+    const std::vector<double> J = jacobian(multipliers);
+    engine.generateStoichiometryMatrix();
+
+    for (size_t j = 0; j < reactions.size(); ++j) {
+        const double h = 1.0e-3 * multipliers[j];
+        std::vector<double> plus = multipliers;
+        std::vector<double> minus = multipliers;
+        plus[j] += h;
+        minus[j] -= h;
+
+        // --- RHS ---
+        engine.setRateMultipliers(multipliers);
+        const double unmultipliedFlow = engine.calculateMolarReactionFlow(reactions[j], Y, T9, rho) / multipliers[j];
+        engine.setRateMultipliers(plus);
+        const auto rhsPlus = engine.calculateRHSAndEnergy(Y, T9, rho);
+        engine.setRateMultipliers(minus);
+        const auto rhsMinus = engine.calculateRHSAndEnergy(Y, T9, rho);
+        for (size_t i = 0; i < numSpecies; ++i) {
+            const double fd = (rhsPlus.dydt[i] - rhsMinus.dydt[i]) / (2.0 * h);
+            const double expected = engine.getStoichiometryMatrixEntry(static_cast<int>(i), static_cast<int>(j)) * unmultipliedFlow / rho;
+            EXPECT_NEAR(fd, expected, 1e-6 * std::abs(expected) + 1e-9 * std::abs(rhs.dydt[i]) / multipliers[j])
+                << reactions[j].id() << ", species " << species[i].name();
+        }
+
+        // --- Taped Jacobian ---
+        std::vector<double> only(reactions.size(), 0.0);
+        only[j] = 1.0;
+        const std::vector<double> expectedJ = jacobian(only);
+        const std::vector<double> JPlus = jacobian(plus);
+        const std::vector<double> JMinus = jacobian(minus);
+        for (size_t e = 0; e < J.size(); ++e) {
+            const double fd = (JPlus[e] - JMinus[e]) / (2.0 * h);
+            EXPECT_NEAR(fd, expectedJ[e], 1e-6 * std::abs(expectedJ[e]) + 1e-9 * std::abs(J[e]) / multipliers[j])
+                << reactions[j].id() << ", entry " << e;
+        }
+    }
+}
+
+/**
+ * @brief An AdaptiveEngineView patched through a sequence of updates keeps consistent index maps, and its
+ *        masked compact engine agrees with a view delegating to the base engine.
+ */
+TEST_F(engineViewTest, incrementalAdaptiveUpdate) {
+    using namespace gridfire;
+    const NetIn cno = approx8NetIn();
+
+    NetIn ppOnly = cno;
+    fourdst::composition::Composition hydrogenHelium;
+    hydrogenHelium.registerSymbol(std::vector<std::string>{"H-1", "He-4"}, true);
+    hydrogenHelium.setMassFraction(std::vector<std::string>{"H-1", "He-4"}, {0.72, 0.28});
+    hydrogenHelium.finalize(true);
+    ppOnly.composition = hydrogenHelium;
+
+    GraphEngine graph(cno.composition);
+    graph.setRateMultipliers(testMultipliers(graph));
+    const auto& fullSpecies = graph.getNetworkSpecies();
+    const auto& fullReactions = graph.getNetworkReactions();
+
+    // Both views see the same sequence of updates, so their add/drop hysteresis agrees
+    AdaptiveEngineView compact(graph);
+    compact.setCompactEngineMaterialization(true);
+    AdaptiveEngineView delegating(graph);
+    delegating.setCompactEngineMaterialization(false);
+
+    for (const NetIn& netIn : {ppOnly, cno, ppOnly, cno}) {
+        compact.update(netIn);
+        delegating.update(netIn);
+
+        const auto& species = delegating.getNetworkSpecies();
+        const auto& reactions = delegating.getNetworkReactions();
+        ASSERT_EQ(compact.getNetworkSpecies(), species);
+        ASSERT_TRUE(compact.getNetworkReactions() == reactions);
+
+        // --- The patched maps point at the right base engine entries, and the species are those of the reactions in mass order ---
+        const auto& speciesMap = delegating.getSpeciesIndexMap();
+        const auto& reactionMap = delegating.getReactionIndexMap();
+        ASSERT_EQ(speciesMap.size(), species.size());
+        ASSERT_EQ(reactionMap.size(), reactions.size());
+        for (size_t i = 0; i < species.size(); ++i) {
+            EXPECT_EQ(fullSpecies[speciesMap[i]], species[i]);
+            EXPECT_TRUE(reactions.contains_species(species[i]));
+            if (i > 0) {
+                EXPECT_LE(species[i - 1].mass(), species[i].mass());
+            }
+        }
+        for (size_t j = 0; j < reactions.size(); ++j) {
+            EXPECT_EQ(fullReactions[reactionMap[j]].id(), reactions[j].id());
+            for (const auto& s : reactions[j].reactants()) {
+                EXPECT_NE(std::ranges::find(species, s), species.end());
+            }
+        }
+
+        const double T9 = netIn.temperature / 1.0e9;
+        const std::vector<double> Y = molarAbundances(delegating, netIn);
+        const auto expected = delegating.calculateRHSAndEnergy(Y, T9, netIn.density);
+        const auto actual = compact.calculateRHSAndEnergy(Y, T9, netIn.density);
+        for (size_t i = 0; i < expected.dydt.size(); ++i) {
+            EXPECT_NEAR(actual.dydt[i], expected.dydt[i], 1e-12 * std::abs(expected.dydt[i]));
+        }
+        EXPECT_NEAR(actual.nuclearEnergyGenerationRate, expected.nuclearEnergyGenerationRate,
+            1e-12 * std::abs(expected.nuclearEnergyGenerationRate));
+
+        const auto expectedFlows = delegating.calculateAllMolarReactionFlows(Y, T9, netIn.density);
+        const auto actualFlows = compact.calculateAllMolarReactionFlows(Y, T9, netIn.density);
+        for (size_t j = 0; j < expectedFlows.size(); ++j) {
+            EXPECT_NEAR(actualFlows[j], expectedFlows[j], 1e-12 * std::abs(expectedFlows[j]));
+        }
+        EXPECT_EQ(compact.getRateMultipliers(), delegating.getRateMultipliers());
+    }
+}
+
+/**
+ * @brief A FusedEngineView refuses to touch a root engine which a wrapped view has replaced, until it is updated.
+ */
+TEST_F(engineViewTest, fusedViewRebuiltRoot) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    AdaptiveEngineView adaptive(graph);
+    adaptive.setCompactEngineMaterialization(true);
+    adaptive.update(netIn);
+    FusedEngineView fused(adaptive);
+    EXPECT_EQ(fused.numFusedLayers(), 1u);
+
+    // --- Rebuilding the compact engine directly through the adaptive view frees the old root ---
+    adaptive.setCompactEngineMaterialization(true);
+    adaptive.update(netIn);
+    EXPECT_THROW(static_cast<void>(fused.getJacobianMatrixEntry(0, 0)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(fused.getStoichiometryMatrixEntry(0, 0)), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(fused.getScreeningModel()), std::runtime_error);
+    EXPECT_THROW(static_cast<void>(fused.getBaseEngine()), std::runtime_error);
+
+    fused.update(netIn);
+    const double T9 = netIn.temperature / 1.0e9;
+    const std::vector<double> Y = molarAbundances(adaptive, netIn);
+    EXPECT_EQ(fused.getScreeningModel(), adaptive.getScreeningModel());
+    const auto expected = adaptive.calculateRHSAndEnergy(Y, T9, netIn.density);
+    const auto actual = fused.calculateRHSAndEnergy(Y, T9, netIn.density);
+    ASSERT_EQ(actual.dydt.size(), expected.dydt.size());
+    for (size_t i = 0; i < expected.dydt.size(); ++i) {
+        EXPECT_DOUBLE_EQ(actual.dydt[i], expected.dydt[i]);
+    }
+
+    fused.generateJacobianMatrix(Y, T9, netIn.density);
+    adaptive.generateJacobianMatrix(Y, T9, netIn.density);
+    EXPECT_DOUBLE_EQ(fused.getJacobianMatrixEntry(0, 0), adaptive.getJacobianMatrixEntry(0, 0));
+}
+
+/**
+ * @brief A DRGEPEngineView presents the base engine until its first update, and its skeletal engine
+ *        carries the base engine's rate multipliers by reaction id.
+ */
+TEST_F(engineViewTest, drgepSkeletonRateMultipliers) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    const auto& fullSpecies = graph.getNetworkSpecies();
+    std::vector<fourdst::atomic::Species> targets;
+    for (const auto& species : fullSpecies) {
+        if (species.name() == "H-1" || species.name() == "He-4") {
+            targets.push_back(species);
+        }
+    }
+    ASSERT_EQ(targets.size(), 2);
+
+    DRGEPEngineView drgep(graph, targets);
+    EXPECT_EQ(&drgep.getMappedEngine(), static_cast<DynamicEngine*>(&graph));
+    EXPECT_EQ(drgep.getNetworkSpecies(), fullSpecies);
+
+    const std::vector<double> fullMultipliers = testMultipliers(graph);
+    graph.setRateMultipliers(fullMultipliers);
+    drgep.update(netIn);
+
+    std::unordered_map<std::string_view, double> multiplierById;
+    for (size_t j = 0; j < graph.getNetworkReactions().size(); ++j) {
+        multiplierById.emplace(graph.getNetworkReactions()[j].id(), fullMultipliers[j]);
+    }
+
+    const auto& reactions = drgep.getNetworkReactions();
+    const std::vector<double> multipliers = drgep.getRateMultipliers();
+    ASSERT_EQ(multipliers.size(), reactions.size());
+    std::vector<double> expectedMultipliers(reactions.size());
+    for (size_t j = 0; j < reactions.size(); ++j) {
+        expectedMultipliers[j] = multiplierById.at(reactions[j].id());
+        EXPECT_EQ(multipliers[j], expectedMultipliers[j]) << reactions[j].id();
+    }
+
+    // --- The skeleton agrees with a fresh engine over its reactions, multiplied by id ---
+    GraphEngine reference(reactions);
+    reference.setRateMultipliers(expectedMultipliers);
+    ASSERT_EQ(reference.getNetworkSpecies(), drgep.getNetworkSpecies());
+
+    const double T9 = netIn.temperature / 1.0e9;
+    const std::vector<double> Y = molarAbundances(drgep, netIn);
+    const auto expected = reference.calculateRHSAndEnergy(Y, T9, netIn.density);
+    const auto actual = drgep.calculateRHSAndEnergy(Y, T9, netIn.density);
+
+    const double relError = 1e-12;
+    for (size_t i = 0; i < expected.dydt.size(); ++i) {
+        EXPECT_NEAR(actual.dydt[i], expected.dydt[i], relError * std::abs(expected.dydt[i]));
+    }
+    EXPECT_NEAR(actual.nuclearEnergyGenerationRate, expected.nuclearEnergyGenerationRate,
+        relError * std::abs(expected.nuclearEnergyGenerationRate));
+}
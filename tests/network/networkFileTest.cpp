@@ -0,0 +1,156 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include "fourdst/composition/species.h"
+#include "gridfire/io/network_file.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    const std::filesystem::path TEST_DIR = std::filesystem::path(getenv("MESON_BUILD_ROOT")) / "networkFileTest";
+
+    std::string writeFile(const std::string& name, const std::string& content) {
+        std::filesystem::create_directories(TEST_DIR);
+        const std::filesystem::path path = TEST_DIR / name;
+        std::ofstream(path) << content;
+        return path.string();
+    }
+
+    /**
+     * @brief A reaction list parser counting how often it actually parses content.
+     */
+    class CountingParser final : public gridfire::io::NetworkFileParser {
+    public:
+        mutable int parses = 0;
+
+    protected:
+        gridfire::io::ParsedNetworkData parseContent(const std::string_view content, const std::string&) const override {
+            ++parses;
+            gridfire::io::ParsedNetworkData parsed;
+            size_t start = 0;
+            while (start < content.size()) {
+                size_t end = content.find('\n', start);
+                if (end == std::string_view::npos) {
+                    end = content.size();
+                }
+                if (end > start) {
+                    parsed.reactionPENames.emplace_back(content.substr(start, end - start));
+                }
+                start = end + 1;
+            }
+            return parsed;
+        }
+    };
+
+    /**
+     * @brief A parser written against the filename interface, overriding parse() only.
+     */
+    class FilenameParser final : public gridfire::io::NetworkFileParser {
+    public:
+        [[nodiscard]] gridfire::io::ParsedNetworkData parse(const std::string& filename) const override {
+            gridfire::io::ParsedNetworkData parsed;
+            parsed.reactionPENames.push_back(filename);
+            return parsed;
+        }
+    };
+}
+
+class networkFileTest : public ::testing::Test {};
+
+/**
+ * @brief A MESA network file is read through the memory map, and the ground state of an isomer is the plain isotope.
+ */
+TEST_F(networkFileTest, mesaMappedParseWithIsomer) {
+    using namespace gridfire::io;
+    const std::string path = writeFile("isomer.net",
+        "! Al-26 in its ground state\n"
+        "add_isos(h1, he4, al26-1)\n"
+        "add_reactions(r_al26-1_pg_si27)\n");
+
+    const MESANetworkFileParser parser(path);
+    const ParsedNetworkData parsed = parser.parse(path);
+
+    const auto& al26 = fourdst::atomic::species.at("Al-26");
+    ASSERT_EQ(parsed.isotopes.size(), 3);
+    EXPECT_EQ(parsed.isotopes[2], al26);
+    EXPECT_NE(parsed.contentHash, 0u);
+
+    ASSERT_EQ(parsed.reactionSpecifications.size(), 1);
+    const auto& [label, reactants, products] = parsed.reactionSpecifications[0];
+    EXPECT_EQ(label, "r_al26-1_pg_si27");
+    ASSERT_EQ(reactants.size(), 2);
+    EXPECT_EQ(reactants[0], al26);
+    EXPECT_EQ(reactants[1], fourdst::atomic::species.at("H-1"));
+    ASSERT_EQ(products.size(), 1);
+    EXPECT_EQ(products[0], fourdst::atomic::species.at("Si-27"));
+
+    // --- Excited isomeric states are not held by the base networks ---
+    const std::string excited = writeFile("excited.net", "add_isos(al26-2)\n");
+    EXPECT_THROW((void)MESANetworkFileParser(excited).parse(excited), std::runtime_error);
+}
+
+/**
+ * @brief parseCached reuses earlier parses, copies of a parser share its cache, and the cache is bounded.
+ */
+TEST_F(networkFileTest, parseCache) {
+    using namespace gridfire::io;
+    static_assert(std::is_copy_constructible_v<MESANetworkFileParser> && std::is_move_constructible_v<MESANetworkFileParser>);
+    static_assert(std::is_copy_assignable_v<SimpleReactionListFileParser> && std::is_move_assignable_v<SimpleReactionListFileParser>);
+
+    const std::string first = writeFile("first.txt", "p(p,e+)d\nd(p,g)he3\n");
+    const std::string copy = writeFile("copy.txt", "p(p,e+)d\nd(p,g)he3\n");
+
+    CountingParser parser;
+    const ParsedNetworkData parsed = parser.parseCached(first);
+    EXPECT_EQ(parser.parse(first).reactionPENames, parsed.reactionPENames);
+    EXPECT_EQ(parser.parses, 2);
+
+    // --- Hits: an unchanged path, and the same content under another path ---
+    EXPECT_EQ(parser.parseCached(first).reactionPENames, parsed.reactionPENames);
+    EXPECT_EQ(parser.parseCached(copy).contentHash, parsed.contentHash);
+    EXPECT_EQ(parser.parses, 2);
+
+    const CountingParser sharing = parser;
+    EXPECT_EQ(sharing.getCache(), parser.getCache());
+    EXPECT_EQ(sharing.parseCached(first).reactionPENames, parsed.reactionPENames);
+    EXPECT_EQ(sharing.parses, 2);
+
+    // --- A parser of another type never sees the entries of this one ---
+    SimpleReactionListFileParser simple;
+    simple.setCache(parser.getCache());
+    EXPECT_EQ(simple.parseCached(first).reactionPENames, parsed.reactionPENames);
+    EXPECT_EQ(parser.getCache()->size(), 2);
+
+    // --- Least recently used entries are evicted ---
+    CountingParser bounded;
+    bounded.setCache(std::make_shared<NetworkFileParseCache>(1));
+    const std::string second = writeFile("second.txt", "he3(he3,2p)he4\n");
+    (void)bounded.parseCached(first);
+    (void)bounded.parseCached(second);
+    EXPECT_EQ(bounded.getCache()->size(), 1);
+    (void)bounded.parseCached(first);
+    EXPECT_EQ(bounded.parses, 3);
+
+    EXPECT_THROW(bounded.setCache(nullptr), std::runtime_error);
+}
+
+/**
+ * @brief A parser overriding parse() only is used by parseCached as well.
+ */
+TEST_F(networkFileTest, filenameInterfaceParser) {
+    using namespace gridfire::io;
+    const std::string path = writeFile("filename.txt", "unused\n");
+
+    const FilenameParser parser;
+    const ParsedNetworkData parsed = parser.parseCached(path);
+    ASSERT_EQ(parsed.reactionPENames.size(), 1);
+    EXPECT_EQ(parsed.reactionPENames[0], path);
+    EXPECT_NE(parsed.contentHash, 0u);
+}
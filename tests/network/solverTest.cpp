@@ -0,0 +1,297 @@
+#include <string>
+#include <gtest/gtest.h>
+
+#include "fourdst/composition/composition.h"
+#include "fourdst/config/config.h"
+#include "gridfire/engine/engine_graph.h"
+#include "gridfire/engine/views/engine_defined.h"
+#include "gridfire/io/network_file.h"
+#include "gridfire/solver/solver.h"
+#include "gridfire/solver/solver_imex.h"
+#include "gridfire/solver/solver_events.h"
+#include "gridfire/solver/solver_nse.h"
+#include "gridfire/network.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    const std::string APPROX8_NET = std::string(getenv("MESON_SOURCE_ROOT")) + "/tests/graphnet_sandbox/approx8.net";
+
+    fourdst::composition::Composition approx8Composition() {
+        const std::vector<double> comp = {0.708, 0.0, 2.94e-5, 0.276, 0.003, 0.0011, 9.62e-3, 1.62e-3, 5.16e-4};
+        const std::vector<std::string> symbols = {"H-1", "H-2", "He-3", "He-4", "C-12", "N-14", "O-16", "Ne-20", "Mg-24"};
+
+        fourdst::composition::Composition composition;
+        composition.registerSymbol(symbols, true);
+        composition.setMassFraction(symbols, comp);
+        composition.finalize(true);
+        return composition;
+    }
+
+    gridfire::NetIn approx8NetIn() {
+        gridfire::NetIn netIn;
+        netIn.composition = approx8Composition();
+        netIn.temperature = 1.5e7;
+        netIn.density = 1e2;
+        netIn.energy = 0.0;
+        netIn.tMax = 3.15e13;
+        netIn.dt0 = 1e-12;
+        return netIn;
+    }
+}
+
+class solverTest : public ::testing::Test {};
+
+/**
+ * @brief The IMEX solver reproduces the Rosenbrock solution of the approx8 reaction set.
+ */
+TEST_F(solverTest, imexMatchesDirect) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+
+    solver::DirectNetworkSolver direct(approx8);
+    solver::IMEXNetworkSolver imex(approx8);
+
+    NetOut directOut;
+    NetOut imexOut;
+    ASSERT_NO_THROW(directOut = direct.evaluate(netIn));
+    ASSERT_NO_THROW(imexOut = imex.evaluate(netIn));
+
+    EXPECT_DOUBLE_EQ(imexOut.time, netIn.tMax);
+    EXPECT_TRUE(imexOut.triggeredEvent.empty());
+
+    const double relError = 1e-3;
+    EXPECT_NEAR(imexOut.composition.getMassFraction("H-1") / directOut.composition.getMassFraction("H-1"), 1.0, relError);
+    EXPECT_NEAR(imexOut.composition.getMassFraction("He-4") / directOut.composition.getMassFraction("He-4"), 1.0, relError);
+    EXPECT_NEAR(imexOut.energy / directOut.energy, 1.0, relError);
+}
+
+/**
+ * @brief A warm started IMEX evaluation, which reuses the factorization across steps, agrees with a cold one.
+ */
+TEST_F(solverTest, imexWarmStart) {
+    using namespace gridfire;
+    NetIn netIn = approx8NetIn();
+    netIn.tMax /= 2.0;
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    solver::IMEXNetworkSolver imex(approx8);
+
+    solver::SolverState state;
+    NetOut firstHalf;
+    ASSERT_NO_THROW(firstHalf = imex.evaluate(netIn, state));
+    netIn.composition = firstHalf.composition;
+    NetOut secondHalf;
+    ASSERT_NO_THROW(secondHalf = imex.evaluate(netIn, state));
+
+    NetIn fullIn = approx8NetIn();
+    const NetOut full = imex.evaluate(fullIn);
+
+    const double relError = 1e-3;
+    EXPECT_NEAR(secondHalf.composition.getMassFraction("H-1") / full.composition.getMassFraction("H-1"), 1.0, relError);
+    EXPECT_NEAR(secondHalf.composition.getMassFraction("He-4") / full.composition.getMassFraction("He-4"), 1.0, relError);
+}
+
+/**
+ * @brief A mass fraction threshold on the hydrogen burning trajectory stops the integration where it is crossed.
+ */
+TEST_F(solverTest, massFractionEvent) {
+    using namespace gridfire;
+    NetIn netIn = approx8NetIn();
+    netIn.tMax = 1.0e16;
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    solver::DirectNetworkSolver solver(approx8);
+
+    // --- Reference trajectory: pick a threshold halfway along the hydrogen depletion ---
+    const NetOut reference = solver.evaluate(netIn);
+    const double X0 = netIn.composition.getMassFraction("H-1");
+    const double XEnd = reference.composition.getMassFraction("H-1");
+    ASSERT_LT(XEnd, X0);
+    const double threshold = 0.5 * (X0 + XEnd);
+
+    solver.addEvent(solver::events::massFractionBelow("H-1", threshold));
+    const NetOut stopped = solver.evaluate(netIn);
+
+    EXPECT_EQ(stopped.triggeredEvent, "massFractionBelow(H-1)");
+    EXPECT_GT(stopped.time, 0.0);
+    EXPECT_LT(stopped.time, netIn.tMax);
+    EXPECT_NEAR((stopped.composition.getMassFraction("H-1") - X0) / (threshold - X0), 1.0, 1e-3);
+
+    // --- The reported time is where the event-free trajectory crosses the threshold ---
+    solver.clearEvents();
+    NetIn toEvent = netIn;
+    toEvent.tMax = stopped.time;
+    const NetOut atEvent = solver.evaluate(toEvent);
+    EXPECT_TRUE(atEvent.triggeredEvent.empty());
+    EXPECT_NEAR((atEvent.composition.getMassFraction("H-1") - X0) / (threshold - X0), 1.0, 1e-3);
+}
+
+/**
+ * @brief An event that is never crossed lets the integration run to tMax.
+ */
+TEST_F(solverTest, untriggeredEvent) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    solver::DirectNetworkSolver solver(approx8);
+    solver.addEvent(solver::events::energyGenerationAbove(1.0e30));
+
+    const NetOut netOut = solver.evaluate(netIn);
+    EXPECT_TRUE(netOut.triggeredEvent.empty());
+    EXPECT_DOUBLE_EQ(netOut.time, netIn.tMax);
+}
+
+/**
+ * @brief The subset Jacobian used by the QSE Newton solve matches the full Jacobian on the requested block.
+ */
+TEST_F(solverTest, jacobianSubsetMatchesFull) {
+    using namespace gridfire;
+    const NetIn netIn = approx8NetIn();
+
+    GraphEngine graph(netIn.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+
+    const auto& species = approx8.getNetworkSpecies();
+    std::vector<double> Y(species.size());
+    for (size_t i = 0; i < species.size(); ++i) {
+        const double abundance = netIn.composition.contains(species[i]) ?
+            netIn.composition.getMolarAbundance(std::string(species[i].name())) : 0.0;
+        Y[i] = std::max(abundance, 1.0e-30);
+    }
+    const double T9 = netIn.temperature / 1.0e9;
+
+    std::vector<size_t> subset;
+    for (size_t i = 0; i < species.size(); i += 2) {
+        subset.push_back(i);
+    }
+    const utils::SparsityPattern pattern = utils::restrictSparsityPattern(approx8.getJacobianSparsityPattern(), subset, subset);
+    ASSERT_GT(pattern.nonZeros(), 0u);
+
+    const std::vector<double> values = approx8.calculateJacobianSubset(Y, subset, pattern, T9, netIn.density);
+    ASSERT_EQ(values.size(), pattern.nonZeros());
+
+    approx8.generateJacobianMatrix(Y, T9, netIn.density);
+    for (size_t a = 0; a < subset.size(); ++a) {
+        for (size_t k = pattern.rowOffsets[a]; k < pattern.rowOffsets[a + 1]; ++k) {
+            const size_t b = pattern.columnIndices[k];
+            const double expected = approx8.getJacobianMatrixEntry(static_cast<int>(subset[a]), static_cast<int>(subset[b]));
+            EXPECT_NEAR(values[k], expected, 1e-12 * std::max(1.0, std::abs(expected)));
+        }
+    }
+}
+
+/**
+ * @brief The NSE composition over the GraphEngine species satisfies the Saha balance between nuclei.
+ *
+ * Two body exchanges such as C-12 + C-12 <-> Ne-20 + He-4 conserve the number of nuclei, so their
+ * abundance ratio depends only on the statistical weights and the Q value and not on the normalisation
+ * of the composition.
+ */
+TEST_F(solverTest, nseSahaBalance) {
+    using namespace gridfire;
+    NetIn netIn = approx8NetIn();
+    netIn.temperature = 6.0e9;
+    netIn.density = 1.0e8;
+    netIn.tMax = 1.0;
+
+    GraphEngine graph(netIn.composition);
+    solver::NSENetworkSolver nse(graph);
+
+    NetOut netOut;
+    ASSERT_NO_THROW(netOut = nse.evaluate(netIn));
+
+    const auto& species = graph.getNetworkSpecies();
+    const auto find = [&](const std::string& name) -> const fourdst::atomic::Species& {
+        const auto it = std::ranges::find_if(species, [&](const auto& s) { return s.name() == name; });
+        EXPECT_NE(it, species.end()) << name << " is not in the network";
+        return *it;
+    };
+    const auto lnY = [&](const std::string& name) {
+        return std::log(netOut.composition.getMolarAbundance(name));
+    };
+    const auto bindingEnergyMeV = [&](const std::string& name) {
+        const auto& s = find(name);
+        constexpr double protonAtomicMass = 1.00782503223;
+        constexpr double neutronMass = 1.00866491595;
+        return (s.z() * protonAtomicMass + (s.a() - s.z()) * neutronMass - s.mass()) * 931.49410242;
+    };
+
+    const double kT = 0.0861733326 * netIn.temperature / 1.0e9;
+    const auto checkExchange = [&](const std::string& a, const std::string& b, const std::string& c, const std::string& d) {
+        // Y_c Y_d / (Y_a Y_b) = (A_c A_d / A_a A_b)^{3/2} exp(Q / kT), with unit ground state weights
+        const double Q = bindingEnergyMeV(c) + bindingEnergyMeV(d) - bindingEnergyMeV(a) - bindingEnergyMeV(b);
+        const double lnMassFactor = 1.5 * std::log(
+            static_cast<double>(find(c).a()) * find(d).a() / (static_cast<double>(find(a).a()) * find(b).a())
+        );
+        const double expected = lnMassFactor + Q / kT;
+        const double actual = lnY(c) + lnY(d) - lnY(a) - lnY(b);
+        EXPECT_NEAR(actual, expected, 1e-6) << a << " + " << b << " <-> " << c << " + " << d;
+    };
+    checkExchange("C-12", "C-12", "Ne-20", "He-4");
+    checkExchange("C-12", "O-16", "Mg-24", "He-4");
+    checkExchange("O-16", "O-16", "Mg-24", "He-4");
+
+    // --- The Saha offsets used for the QSE cluster ratios reproduce the same equilibrium ---
+    const auto lnOffset = [&](const std::string& name) {
+        const auto& s = find(name);
+        const double T9 = netIn.temperature / 1.0e9;
+        return solver::NSENetworkSolver::sahaLogOffset(s, T9, netIn.density, solver::NSENetworkSolver::groundStatePartitionFunction(s, T9));
+    };
+    EXPECT_NEAR(lnY("Ne-20") - lnY("C-12") - lnY("He-4"), lnOffset("Ne-20") - lnOffset("C-12") - lnOffset("He-4"), 1e-6);
+    EXPECT_NEAR(lnY("Mg-24") - lnY("O-16") - 2.0 * lnY("He-4"), lnOffset("Mg-24") - lnOffset("O-16") - 2.0 * lnOffset("He-4"), 1e-6);
+
+    double massFractionSum = 0.0;
+    for (const auto& s : species) {
+        massFractionSum += netOut.composition.getMassFraction(std::string(s.name()));
+    }
+    EXPECT_NEAR(massFractionSum, 1.0, 1e-10);
+    EXPECT_GT(netOut.energy, 0.0);
+}
+
+/**
+ * @brief A hot zone with a long timestep is dispatched to NSE; a cool one is left to the fallback solver.
+ */
+TEST_F(solverTest, nseDispatch) {
+    using namespace gridfire;
+    NetIn hot = approx8NetIn();
+    hot.temperature = 6.0e9;
+    hot.density = 1.0e8;
+    hot.tMax = 1.0;
+
+    GraphEngine graph(hot.composition);
+    io::SimpleReactionListFileParser parser{};
+    FileDefinedEngineView approx8(graph, APPROX8_NET, parser);
+    solver::DirectNetworkSolver network(approx8);
+    solver::NSEDispatchNetworkSolver dispatch(graph, network);
+
+    solver::SolverState state;
+    const NetOut hotOut = dispatch.evaluate(hot, state);
+    ASSERT_TRUE(state.inNSE.has_value());
+    EXPECT_TRUE(*state.inNSE);
+
+    solver::NSENetworkSolver nse(graph);
+    const NetOut reference = nse.evaluate(hot);
+    EXPECT_NEAR(hotOut.composition.getMassFraction("He-4") / reference.composition.getMassFraction("He-4"), 1.0, 1e-8);
+
+    const NetIn cool = approx8NetIn();
+    solver::SolverState coolState;
+    dispatch.evaluate(cool, coolState);
+    ASSERT_TRUE(coolState.inNSE.has_value());
+    EXPECT_FALSE(*coolState.inNSE);
+}